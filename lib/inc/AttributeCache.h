@@ -0,0 +1,114 @@
+#pragma once
+
+extern "C" {
+#include "saimetadata.h"
+}
+
+#include "meta/SaiAttrWrapper.h"
+
+#include <map>
+#include <set>
+#include <memory>
+#include <unordered_map>
+
+namespace sairedis
+{
+    /**
+     * @brief Attribute cache.
+     *
+     * Holds values of object attributes that can't change after object is
+     * created, so GET api on them can be answered without asking syncd.
+     *
+     * Attribute is cached when it's CREATE_ONLY, or when it's READ_ONLY and
+     * was added to this container, since most of READ_ONLY attributes are
+     * changing state like oper status or available resources. Only OID
+     * objects are cached.
+     *
+     * Values are removed from cache when object or switch is removed.
+     */
+    class AttributeCache
+    {
+        public:
+
+            AttributeCache();
+
+            virtual ~AttributeCache() = default;
+
+        public:
+
+            /**
+             * @brief Add READ_ONLY attribute which value is static.
+             */
+            bool add(
+                    _In_ sai_object_type_t objectType,
+                    _In_ sai_attr_id_t attrId);
+
+            bool isCacheable(
+                    _In_ sai_object_type_t objectType,
+                    _In_ sai_attr_id_t attrId) const;
+
+            /**
+             * @brief Get attributes from cache.
+             *
+             * @return True if all attributes were found in cache, then status
+             * is SAI_STATUS_SUCCESS or SAI_STATUS_BUFFER_OVERFLOW when list
+             * buffer was too small, in that case only list counts are set.
+             */
+            bool get(
+                    _In_ sai_object_type_t objectType,
+                    _In_ sai_object_id_t objectId,
+                    _In_ uint32_t attrCount,
+                    _Inout_ sai_attribute_t *attrList,
+                    _Out_ sai_status_t& status);
+
+            /**
+             * @brief Put cacheable attributes from successful GET to cache.
+             */
+            void update(
+                    _In_ sai_object_type_t objectType,
+                    _In_ sai_object_id_t objectId,
+                    _In_ sai_object_id_t switchId,
+                    _In_ uint32_t attrCount,
+                    _In_ const sai_attribute_t *attrList);
+
+            void removeObject(
+                    _In_ sai_object_id_t objectId);
+
+            void removeSwitch(
+                    _In_ sai_object_id_t switchId);
+
+            void clear();
+
+            uint64_t getHitCount() const;
+
+            uint64_t getMissCount() const;
+
+        private:
+
+            static bool isValueTypeSupported(
+                    _In_ sai_attr_value_type_t valueType);
+
+            static uint32_t* getListCount(
+                    _In_ sai_attr_value_type_t valueType,
+                    _In_ sai_attribute_value_t& value);
+
+        private:
+
+            typedef std::map<sai_attr_id_t, std::shared_ptr<saimeta::SaiAttrWrapper>> AttrMap;
+
+            struct Entry
+            {
+                sai_object_id_t switchId;
+
+                AttrMap attrs;
+            };
+
+            std::map<sai_object_type_t, std::set<sai_attr_id_t>> m_readOnlyAttrs;
+
+            std::unordered_map<sai_object_id_t, Entry> m_cache;
+
+            uint64_t m_hitCount;
+
+            uint64_t m_missCount;
+    };
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "swss/sal.h"
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace sairedis
+{
+    /**
+     * @brief Encoder of recording lines into compact binary format.
+     *
+     * Binary recording is sequence of segments, each starting with segment
+     * header, followed by records. Every record is one text recording line.
+     *
+     * Record:
+     *
+     *  - timestamp tag (1 byte):
+     *      TIMESTAMP_SAME_PREFIX   varint microseconds
+     *      TIMESTAMP_NEW_PREFIX    "YYYY-MM-DD.HH:MM:SS." varint microseconds
+     *      TIMESTAMP_LITERAL       string
+     *  - varint number of pieces
+     *  - pieces, rest of line is split on '|', '=' and '"' delimiters, and
+     *    each piece is encoded as varint code followed by optional string:
+     *      code & 3    delimiter before piece (0 '|', 1 '=', 2 '"')
+     *      code >> 2   0 - literal string, 1 - literal string added to
+     *                  dictionary, N - dictionary entry N - 2
+     *
+     * String is varint length followed by bytes, varints are LEB128.
+     *
+     * Object types, attribute ids, enum values and OIDs are interned in
+     * segment dictionary, so they are put into file only once per segment.
+     * Each segment is self contained, new segment is started every time file
+     * is opened, so rotated files can be decoded separately.
+     */
+    class BinaryRecordingEncoder
+    {
+        public:
+
+            static constexpr const char* SEGMENT_HEADER = "\0SRECB\1";
+
+            static constexpr size_t SEGMENT_HEADER_SIZE = 7;
+
+            static constexpr uint8_t TIMESTAMP_SAME_PREFIX = 0x01;
+
+            static constexpr uint8_t TIMESTAMP_NEW_PREFIX = 0x02;
+
+            static constexpr uint8_t TIMESTAMP_LITERAL = 0x03;
+
+            static constexpr size_t TIMESTAMP_PREFIX_SIZE = 20;
+
+            static constexpr uint32_t CODE_LITERAL = 0;
+
+            static constexpr uint32_t CODE_INTERN = 1;
+
+            static constexpr uint32_t CODE_REFERENCE = 2;
+
+        public:
+
+            BinaryRecordingEncoder();
+
+            virtual ~BinaryRecordingEncoder() = default;
+
+        public:
+
+            /**
+             * @brief Start new segment, dictionary is cleared.
+             *
+             * Segment header is appended to buffer.
+             */
+            void startSegment(
+                    _Inout_ std::string& buffer);
+
+            /**
+             * @brief Encode single recording line (without new line).
+             *
+             * Encoded record is appended to buffer.
+             */
+            void encode(
+                    _In_ const char* line,
+                    _In_ size_t size,
+                    _Inout_ std::string& buffer);
+
+        public:
+
+            static void putVarint(
+                    _Inout_ std::string& buffer,
+                    _In_ uint64_t value);
+
+            static void putString(
+                    _Inout_ std::string& buffer,
+                    _In_ const char* data,
+                    _In_ size_t size);
+
+            static int getDelimiterIndex(
+                    _In_ char c);
+
+            static char getDelimiter(
+                    _In_ uint32_t index);
+
+        private:
+
+            void encodeTimestamp(
+                    _In_ const char* timestamp,
+                    _In_ size_t size,
+                    _Inout_ std::string& buffer);
+
+            void encodePiece(
+                    _In_ uint32_t delimiter,
+                    _In_ const char* piece,
+                    _In_ size_t size,
+                    _Inout_ std::string& buffer);
+
+            static bool shouldIntern(
+                    _In_ const char* piece,
+                    _In_ size_t size);
+
+        private:
+
+            std::unordered_map<std::string, uint32_t> m_dictionary;
+
+            std::string m_timestampPrefix;
+
+            std::string m_key;
+    };
+}
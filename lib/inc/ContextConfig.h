@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SwitchConfigContainer.h"
+#include "ZeroMQMessageCodec.h"
 
 namespace sairedis
 {
@@ -44,6 +45,34 @@ namespace sairedis
 
             std::string m_zmqNtfEndpoint;
 
+            ZeroMQMessageCodec::Codec m_zmqCodec;
+
+            /**
+             * @brief Use DEALER/ROUTER sockets instead of REQ/REP.
+             *
+             * Allows multiple requests in flight on single zmq connection.
+             */
+            bool m_zmqPipeline;
+
+            bool m_shmEnable;
+
+            /**
+             * @brief Unix socket path used to exchange shared memory
+             * descriptors between syncd and client.
+             */
+            std::string m_shmEndpoint;
+
+            /**
+             * @brief Capacity of each shared memory ring in bytes, 0 for default.
+             */
+            size_t m_shmRingSize;
+
+            /**
+             * @brief Number of VID indexes reserved from VIDCOUNTER at once,
+             * 1 means single INCR per allocated object id.
+             */
+            uint64_t m_vidBlockSize;
+
             std::shared_ptr<SwitchConfigContainer> m_scc;
     };
 }
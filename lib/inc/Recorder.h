@@ -8,9 +8,16 @@ extern "C" {
 
 #include "sairedis.h" // for notify enum
 
+#include "RecorderWriter.h"
+#include "BinaryRecordingEncoder.h"
+
+#include <zlib.h>
+
 #include <string>
 #include <fstream>
 #include <vector>
+#include <memory>
+#include <mutex>
 
 #define SAI_REDIS_RECORDER_DECLARE_RECORD_REMOVE(ot)    \
     void recordRemove(                                  \
@@ -369,8 +376,21 @@ namespace sairedis
             bool setRecordingFilename(
                     _In_ const sai_attribute_t &attr);
 
+            bool setRecordingFormat(
+                    _In_ sai_redis_recording_format_t format);
+
             void requestLogRotate();
 
+            /**
+             * @brief Enable or disable asynchronous recording.
+             *
+             * Records are then written to file by dedicated writer thread.
+             */
+            void enableAsyncRecording(
+                    _In_ bool enabled);
+
+            uint64_t getDroppedRecordCount() const;
+
         public: // static helper functions
 
             static std::string getTimestamp();
@@ -412,6 +432,27 @@ namespace sairedis
             void recordLine(
                     _In_ const std::string& line);
 
+            void pushRecord(
+                    _In_ const std::string& line);
+
+            void writeRecords(
+                    _In_ const std::string& records);
+
+            void writeBinaryBuffer();
+
+            /**
+             * @brief Gets recording file name suffix of current format.
+             *
+             * Reader detects format only from first byte of the file, so
+             * each format must be written to separate file.
+             */
+            std::string getRecordingFileSuffix() const;
+
+            bool openRecordingFile();
+
+            void closeRecordingFile();
+
+            bool isRecordingFileOpen() const;
 
         private:
 
@@ -430,5 +471,22 @@ namespace sairedis
             std::ofstream m_ofstream;
 
             std::mutex m_mutex;
+
+            /**
+             * @brief Guards recording file between API caller and writer thread.
+             */
+            std::mutex m_fileMutex;
+
+            uint64_t m_reportedDropped;
+
+            std::shared_ptr<RecorderWriter> m_writer;
+
+            sai_redis_recording_format_t m_recordingFormat;
+
+            gzFile m_gzFile;
+
+            BinaryRecordingEncoder m_encoder;
+
+            std::string m_binaryBuffer;
     };
 }
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "swss/sal.h"
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+
+namespace sairedis
+{
+    /**
+     * @brief Asynchronous writer for recorder.
+     *
+     * Producer pushes already formatted records into bounded lock free ring,
+     * and writer thread drains ring in batches and passes each batch to sink
+     * with single call, so file is written and flushed once per batch
+     * instead of once per record.
+     *
+     * Ring is single producer single consumer, all producers must be
+     * serialized by caller (recorder mutex).
+     *
+     * When ring is full, record is dropped and counted, so memory used by
+     * recorder is bounded even when disk can't keep up.
+     */
+    class RecorderWriter
+    {
+        public:
+
+            typedef std::function<void(const std::string&)> Sink;
+
+        public:
+
+            RecorderWriter(
+                    _In_ size_t maxRecords,
+                    _In_ Sink sink);
+
+            virtual ~RecorderWriter();
+
+        public:
+
+            /**
+             * @brief Push formatted record.
+             *
+             * @return False if ring was full and record was dropped.
+             */
+            bool push(
+                    _Inout_ std::string&& record);
+
+            /**
+             * @brief Wait until all records pushed so far are passed to sink.
+             */
+            void flush();
+
+            /**
+             * @brief Number of records dropped since writer was created.
+             */
+            uint64_t getDroppedCount() const;
+
+            /**
+             * @brief Number of times ring became full.
+             */
+            uint64_t getOverflowCount() const;
+
+        private:
+
+            void writerThreadFunction();
+
+        private:
+
+            std::vector<std::string> m_slots;
+
+            size_t m_mask;
+
+            Sink m_sink;
+
+            alignas(64) std::atomic<uint64_t> m_head;   // writer position
+
+            alignas(64) std::atomic<uint64_t> m_tail;   // producer position
+
+            std::atomic<uint64_t> m_written;
+
+            std::atomic<uint64_t> m_dropped;
+
+            std::atomic<uint64_t> m_overflows;
+
+            bool m_overflowing;
+
+            std::atomic<bool> m_writerSleeping;
+
+            std::atomic<bool> m_runThread;
+
+            std::mutex m_mutex;
+
+            std::condition_variable m_writerCv;
+
+            std::condition_variable m_flushCv;
+
+            std::shared_ptr<std::thread> m_writerThread;
+    };
+}
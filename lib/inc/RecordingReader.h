@@ -0,0 +1,85 @@
+#pragma once
+
+#include "swss/sal.h"
+
+#include <zlib.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace sairedis
+{
+    /**
+     * @brief Reader of recording files.
+     *
+     * Format is detected from file content, so reader accepts text recording
+     * and binary recording (see BinaryRecordingEncoder), both optionally gzip
+     * compressed, and in all cases returns the same text lines.
+     */
+    class RecordingReader
+    {
+        public:
+
+            RecordingReader(
+                    _In_ const std::string& filename);
+
+            virtual ~RecordingReader();
+
+        public:
+
+            bool is_open() const;
+
+            bool isBinary() const;
+
+            void close();
+
+            /**
+             * @brief Read next recording line (without new line).
+             *
+             * @return False on end of file.
+             */
+            bool getline(
+                    _Out_ std::string& line);
+
+        private:
+
+            bool readTextLine(
+                    _Out_ std::string& line);
+
+            bool readBinaryLine(
+                    _Out_ std::string& line);
+
+            void readSegmentHeader();
+
+            int readByte();
+
+            uint8_t readRequiredByte();
+
+            uint64_t readVarint();
+
+            void readBytes(
+                    _In_ size_t size,
+                    _Out_ std::string& data);
+
+        private:
+
+            std::string m_filename;
+
+            gzFile m_file;
+
+            bool m_binary;
+
+            std::vector<std::string> m_dictionary;
+
+            std::string m_timestampPrefix;
+
+            std::string m_piece;
+
+            std::vector<char> m_buffer;
+
+            size_t m_bufferPos;
+
+            size_t m_bufferSize;
+    };
+}
@@ -7,6 +7,7 @@
 #include "Recorder.h"
 #include "RedisVidIndexGenerator.h"
 #include "SkipRecordAttrContainer.h"
+#include "AttributeCache.h"
 #include "RedisChannel.h"
 #include "SwitchConfigContainer.h"
 #include "ContextConfig.h"
@@ -19,6 +20,8 @@
 #include <memory>
 #include <functional>
 #include <map>
+#include <deque>
+#include <chrono>
 
 #define SAIREDIS_REDISREMOTESAIINTERFACE_DECLARE_REMOVE_ENTRY(ot)   \
     virtual sai_status_t remove(                                    \
@@ -226,6 +229,17 @@ namespace sairedis
                     _In_ uint32_t number_of_counters,
                     _In_ const sai_stat_id_t *counter_ids) override;
 
+            virtual sai_status_t bulkGetStats(
+                    _In_ sai_object_id_t switchId,
+                    _In_ sai_object_type_t object_type,
+                    _In_ uint32_t object_count,
+                    _In_ const sai_object_key_t *object_key,
+                    _In_ uint32_t number_of_counters,
+                    _In_ const sai_stat_id_t *counter_ids,
+                    _In_ sai_stats_mode_t mode,
+                    _Inout_ sai_status_t *object_statuses,
+                    _Out_ uint64_t *counters) override;
+
         public: // non QUAD API
 
             virtual sai_status_t flushFdbEntries(
@@ -293,6 +307,31 @@ namespace sairedis
 
             const std::map<sai_object_id_t, swss::TableDump>& getTableDump() const;
 
+        public: // asynchronous pipeline
+
+            struct AsyncFailure
+            {
+                uint64_t m_sequence;
+
+                sai_common_api_t m_api;
+
+                std::string m_key;
+
+                sai_status_t m_status;
+            };
+
+            /**
+             * @brief Drain asynchronous pipeline.
+             *
+             * Waits for all pending pipelined responses and moves all failures
+             * collected since previous drain to output vector.
+             *
+             * @return SAI_STATUS_SUCCESS if there were no failures, otherwise
+             * status of first failed request.
+             */
+            sai_status_t drainAsyncResponses(
+                    _Out_ std::vector<AsyncFailure>& failures);
+
         private: // QUAD API helpers
 
             sai_status_t create(
@@ -380,6 +419,101 @@ namespace sairedis
                     _In_ uint32_t object_count,
                     _Out_ sai_status_t *object_statuses);
 
+        private: // asynchronous pipeline
+
+            /**
+             * @brief Checks whether create/remove/set on given object type
+             * should be pipelined.
+             */
+            bool isAsyncPipelineEnabled(
+                    _In_ sai_object_type_t objectType) const;
+
+            /**
+             * @brief Register already sent request as pending.
+             *
+             * If pipeline is full, oldest response is collected first. Always
+             * returns SAI_STATUS_SUCCESS, actual status is recorded, applied
+             * to meta database and reported when response is collected.
+             */
+            sai_status_t enqueueAsyncRequest(
+                    _In_ sai_common_api_t api,
+                    _In_ const std::string& key);
+
+            /**
+             * @brief Collect single oldest pending pipelined response.
+             */
+            void waitForAsyncResponse();
+
+            /**
+             * @brief Collect all pending pipelined responses.
+             *
+             * Must be called before any non pipelined API is sent, since
+             * responses share the same channel. Auto bulk buffer is sent
+             * first, so order of operations is preserved.
+             */
+            void waitForAllAsyncResponses();
+
+            sai_status_t setAsyncPipelineDepth(
+                    _In_ uint32_t depth);
+
+            /**
+             * @brief Apply or drop meta commit deferred for pipelined request.
+             */
+            void completeMetaCommit(
+                    _In_ bool deferredCommit,
+                    _In_ sai_status_t status);
+
+            void reportAsyncFailure(
+                    _In_ uint64_t sequence,
+                    _In_ sai_common_api_t api,
+                    _In_ const std::string& key,
+                    _In_ sai_status_t status);
+
+        private: // auto bulk
+
+            /**
+             * @brief Checks whether single create/remove on given object type
+             * should be buffered and sent as bulk.
+             */
+            bool isAutoBulkEnabled(
+                    _In_ sai_object_type_t objectType) const;
+
+            /**
+             * @brief Buffer single create or remove entry.
+             *
+             * Buffer is sent before new entry is added when it's full, or
+             * when object type or operation is different than already
+             * buffered ones. Entry is never sent within the call which
+             * buffered it, since meta defers its commit only after this
+             * returns. Always returns SAI_STATUS_SUCCESS, actual status is
+             * applied to meta database and reported when bulk is sent.
+             */
+            sai_status_t enqueueAutoBulkRequest(
+                    _In_ sai_common_api_t api,
+                    _In_ sai_object_type_t objectType,
+                    _In_ const std::string& serializedObjectId,
+                    _In_ const std::string& serializedAttributes);
+
+            /**
+             * @brief Send all buffered entries as single bulk request.
+             */
+            void flushAutoBulk();
+
+            sai_status_t setAutoBulkMaxSize(
+                    _In_ uint32_t maxSize);
+
+            /**
+             * @brief Send bulk request and wait for response.
+             *
+             * Common part of bulk create/remove/set, entries are already
+             * serialized with object id as field and attributes as value.
+             */
+            sai_status_t sendBulkRequest(
+                    _In_ sai_common_api_t api,
+                    _In_ const std::string& serializedObjectType,
+                    _In_ const std::vector<swss::FieldValueTuple>& entries,
+                    _Out_ sai_status_t *object_statuses);
+
         private: // stats API response
 
             sai_status_t waitForGetStatsResponse(
@@ -388,6 +522,12 @@ namespace sairedis
 
             sai_status_t waitForClearStatsResponse();
 
+            sai_status_t waitForBulkGetStatsResponse(
+                    _In_ uint32_t object_count,
+                    _In_ uint32_t number_of_counters,
+                    _Out_ sai_status_t *object_statuses,
+                    _Out_ uint64_t *counters);
+
         private: // non QUAD API response
 
             sai_status_t waitForFlushFdbEntriesResponse();
@@ -421,6 +561,11 @@ namespace sairedis
                     _In_ sai_object_id_t objectId,
                     _In_ const sai_attribute_t *attr);
 
+            sai_status_t getRedisExtensionAttribute(
+                    _In_ sai_object_type_t objectType,
+                    _In_ sai_object_id_t objectId,
+                    _Inout_ sai_attribute_t *attr);
+
         private:
 
             sai_status_t sai_redis_notify_syncd(
@@ -466,6 +611,10 @@ namespace sairedis
 
             std::shared_ptr<SkipRecordAttrContainer> m_skipRecordAttrContainer;
 
+            std::shared_ptr<AttributeCache> m_attributeCache;
+
+            bool m_attributeCacheEnabled;
+
             std::shared_ptr<Channel> m_communicationChannel;
 
             uint64_t m_responseTimeoutMs;
@@ -473,5 +622,44 @@ namespace sairedis
             std::function<sai_switch_notifications_t(std::shared_ptr<Notification>)> m_notificationCallback;
 
             std::map<sai_object_id_t, swss::TableDump> m_tableDump;
+
+        private: // asynchronous pipeline
+
+            struct AsyncRequest
+            {
+                uint64_t m_sequence;
+
+                sai_common_api_t m_api;
+
+                std::string m_key;
+
+                bool m_deferredCommit;
+            };
+
+            uint32_t m_asyncPipelineDepth;
+
+            uint64_t m_asyncSequence;
+
+            std::deque<AsyncRequest> m_asyncPending;
+
+            std::vector<AsyncFailure> m_asyncFailures;
+
+            sai_redis_async_failure_notification_fn m_asyncFailureNotify;
+
+        private: // auto bulk
+
+            uint32_t m_autoBulkMaxSize;
+
+            uint32_t m_autoBulkMaxDelayUs;
+
+            sai_common_api_t m_autoBulkApi;
+
+            sai_object_type_t m_autoBulkObjectType;
+
+            std::chrono::steady_clock::time_point m_autoBulkStart;
+
+            std::vector<swss::FieldValueTuple> m_autoBulkEntries;
+
+            std::vector<AsyncRequest> m_autoBulkRequests;
     };
 }
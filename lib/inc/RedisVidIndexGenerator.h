@@ -6,9 +6,20 @@
 #include "swss/sal.h"
 
 #include <memory>
+#include <mutex>
 
 namespace sairedis
 {
+    /**
+     * @brief VID index generator based on redis counter.
+     *
+     * Counter is shared between sairedis and syncd. When block size is
+     * greater than 1, range of indexes is reserved with single INCRBY and
+     * handed out locally until it runs out. Counter in redis is always
+     * advanced before any index from range is used, so it acts as persisted
+     * high-water mark, and after warm restart new indexes will never collide
+     * with already existing ones. Unused indexes from range are just skipped.
+     */
     class RedisVidIndexGenerator:
         public OidIndexGenerator
     {
@@ -16,7 +27,8 @@ namespace sairedis
 
             RedisVidIndexGenerator(
                     _In_ std::shared_ptr<swss::DBConnector> dbConnector,
-                    _In_ const std::string& vidCounterName);
+                    _In_ const std::string& vidCounterName,
+                    _In_ uint64_t blockSize = 1);
 
             virtual ~RedisVidIndexGenerator() = default;
 
@@ -24,12 +36,29 @@ namespace sairedis
 
             virtual uint64_t increment() override;
 
+            /**
+             * @brief Drop locally reserved range.
+             *
+             * Next increment will reserve new range from redis counter.
+             */
             virtual void reset() override;
 
+        private:
+
+            void reserveBlock();
+
         private:
 
             std::shared_ptr<swss::DBConnector> m_dbConnector;
 
             std::string m_vidCounterName;
+
+            uint64_t m_blockSize;
+
+            uint64_t m_next;
+
+            uint64_t m_last;
+
+            std::mutex m_mutex;
     };
 }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Channel.h"
+#include "ShmTransport.h"
+
+#include <memory>
+#include <functional>
+
+namespace sairedis
+{
+    /**
+     * @brief Channel using shared memory rings.
+     *
+     * Requests, responses and notifications are encoded using binary zmq
+     * message codec, and transferred through shared memory rings created by
+     * syncd. Only synchronous mode is supported.
+     */
+    class ShmChannel:
+        public Channel
+    {
+        public:
+
+            ShmChannel(
+                    _In_ const std::string& endpoint,
+                    _In_ Channel::Callback callback);
+
+            virtual ~ShmChannel();
+
+        public:
+
+            virtual void setBuffered(
+                    _In_ bool buffered) override;
+
+            virtual void flush() override;
+
+            virtual void set(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& values,
+                    _In_ const std::string& command) override;
+
+            virtual void del(
+                    _In_ const std::string& key,
+                    _In_ const std::string& command) override;
+
+            virtual sai_status_t wait(
+                    _In_ const std::string& command,
+                    _Out_ swss::KeyOpFieldsValuesTuple& kco) override;
+
+        protected:
+
+            virtual void notificationThreadFunction() override;
+
+        private:
+
+            std::string m_endpoint;
+
+            std::shared_ptr<ShmTransport> m_transport;
+
+            /**
+             * @brief Send buffer reused between messages.
+             */
+            std::string m_sendBuffer;
+    };
+}
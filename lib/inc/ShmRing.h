@@ -0,0 +1,139 @@
+#pragma once
+
+#include "swss/sal.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace sairedis
+{
+    /**
+     * @brief Single producer single consumer ring buffer in shared memory.
+     *
+     * Ring holds variable length records, each prefixed with 32 bit length
+     * and aligned to 8 bytes. Record never wraps, if it does not fit at the
+     * end of ring, producer puts wrap marker and record starts at offset 0.
+     *
+     * Consumer sleeps on eventfd doorbell only after announcing it in shared
+     * header, so producer does a syscall only when consumer is actually
+     * waiting, otherwise transfer is just a few cache lines.
+     */
+    class ShmRing
+    {
+        public:
+
+            typedef struct _Header
+            {
+                alignas(64) std::atomic<uint64_t> m_head;     // consumer position
+
+                alignas(64) std::atomic<uint64_t> m_tail;     // producer position
+
+                alignas(64) std::atomic<uint32_t> m_waiting;  // consumer sleeps on doorbell
+
+            } Header;
+
+        public:
+
+            /**
+             * @brief Create ring on already mapped memory.
+             *
+             * Memory must be at least getRequiredSize(capacity) bytes, and
+             * capacity must be power of 2.
+             */
+            ShmRing(
+                    _In_ void* memory,
+                    _In_ size_t capacity,
+                    _In_ int eventFd);
+
+            virtual ~ShmRing() = default;
+
+        public:
+
+            static size_t getRequiredSize(
+                    _In_ size_t capacity);
+
+            /**
+             * @brief Max record size that can be pushed to ring.
+             */
+            size_t getMaxRecordSize() const;
+
+            int getEventFd() const;
+
+            /**
+             * @brief Reset ring positions, only safe when ring is not used.
+             */
+            void reset();
+
+            bool empty() const;
+
+        public: // producer
+
+            /**
+             * @brief Push record to ring.
+             *
+             * Will wait for space up to timeout if ring is full.
+             *
+             * @return True on success, false on timeout.
+             */
+            bool push(
+                    _In_ const void* data,
+                    _In_ size_t size,
+                    _In_ uint64_t timeoutMs);
+
+        public: // consumer
+
+            /**
+             * @brief Get oldest record without copying it out of ring.
+             *
+             * Record stays valid until pop() is called.
+             *
+             * @return Pointer to record data or nullptr if ring is empty.
+             */
+            const uint8_t* front(
+                    _Out_ size_t& size);
+
+            void pop();
+
+            /**
+             * @brief Announce that consumer is going to sleep on doorbell.
+             *
+             * @return True if ring is still empty and consumer can sleep,
+             * false if data arrived in meantime (consumer is not armed then).
+             */
+            bool arm();
+
+            void disarm();
+
+            void clearDoorbell();
+
+            /**
+             * @brief Wait until ring is not empty.
+             *
+             * @return True if data is available, false on timeout.
+             */
+            bool wait(
+                    _In_ uint64_t timeoutMs);
+
+        private:
+
+            bool tryPush(
+                    _In_ const void* data,
+                    _In_ size_t size);
+
+        private:
+
+            Header* m_header;
+
+            uint8_t* m_data;
+
+            size_t m_capacity;
+
+            int m_eventFd;
+
+            /**
+             * @brief Size of record returned by front(), consumer side only.
+             */
+            size_t m_frontSize;
+    };
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ShmRing.h"
+
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+namespace sairedis
+{
+    /**
+     * @brief Shared memory transport between sairedis client and syncd.
+     *
+     * Server (syncd) creates memfd with request, response and notification
+     * rings, and eventfd doorbell for each ring. Then it listens on unix
+     * socket endpoint, and passes all those file descriptors to connecting
+     * client, so both processes map the same memory.
+     *
+     * Only single client is supported at a time, since rings are single
+     * producer single consumer. Client keeps its socket connected for its
+     * lifetime, and server rejects other clients until it disconnects.
+     * Socket is accessible only by owner, since connected client gets full
+     * access to shared memory.
+     */
+    class ShmTransport
+    {
+        public:
+
+            typedef enum _Role
+            {
+                ROLE_SERVER,
+
+                ROLE_CLIENT,
+
+            } Role;
+
+            typedef enum _RingType
+            {
+                RING_REQUEST,       // client -> syncd
+
+                RING_RESPONSE,      // syncd -> client
+
+                RING_NOTIFICATION,  // syncd -> client
+
+                RING_MAX,
+
+            } RingType;
+
+        public:
+
+            /**
+             * @brief Create transport.
+             *
+             * Server creates shared memory with rings of given capacity
+             * (rounded up to power of 2), client connects to server on
+             * endpoint and ring capacity is taken from shared memory.
+             */
+            ShmTransport(
+                    _In_ const std::string& endpoint,
+                    _In_ Role role,
+                    _In_ size_t ringCapacity = 0);
+
+            virtual ~ShmTransport();
+
+        public:
+
+            ShmRing& getRing(
+                    _In_ RingType type);
+
+            /**
+             * @brief Checks whether client is connected, server side only.
+             */
+            bool isClientConnected() const;
+
+        private:
+
+            void createServer(
+                    _In_ size_t ringCapacity);
+
+            void connectClient();
+
+            void mapMemory(
+                    _In_ size_t size);
+
+            void acceptThread();
+
+            bool sendDescriptors(
+                    _In_ int socket);
+
+        private:
+
+            std::string m_endpoint;
+
+            Role m_role;
+
+            int m_memFd;
+
+            int m_eventFds[RING_MAX];
+
+            void* m_memory;
+
+            size_t m_size;
+
+            std::shared_ptr<ShmRing> m_rings[RING_MAX];
+
+            int m_listenFd;
+
+            int m_stopFd;
+
+            /**
+             * @brief Connection of single client, on server accessed only by
+             * accept thread.
+             */
+            int m_clientFd;
+
+            std::atomic<bool> m_clientConnected;
+
+            std::shared_ptr<std::thread> m_acceptThread;
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Channel.h"
+#include "ZeroMQMessageCodec.h"
 
 #include "swss/producertable.h"
 #include "swss/consumertable.h"
@@ -9,6 +10,7 @@
 
 #include <memory>
 #include <functional>
+#include <deque>
 
 namespace sairedis
 {
@@ -20,7 +22,9 @@ namespace sairedis
             ZeroMQChannel(
                     _In_ const std::string& endpoint,
                     _In_ const std::string& ntfEndpoint,
-                    _In_ Channel::Callback callback);
+                    _In_ Channel::Callback callback,
+                    _In_ ZeroMQMessageCodec::Codec codec = ZeroMQMessageCodec::CODEC_JSON,
+                    _In_ bool pipeline = false);
 
             virtual ~ZeroMQChannel();
 
@@ -48,6 +52,33 @@ namespace sairedis
 
             virtual void notificationThreadFunction() override;
 
+        public:
+
+            /**
+             * @brief Whether multiple requests can be in flight.
+             *
+             * True when channel is using DEALER socket, in that case each
+             * request is prefixed with request id, and responses are
+             * expected to arrive in the same order as requests were sent.
+             */
+            bool isPipelined() const;
+
+        private:
+
+            void send(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& values,
+                    _In_ const std::string& command);
+
+            /**
+             * @brief Receive response for oldest pending request.
+             *
+             * Responses for requests which already timed out are discarded.
+             *
+             * @return Size of received payload or -1 on timeout.
+             */
+            int receivePipelinedResponse();
+
         private:
 
             std::string m_endpoint;
@@ -56,6 +87,22 @@ namespace sairedis
 
             std::vector<uint8_t> m_buffer;
 
+            ZeroMQMessageCodec::Codec m_codec;
+
+            /**
+             * @brief Send buffer reused between messages.
+             */
+            std::string m_sendBuffer;
+
+            bool m_pipeline;
+
+            uint64_t m_requestId;
+
+            /**
+             * @brief Request ids for which response was not yet received.
+             */
+            std::deque<uint64_t> m_pendingRequests;
+
             void* m_context;
 
             void* m_socket;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "swss/table.h"
+#include "swss/sal.h"
+
+#include <string>
+#include <vector>
+
+namespace sairedis
+{
+    /**
+     * @brief ZMQ message codec.
+     *
+     * Message is always a list of field value tuples, where first tuple is
+     * (key, op) and the rest are attributes. This class can encode such list
+     * as JSON text (legacy format) or as compact length prefixed binary frame:
+     *
+     *   | magic (1) | version (1) | count (4) | { len (4) | data | len (4) | data } * count |
+     *
+     * All integers are little endian. Binary frame starts with magic byte
+     * which is not valid JSON start, so decoder can always detect format of
+     * received message, and receiver can respond with the same codec.
+     */
+    class ZeroMQMessageCodec
+    {
+        private:
+
+            ZeroMQMessageCodec() = delete;
+            ~ZeroMQMessageCodec() = delete;
+
+        public:
+
+            typedef enum _Codec
+            {
+                CODEC_JSON,
+
+                CODEC_BINARY,
+
+            } Codec;
+
+        public:
+
+            /**
+             * @brief Get codec from name used in context config.
+             *
+             * Throws if codec name is unknown.
+             */
+            static Codec parseCodec(
+                    _In_ const std::string& name);
+
+            static std::string codecName(
+                    _In_ Codec codec);
+
+            /**
+             * @brief Encode message into provided buffer.
+             *
+             * Buffer is resized to encoded message length, so caller can
+             * reuse the same buffer to avoid allocations on each message.
+             */
+            static void encode(
+                    _In_ Codec codec,
+                    _In_ const std::string& key,
+                    _In_ const std::string& op,
+                    _In_ const std::vector<swss::FieldValueTuple>& values,
+                    _Out_ std::string& buffer);
+
+            /**
+             * @brief Decode message from raw receive buffer.
+             *
+             * Binary messages are decoded directly from buffer without
+             * intermediate copies. Throws on malformed message.
+             *
+             * @return Codec which was used to encode message.
+             */
+            static Codec decode(
+                    _In_ const uint8_t* buffer,
+                    _In_ size_t size,
+                    _Out_ swss::KeyOpFieldsValuesTuple& kco);
+    };
+}
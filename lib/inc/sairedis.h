@@ -56,8 +56,65 @@ typedef enum _sai_redis_communication_mode_t
      */
     SAI_REDIS_COMMUNICATION_MODE_ZMQ_SYNC,
 
+    /**
+     * @brief Synchronous mode using shared memory rings.
+     *
+     * When enabled syncd also needs to be running in shm synchronous mode,
+     * and both processes must run on the same host. Syncd creates shared
+     * memory and listens on unix socket endpoint, by default
+     * "/tmp/sairedis_shm_ep", which can be changed by "shm_endpoint" in
+     * context config json file.
+     */
+    SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC,
+
 } sai_redis_communication_mode_t;
 
+typedef enum _sai_redis_recording_format_t
+{
+    /**
+     * @brief Text recording, default format.
+     */
+    SAI_REDIS_RECORDING_FORMAT_TEXT,
+
+    /**
+     * @brief Binary recording.
+     *
+     * Object types, attribute ids and OIDs are interned, so file is much
+     * smaller than text recording. It can be converted to text format by
+     * sairecconv tool, and saiplayer can read it directly. Recording file
+     * name gets ".bin" suffix.
+     */
+    SAI_REDIS_RECORDING_FORMAT_BINARY,
+
+    /**
+     * @brief Binary recording compressed with gzip.
+     *
+     * Recording file name gets ".bin.gz" suffix.
+     */
+    SAI_REDIS_RECORDING_FORMAT_BINARY_COMPRESSED,
+
+} sai_redis_recording_format_t;
+
+/**
+ * @brief Asynchronous pipeline failure notification.
+ *
+ * Called for every pipelined create/remove/set request which syncd reported
+ * as failed. Sequence is local counter assigned to the request when it was
+ * sent, it's not sent to syncd and only identifies request in this report.
+ * Notification is executed on the thread which is collecting responses, under
+ * sairedis API mutex, so it must not call back into sairedis API.
+ *
+ * @param[in] sequence Request sequence number
+ * @param[in] api Common API of failed request
+ * @param[in] serialized_key Serialized object key (object_type:object_id)
+ * @param[in] status Status returned by syncd
+ */
+typedef void (*sai_redis_async_failure_notification_fn)(
+        _In_ uint64_t sequence,
+        _In_ sai_common_api_t api,
+        _In_ const char *serialized_key,
+        _In_ sai_status_t status);
+
 typedef enum _sai_redis_switch_attr_t
 {
     /**
@@ -222,4 +279,192 @@ typedef enum _sai_redis_switch_attr_t
      */
     SAI_REDIS_SWITCH_ATTR_SYNC_OPERATION_RESPONSE_TIMEOUT,
 
+    /**
+     * @brief Asynchronous pipeline depth.
+     *
+     * Maximum number of create/remove/set requests which can be in flight
+     * when synchronous mode is enabled. When set to non zero value, those
+     * APIs will return SAI_STATUS_SUCCESS right after the request is sent,
+     * and response will be collected later. Syncd responds in the order in
+     * which requests were sent, so response is matched with the oldest pending
+     * request. Metadata database is updated only after successful response,
+     * and any request depending on pending one waits for pending responses
+     * first. Failures are reported via
+     * SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY and by
+     * SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN.
+     *
+     * Any other API (like GET, bulk or stats) will first collect all pending
+     * responses, so order of operations is preserved. Switch create and
+     * remove are never pipelined.
+     *
+     * Value 0 disables pipeline. Supported with redis sync communication
+     * mode, and with zmq sync mode when "zmq_pipeline" is enabled in context
+     * config.
+     *
+     * @type sai_uint32_t
+     * @flags CREATE_AND_SET
+     * @default 0
+     */
+    SAI_REDIS_SWITCH_ATTR_ASYNC_PIPELINE_DEPTH,
+
+    /**
+     * @brief Asynchronous pipeline failure notification.
+     *
+     * @type sai_pointer_t sai_redis_async_failure_notification_fn
+     * @flags CREATE_AND_SET
+     * @default NULL
+     */
+    SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY,
+
+    /**
+     * @brief Drain asynchronous pipeline.
+     *
+     * This is action attribute. When set to true, it will wait for all
+     * pending pipelined responses. Returned status is SAI_STATUS_SUCCESS when
+     * all requests since previous drain succeeded, otherwise it's status of
+     * first failed request.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN,
+
+    /**
+     * @brief Auto bulk max size.
+     *
+     * When enabled, consecutive single create or remove calls on route,
+     * neighbor and FDB entries with the same object type and operation are
+     * buffered and sent to syncd as single bulk request. APIs return
+     * SAI_STATUS_SUCCESS right after entry is buffered, and per entry
+     * failures are reported the same way as for asynchronous pipeline, via
+     * SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY and
+     * SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN. Metadata database is updated with
+     * per entry statuses when bulk response arrives.
+     *
+     * Buffer is sent on next create or remove call when it reaches max size,
+     * when different object type or operation is requested, when any other
+     * API is called, and on SAI_REDIS_SWITCH_ATTR_FLUSH or
+     * SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN.
+     *
+     * Value 0 or 1 disables auto bulk.
+     *
+     * @type sai_uint32_t
+     * @flags CREATE_AND_SET
+     * @default 0
+     */
+    SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_SIZE,
+
+    /**
+     * @brief Auto bulk max delay in microseconds.
+     *
+     * Buffer is sent on next create or remove call when its oldest entry is
+     * buffered longer than this delay. There is no timer, so buffer is not
+     * sent when there are no more calls, user should use
+     * SAI_REDIS_SWITCH_ATTR_FLUSH at the end of batch.
+     *
+     * Value 0 disables delay check.
+     *
+     * @type sai_uint32_t
+     * @flags CREATE_AND_SET
+     * @default 1000
+     */
+    SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_DELAY,
+
+    /**
+     * @brief Asynchronous recording.
+     *
+     * When enabled, recorded lines are formatted on API caller thread and
+     * written to recording file in batches by dedicated writer thread.
+     * Queue between them is bounded, when it's full records are dropped and
+     * number of dropped records is put into recording file.
+     *
+     * Pending records are flushed to file before log rotate, when recording
+     * is stopped and when asynchronous recording is disabled.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_RECORDING_ASYNC,
+
+    /**
+     * @brief Recording format.
+     *
+     * Current recording file is closed and file for new format is opened.
+     * Each format has its own file name suffix, so records in different
+     * formats are never mixed in single file.
+     * Binary formats are best combined with asynchronous recording, since
+     * then records are encoded and compressed in batches on writer thread.
+     *
+     * @type sai_redis_recording_format_t
+     * @flags CREATE_AND_SET
+     * @default SAI_REDIS_RECORDING_FORMAT_TEXT
+     */
+    SAI_REDIS_SWITCH_ATTR_RECORDING_FORMAT,
+
+    /**
+     * @brief Attribute cache.
+     *
+     * When enabled, values of CREATE_ONLY attributes and static READ_ONLY
+     * attributes (like switch CPU port or port supported speeds) returned
+     * from syncd are cached, and next GET api on them is answered locally
+     * without round trip to syncd. Cached values are invalidated when object
+     * or switch is removed, and when INIT view is requested.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE,
+
+    /**
+     * @brief Number of GET api calls answered from attribute cache.
+     *
+     * @type sai_uint64_t
+     * @flags READ_ONLY
+     */
+    SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE_HIT_COUNT,
+
+    /**
+     * @brief Number of GET api calls on cacheable attributes which were not
+     * present in attribute cache.
+     *
+     * @type sai_uint64_t
+     * @flags READ_ONLY
+     */
+    SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE_MISS_COUNT,
+
 } sai_redis_switch_attr_t;
+
+/**
+ * @brief Bulk objects get statistics.
+ *
+ * Gets the same counters from multiple objects of the same type on single
+ * switch in one request to syncd. Counters of object at index i start at
+ * counters[i * number_of_counters].
+ *
+ * @param[in] switch_id SAI Switch object id
+ * @param[in] object_type Object type
+ * @param[in] object_count Number of objects to get the stats
+ * @param[in] object_key List of object keys
+ * @param[in] number_of_counters Number of counters in the array
+ * @param[in] counter_ids Specifies the array of counter ids
+ * @param[in] mode Statistics mode
+ * @param[inout] object_statuses Array of status for each object
+ * @param[out] counters Array of resulting counter values
+ *
+ * @return #SAI_STATUS_SUCCESS on success when all objects succeeded,
+ * #SAI_STATUS_FAILURE when any of the objects fails, or failure status code
+ * when request could not be executed.
+ */
+extern "C" sai_status_t sai_redis_bulk_object_get_stats(
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters);
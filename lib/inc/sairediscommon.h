@@ -31,6 +31,7 @@
 
 #define REDIS_ASIC_STATE_COMMAND_GET_STATS          "get_stats"
 #define REDIS_ASIC_STATE_COMMAND_CLEAR_STATS        "clear_stats"
+#define REDIS_ASIC_STATE_COMMAND_BULK_GET_STATS     "bulk_get_stats"
 
 #define REDIS_ASIC_STATE_COMMAND_GETRESPONSE        "getresponse"
 
@@ -0,0 +1,351 @@
+#include "AttributeCache.h"
+
+#include "swss/logger.h"
+
+#include "meta/sai_serialize.h"
+
+#include <vector>
+
+using namespace sairedis;
+
+AttributeCache::AttributeCache():
+    m_hitCount(0),
+    m_missCount(0)
+{
+    SWSS_LOG_ENTER();
+
+    // default set of READ_ONLY attributes which don't change after switch
+    // is created, CREATE_ONLY attributes don't need to be added
+
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_MAX_NUMBER_OF_SUPPORTED_PORTS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_CPU_PORT);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_MAX_VIRTUAL_ROUTERS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_FDB_TABLE_SIZE);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_L3_NEIGHBOR_TABLE_SIZE);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_L3_ROUTE_TABLE_SIZE);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_LAG_MEMBERS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_LAGS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_ECMP_MEMBERS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_UNICAST_QUEUES);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_MULTICAST_QUEUES);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_QUEUES);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_NUMBER_OF_CPU_QUEUES);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_ON_LINK_ROUTE_SUPPORTED);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_DEFAULT_VLAN_ID);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_DEFAULT_STP_INST_ID);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_MAX_STP_INSTANCE);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_DEFAULT_1Q_BRIDGE_ID);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_DEFAULT_TRAP_GROUP);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_ECMP_HASH);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_LAG_HASH);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_QOS_MAX_NUMBER_OF_TRAFFIC_CLASSES);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_QOS_MAX_NUMBER_OF_SCHEDULER_GROUP_HIERARCHY_LEVELS);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_TOTAL_BUFFER_SIZE);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_INGRESS_BUFFER_POOL_NUM);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_EGRESS_BUFFER_POOL_NUM);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_MAX_ACL_ACTION_COUNT);
+    add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_MAX_ACL_RANGE_COUNT);
+
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_TYPE);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SUPPORTED_SPEED);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SUPPORTED_FEC_MODE);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SUPPORTED_HALF_DUPLEX_SPEED);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SUPPORTED_AUTO_NEG_MODE);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_SUPPORTED_MEDIA_TYPE);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_QOS_QUEUE_LIST);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_QOS_NUMBER_OF_SCHEDULER_GROUPS);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_QOS_SCHEDULER_GROUP_LIST);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS);
+    add(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST);
+}
+
+bool AttributeCache::isValueTypeSupported(
+        _In_ sai_attr_value_type_t valueType)
+{
+    SWSS_LOG_ENTER();
+
+    switch (valueType)
+    {
+        case SAI_ATTR_VALUE_TYPE_BOOL:
+        case SAI_ATTR_VALUE_TYPE_CHARDATA:
+        case SAI_ATTR_VALUE_TYPE_UINT8:
+        case SAI_ATTR_VALUE_TYPE_INT8:
+        case SAI_ATTR_VALUE_TYPE_UINT16:
+        case SAI_ATTR_VALUE_TYPE_INT16:
+        case SAI_ATTR_VALUE_TYPE_UINT32:
+        case SAI_ATTR_VALUE_TYPE_INT32:
+        case SAI_ATTR_VALUE_TYPE_UINT64:
+        case SAI_ATTR_VALUE_TYPE_INT64:
+        case SAI_ATTR_VALUE_TYPE_MAC:
+        case SAI_ATTR_VALUE_TYPE_IPV4:
+        case SAI_ATTR_VALUE_TYPE_IPV6:
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+        case SAI_ATTR_VALUE_TYPE_IP_PREFIX:
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
+        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
+            return true;
+
+        default:
+            break;
+    }
+
+    sai_attribute_value_t value;
+
+    return getListCount(valueType, value) != nullptr;
+}
+
+uint32_t* AttributeCache::getListCount(
+        _In_ sai_attr_value_type_t valueType,
+        _In_ sai_attribute_value_t& value)
+{
+    SWSS_LOG_ENTER();
+
+    switch (valueType)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            return &value.objlist.count;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+            return &value.u8list.count;
+
+        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+            return &value.s8list.count;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+            return &value.u16list.count;
+
+        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+            return &value.s16list.count;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+            return &value.u32list.count;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+            return &value.s32list.count;
+
+        case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+            return &value.vlanlist.count;
+
+        default:
+            return nullptr;
+    }
+}
+
+bool AttributeCache::add(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_attr_id_t attrId)
+{
+    SWSS_LOG_ENTER();
+
+    auto md = sai_metadata_get_attr_metadata(objectType, attrId);
+
+    if (md == NULL)
+    {
+        SWSS_LOG_WARN("failed to get metadata for %d:%d", objectType, attrId);
+
+        return false;
+    }
+
+    if (!md->isreadonly)
+    {
+        SWSS_LOG_WARN("%s is not READ_ONLY attribute, will not add to container", md->attridname);
+
+        return false;
+    }
+
+    if (!isValueTypeSupported(md->attrvaluetype))
+    {
+        SWSS_LOG_WARN("%s value type is not supported, will not add to container", md->attridname);
+
+        return false;
+    }
+
+    m_readOnlyAttrs[objectType].insert(attrId);
+
+    SWSS_LOG_DEBUG("added %s to container", md->attridname);
+
+    return true;
+}
+
+bool AttributeCache::isCacheable(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_attr_id_t attrId) const
+{
+    SWSS_LOG_ENTER();
+
+    auto md = sai_metadata_get_attr_metadata(objectType, attrId);
+
+    if (md == NULL || !isValueTypeSupported(md->attrvaluetype))
+    {
+        return false;
+    }
+
+    if (md->iscreateonly)
+    {
+        return true;
+    }
+
+    auto it = m_readOnlyAttrs.find(objectType);
+
+    return it != m_readOnlyAttrs.end() && it->second.find(attrId) != it->second.end();
+}
+
+bool AttributeCache::get(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t objectId,
+        _In_ uint32_t attrCount,
+        _Inout_ sai_attribute_t *attrList,
+        _Out_ sai_status_t& status)
+{
+    SWSS_LOG_ENTER();
+
+    status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        if (!isCacheable(objectType, attrList[idx].id))
+        {
+            return false;
+        }
+    }
+
+    auto it = m_cache.find(objectId);
+
+    if (it == m_cache.end())
+    {
+        m_missCount++;
+        return false;
+    }
+
+    auto& attrs = it->second.attrs;
+
+    std::vector<const sai_attribute_t*> cached;
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        auto ita = attrs.find(attrList[idx].id);
+
+        if (ita == attrs.end())
+        {
+            m_missCount++;
+            return false;
+        }
+
+        cached.push_back(ita->second->getSaiAttr());
+    }
+
+    // all attributes are in cache, check if all lists will fit in user
+    // buffers, if not, only list counts are returned like syncd would do
+
+    bool overflow = false;
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        auto md = sai_metadata_get_attr_metadata(objectType, attrList[idx].id);
+
+        sai_attribute_value_t value = cached[idx]->value;
+
+        uint32_t* count = getListCount(md->attrvaluetype, attrList[idx].value);
+
+        if (count && *count < *getListCount(md->attrvaluetype, value))
+        {
+            overflow = true;
+        }
+    }
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        sai_status_t s = transfer_attributes(objectType, 1, cached[idx], &attrList[idx], overflow);
+
+        if (s != SAI_STATUS_SUCCESS)
+        {
+            status = s;
+        }
+    }
+
+    if (overflow && status == SAI_STATUS_SUCCESS)
+    {
+        status = SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    m_hitCount++;
+
+    return true;
+}
+
+void AttributeCache::update(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t objectId,
+        _In_ sai_object_id_t switchId,
+        _In_ uint32_t attrCount,
+        _In_ const sai_attribute_t *attrList)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t idx = 0; idx < attrCount; idx++)
+    {
+        if (!isCacheable(objectType, attrList[idx].id))
+        {
+            continue;
+        }
+
+        auto md = sai_metadata_get_attr_metadata(objectType, attrList[idx].id);
+
+        auto& entry = m_cache[objectId];
+
+        entry.switchId = switchId;
+
+        entry.attrs[attrList[idx].id] = std::make_shared<saimeta::SaiAttrWrapper>(md, attrList[idx]);
+    }
+}
+
+void AttributeCache::removeObject(
+        _In_ sai_object_id_t objectId)
+{
+    SWSS_LOG_ENTER();
+
+    m_cache.erase(objectId);
+}
+
+void AttributeCache::removeSwitch(
+        _In_ sai_object_id_t switchId)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto it = m_cache.begin(); it != m_cache.end(); )
+    {
+        if (it->second.switchId == switchId)
+        {
+            it = m_cache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void AttributeCache::clear()
+{
+    SWSS_LOG_ENTER();
+
+    m_cache.clear();
+}
+
+uint64_t AttributeCache::getHitCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_hitCount;
+}
+
+uint64_t AttributeCache::getMissCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_missCount;
+}
@@ -0,0 +1,254 @@
+#include "BinaryRecordingEncoder.h"
+
+#include "swss/logger.h"
+
+#include <cstring>
+
+using namespace sairedis;
+
+#define BINARY_RECORDING_MAX_DICTIONARY_SIZE    (1 << 20)
+#define BINARY_RECORDING_MAX_INTERN_SIZE        (128)
+#define BINARY_RECORDING_SHORT_PIECE_SIZE       (5)
+#define BINARY_RECORDING_TIMESTAMP_SIZE         (26)
+
+constexpr const char* BinaryRecordingEncoder::SEGMENT_HEADER;
+
+BinaryRecordingEncoder::BinaryRecordingEncoder()
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+void BinaryRecordingEncoder::putVarint(
+        _Inout_ std::string& buffer,
+        _In_ uint64_t value)
+{
+    SWSS_LOG_ENTER();
+
+    while (value >= 0x80)
+    {
+        buffer.push_back((char)((value & 0x7f) | 0x80));
+
+        value >>= 7;
+    }
+
+    buffer.push_back((char)value);
+}
+
+void BinaryRecordingEncoder::putString(
+        _Inout_ std::string& buffer,
+        _In_ const char* data,
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    putVarint(buffer, size);
+
+    buffer.append(data, size);
+}
+
+int BinaryRecordingEncoder::getDelimiterIndex(
+        _In_ char c)
+{
+    SWSS_LOG_ENTER();
+
+    switch (c)
+    {
+        case '|': return 0;
+        case '=': return 1;
+        case '"': return 2;
+        default: return -1;
+    }
+}
+
+char BinaryRecordingEncoder::getDelimiter(
+        _In_ uint32_t index)
+{
+    SWSS_LOG_ENTER();
+
+    switch (index)
+    {
+        case 0: return '|';
+        case 1: return '=';
+        case 2: return '"';
+        default:
+            SWSS_LOG_THROW("invalid delimiter index %u", index);
+    }
+}
+
+void BinaryRecordingEncoder::startSegment(
+        _Inout_ std::string& buffer)
+{
+    SWSS_LOG_ENTER();
+
+    m_dictionary.clear();
+
+    m_timestampPrefix.clear();
+
+    buffer.append(SEGMENT_HEADER, SEGMENT_HEADER_SIZE);
+}
+
+bool BinaryRecordingEncoder::shouldIntern(
+        _In_ const char* piece,
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    // short pieces are ops, JSON keys, booleans and small numbers, long
+    // ones are object types, attribute ids, enum values and OIDs, unique
+    // values like IP prefixes would only grow dictionary
+
+    if (size <= BINARY_RECORDING_SHORT_PIECE_SIZE)
+    {
+        return true;
+    }
+
+    if (size > BINARY_RECORDING_MAX_INTERN_SIZE)
+    {
+        return false;
+    }
+
+    return strncmp(piece, "SAI_", 4) == 0 || strncmp(piece, "oid:0x", 6) == 0;
+}
+
+void BinaryRecordingEncoder::encodeTimestamp(
+        _In_ const char* timestamp,
+        _In_ size_t size,
+        _Inout_ std::string& buffer)
+{
+    SWSS_LOG_ENTER();
+
+    // timestamp format is "YYYY-MM-DD.HH:MM:SS.uuuuuu"
+
+    bool valid = (size == BINARY_RECORDING_TIMESTAMP_SIZE) && timestamp[TIMESTAMP_PREFIX_SIZE - 1] == '.';
+
+    uint64_t usec = 0;
+
+    for (size_t idx = TIMESTAMP_PREFIX_SIZE; valid && idx < size; idx++)
+    {
+        if (timestamp[idx] < '0' || timestamp[idx] > '9')
+        {
+            valid = false;
+            break;
+        }
+
+        usec = usec * 10 + (uint64_t)(timestamp[idx] - '0');
+    }
+
+    if (!valid)
+    {
+        buffer.push_back((char)TIMESTAMP_LITERAL);
+
+        putString(buffer, timestamp, size);
+
+        return;
+    }
+
+    if (m_timestampPrefix.size() == TIMESTAMP_PREFIX_SIZE &&
+            memcmp(m_timestampPrefix.data(), timestamp, TIMESTAMP_PREFIX_SIZE) == 0)
+    {
+        buffer.push_back((char)TIMESTAMP_SAME_PREFIX);
+    }
+    else
+    {
+        m_timestampPrefix.assign(timestamp, TIMESTAMP_PREFIX_SIZE);
+
+        buffer.push_back((char)TIMESTAMP_NEW_PREFIX);
+
+        buffer.append(timestamp, TIMESTAMP_PREFIX_SIZE);
+    }
+
+    putVarint(buffer, usec);
+}
+
+void BinaryRecordingEncoder::encodePiece(
+        _In_ uint32_t delimiter,
+        _In_ const char* piece,
+        _In_ size_t size,
+        _Inout_ std::string& buffer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!shouldIntern(piece, size))
+    {
+        putVarint(buffer, (CODE_LITERAL << 2) | delimiter);
+
+        putString(buffer, piece, size);
+
+        return;
+    }
+
+    m_key.assign(piece, size);
+
+    auto it = m_dictionary.find(m_key);
+
+    if (it != m_dictionary.end())
+    {
+        putVarint(buffer, ((uint64_t)(it->second + CODE_REFERENCE) << 2) | delimiter);
+
+        return;
+    }
+
+    if (m_dictionary.size() >= BINARY_RECORDING_MAX_DICTIONARY_SIZE)
+    {
+        putVarint(buffer, (CODE_LITERAL << 2) | delimiter);
+    }
+    else
+    {
+        uint32_t index = (uint32_t)m_dictionary.size();
+
+        m_dictionary.emplace(m_key, index);
+
+        putVarint(buffer, (CODE_INTERN << 2) | delimiter);
+    }
+
+    putString(buffer, piece, size);
+}
+
+void BinaryRecordingEncoder::encode(
+        _In_ const char* line,
+        _In_ size_t size,
+        _Inout_ std::string& buffer)
+{
+    SWSS_LOG_ENTER();
+
+    const char* end = line + size;
+
+    const char* pos = (const char*)memchr(line, '|', size);
+
+    if (pos == nullptr)
+    {
+        pos = end;
+    }
+
+    encodeTimestamp(line, (size_t)(pos - line), buffer);
+
+    // count pieces first, each piece is preceded by delimiter
+
+    uint64_t count = 0;
+
+    for (const char* ptr = pos; ptr < end; ptr++)
+    {
+        if (getDelimiterIndex(*ptr) >= 0)
+        {
+            count++;
+        }
+    }
+
+    putVarint(buffer, count);
+
+    while (pos < end)
+    {
+        uint32_t delimiter = (uint32_t)getDelimiterIndex(*pos);
+
+        const char* start = ++pos;
+
+        while (pos < end && getDelimiterIndex(*pos) < 0)
+        {
+            pos++;
+        }
+
+        encodePiece(delimiter, start, (size_t)(pos - start), buffer);
+    }
+}
@@ -19,7 +19,13 @@ ContextConfig::ContextConfig(
     m_dbState(dbState),
     m_zmqEnable(false),
     m_zmqEndpoint("ipc:///tmp/zmq_ep"),
-    m_zmqNtfEndpoint("ipc:///tmp/zmq_ntf_ep")
+    m_zmqNtfEndpoint("ipc:///tmp/zmq_ntf_ep"),
+    m_zmqCodec(ZeroMQMessageCodec::CODEC_JSON),
+    m_zmqPipeline(false),
+    m_shmEnable(false),
+    m_shmEndpoint("/tmp/sairedis_shm_ep"),
+    m_shmRingSize(0),
+    m_vidBlockSize(1)
 {
     SWSS_LOG_ENTER();
 
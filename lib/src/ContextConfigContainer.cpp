@@ -4,6 +4,7 @@
 #include "swss/json.hpp"
 
 #include <cstring>
+#include <cinttypes>
 #include <fstream>
 
 using json = nlohmann::json;
@@ -117,10 +118,59 @@ std::shared_ptr<ContextConfigContainer> ContextConfigContainer::loadFromFile(
             cc->m_zmqEndpoint = item["zmq_endpoint"];
             cc->m_zmqNtfEndpoint = item["zmq_ntf_endpoint"];
 
-            SWSS_LOG_NOTICE("contextConfig zmq enable %s, endpoint: %s, ntf endpoint: %s",
+            if (item.find("zmq_codec") != item.end())
+            {
+                cc->m_zmqCodec = ZeroMQMessageCodec::parseCodec(item["zmq_codec"]);
+            }
+
+            if (item.find("zmq_pipeline") != item.end())
+            {
+                cc->m_zmqPipeline = item["zmq_pipeline"];
+            }
+
+            SWSS_LOG_NOTICE("contextConfig zmq enable %s, endpoint: %s, ntf endpoint: %s, codec: %s, pipeline: %s",
                     (cc->m_zmqEnable) ? "true" : "false",
                     cc->m_zmqEndpoint.c_str(),
-                    cc->m_zmqNtfEndpoint.c_str());
+                    cc->m_zmqNtfEndpoint.c_str(),
+                    ZeroMQMessageCodec::codecName(cc->m_zmqCodec).c_str(),
+                    (cc->m_zmqPipeline) ? "true" : "false");
+
+            if (item.find("shm_enable") != item.end())
+            {
+                cc->m_shmEnable = item["shm_enable"];
+            }
+
+            if (item.find("shm_endpoint") != item.end())
+            {
+                cc->m_shmEndpoint = item["shm_endpoint"];
+            }
+
+            if (item.find("shm_ring_size") != item.end())
+            {
+                cc->m_shmRingSize = item["shm_ring_size"];
+            }
+
+            if (cc->m_zmqEnable && cc->m_shmEnable)
+            {
+                SWSS_LOG_THROW("zmq and shm can't be both enabled in context '%s'", cc->m_name.c_str());
+            }
+
+            SWSS_LOG_NOTICE("contextConfig shm enable %s, endpoint: %s, ring size: %zu",
+                    (cc->m_shmEnable) ? "true" : "false",
+                    cc->m_shmEndpoint.c_str(),
+                    cc->m_shmRingSize);
+
+            if (item.find("vid_block_size") != item.end())
+            {
+                cc->m_vidBlockSize = item["vid_block_size"];
+
+                if (cc->m_vidBlockSize == 0)
+                {
+                    SWSS_LOG_THROW("vid_block_size must be greater than 0 in context '%s'", cc->m_name.c_str());
+                }
+            }
+
+            SWSS_LOG_NOTICE("contextConfig vid block size: %" PRIu64, cc->m_vidBlockSize);
 
             for (size_t k = 0; k < item["switches"].size(); k++)
             {
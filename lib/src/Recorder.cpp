@@ -22,7 +22,9 @@ std::vector<swss::FieldValueTuple> serialize_counter_id_list(
         _In_ const sai_stat_id_t *counter_id_list);
 
 #define MUTEX() std::lock_guard<std::mutex> _lock(m_mutex)
+#define FILE_MUTEX() std::lock_guard<std::mutex> _fileLock(m_fileMutex)
 #define DEFAULT_RECORDING_FILE_NAME "sairedis.rec"
+#define ASYNC_RECORDING_MAX_RECORDS (64 * 1024)
 Recorder::Recorder()
 {
     SWSS_LOG_ENTER();
@@ -36,6 +38,12 @@ Recorder::Recorder()
     m_enabled = false;
 
     m_recordStats = true;
+
+    m_reportedDropped = 0;
+
+    m_recordingFormat = SAI_REDIS_RECORDING_FORMAT_TEXT;
+
+    m_gzFile = nullptr;
 }
 
 Recorder::~Recorder()
@@ -43,6 +51,10 @@ Recorder::~Recorder()
     SWSS_LOG_ENTER();
 
     stopRecording();
+
+    // stop writer thread before any member is destroyed
+
+    m_writer = nullptr;
 }
 
 bool Recorder::setRecordingOutputDirectory(
@@ -149,6 +161,45 @@ bool Recorder::setRecordingFilename(
     return true;
 }
 
+bool Recorder::setRecordingFormat(
+        _In_ sai_redis_recording_format_t format)
+{
+    SWSS_LOG_ENTER();
+
+    switch (format)
+    {
+        case SAI_REDIS_RECORDING_FORMAT_TEXT:
+        case SAI_REDIS_RECORDING_FORMAT_BINARY:
+        case SAI_REDIS_RECORDING_FORMAT_BINARY_COMPRESSED:
+            break;
+
+        default:
+
+            SWSS_LOG_ERROR("unknown recording format: %d", format);
+
+            return false;
+    }
+
+    /// Stop the recording with old format before updating the format, new
+    /// format is recorded to file with different suffix
+    if (m_enabled)
+    {
+        stopRecording();
+    }
+
+    m_recordingFormat = format;
+
+    SWSS_LOG_NOTICE("setting recording format: %d", format);
+
+    /// Start recording with new format
+    if (m_enabled)
+    {
+        startRecording();
+    }
+
+    return true;
+}
+
 void Recorder::enableRecording(
         _In_ bool enabled)
 {
@@ -176,24 +227,243 @@ void Recorder::recordLine(
         return;
     }
 
-    if (m_ofstream.is_open())
+    if (m_writer)
     {
-        m_ofstream << getTimestamp() << "|" << line << std::endl;
+        pushRecord(line);
+    }
+    else
+    {
+        writeRecords(getTimestamp() + "|" + line + "\n");
     }
 
     if (m_performLogRotate)
     {
         m_performLogRotate = false;
 
+        if (m_writer)
+        {
+            // all records before log rotate must land in old file
+
+            m_writer->flush();
+        }
+
         recordingFileReopen();
 
-        /* double check since reopen could fail */
+        /* reopen could fail, write will check if file is open */
+
+        if (m_writer)
+        {
+            pushRecord("#|logrotate on: " + m_recordingFile);
+        }
+        else
+        {
+            writeRecords(getTimestamp() + "|#|logrotate on: " + m_recordingFile + "\n");
+        }
+    }
+}
+
+void Recorder::pushRecord(
+        _In_ const std::string& line)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t dropped = m_writer->getDroppedCount();
+
+    if (dropped != m_reportedDropped)
+    {
+        // make gap in recording visible to reader and player
+
+        std::string marker = getTimestamp() + "|#|recorder queue overflow, dropped "
+            + std::to_string(dropped - m_reportedDropped) + " records\n";
+
+        if (m_writer->push(std::move(marker)))
+        {
+            m_reportedDropped = dropped;
+        }
+    }
+
+    m_writer->push(getTimestamp() + "|" + line + "\n");
+}
+
+void Recorder::writeRecords(
+        _In_ const std::string& records)
+{
+    FILE_MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    if (m_ofstream.is_open())
+    {
+        m_ofstream.write(records.data(), records.size());
+
+        m_ofstream.flush();
+
+        return;
+    }
+
+    if (m_gzFile == nullptr)
+    {
+        return;
+    }
+
+    m_binaryBuffer.clear();
+
+    size_t start = 0;
+
+    while (start < records.size())
+    {
+        size_t end = records.find('\n', start);
+
+        if (end == std::string::npos)
+        {
+            end = records.size();
+        }
+
+        m_encoder.encode(records.data() + start, end - start, m_binaryBuffer);
+
+        start = end + 1;
+    }
+
+    writeBinaryBuffer();
+}
+
+void Recorder::writeBinaryBuffer()
+{
+    SWSS_LOG_ENTER();
+
+    if (gzwrite(m_gzFile, m_binaryBuffer.data(), (unsigned)m_binaryBuffer.size()) != (int)m_binaryBuffer.size())
+    {
+        int err;
+
+        SWSS_LOG_ERROR("failed to write recording file %s: %s", m_recordingFile.c_str(), gzerror(m_gzFile, &err));
+    }
+
+    // sync flush keeps compression history, so it's cheap enough to do it
+    // after each write, and file is readable at any time
+
+    gzflush(m_gzFile, Z_SYNC_FLUSH);
+}
+
+std::string Recorder::getRecordingFileSuffix() const
+{
+    SWSS_LOG_ENTER();
+
+    switch (m_recordingFormat)
+    {
+        case SAI_REDIS_RECORDING_FORMAT_BINARY:
+            return ".bin";
+
+        case SAI_REDIS_RECORDING_FORMAT_BINARY_COMPRESSED:
+            return ".bin.gz";
+
+        default:
+            return "";
+    }
+}
+
+bool Recorder::openRecordingFile()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_recordingFormat == SAI_REDIS_RECORDING_FORMAT_TEXT)
+    {
+        m_ofstream.open(m_recordingFile, std::ofstream::out | std::ofstream::app);
 
-        if (m_ofstream.is_open())
+        if (!m_ofstream.is_open())
         {
-            m_ofstream << getTimestamp() << "|" << "#|logrotate on: " << m_recordingFile << std::endl;
+            SWSS_LOG_ERROR("failed to open recording file %s: %s", m_recordingFile.c_str(), strerror(errno));
+            return false;
         }
+
+        return true;
+    }
+
+    // "T" is transparent write, without compression
+
+    const char* mode = (m_recordingFormat == SAI_REDIS_RECORDING_FORMAT_BINARY_COMPRESSED) ? "ab" : "abT";
+
+    m_gzFile = gzopen(m_recordingFile.c_str(), mode);
+
+    if (m_gzFile == nullptr)
+    {
+        SWSS_LOG_ERROR("failed to open recording file %s: %s", m_recordingFile.c_str(), strerror(errno));
+        return false;
+    }
+
+    // each open starts new segment, so rotated files can be decoded separately
+
+    m_binaryBuffer.clear();
+
+    m_encoder.startSegment(m_binaryBuffer);
+
+    writeBinaryBuffer();
+
+    return true;
+}
+
+bool Recorder::isRecordingFileOpen() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_ofstream.is_open() || m_gzFile != nullptr;
+}
+
+void Recorder::closeRecordingFile()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_ofstream.is_open())
+    {
+        m_ofstream.close();
+    }
+
+    if (m_gzFile)
+    {
+        gzclose(m_gzFile);
+
+        m_gzFile = nullptr;
+    }
+}
+
+void Recorder::enableAsyncRecording(
+        _In_ bool enabled)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    if (enabled == (m_writer != nullptr))
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        m_reportedDropped = 0;
+
+        m_writer = std::make_shared<RecorderWriter>(
+                ASYNC_RECORDING_MAX_RECORDS,
+                std::bind(&Recorder::writeRecords, this, std::placeholders::_1));
+
+        SWSS_LOG_NOTICE("enabled asynchronous recording");
+
+        return;
     }
+
+    // writer will drain all pending records in destructor
+
+    SWSS_LOG_NOTICE("disabling asynchronous recording, dropped %" PRIu64 " records in %" PRIu64 " overflows",
+            m_writer->getDroppedCount(),
+            m_writer->getOverflowCount());
+
+    m_writer = nullptr;
+}
+
+uint64_t Recorder::getDroppedRecordCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_writer ? m_writer->getDroppedCount() : 0;
 }
 
 void Recorder::requestLogRotate()
@@ -205,9 +475,11 @@ void Recorder::requestLogRotate()
 
 void Recorder::recordingFileReopen()
 {
+    FILE_MUTEX();
+
     SWSS_LOG_ENTER();
 
-    m_ofstream.close();
+    closeRecordingFile();
 
     /*
      * On log rotate we will use the same file name, we are assuming that
@@ -215,27 +487,22 @@ void Recorder::recordingFileReopen()
      * empty file here.
      */
 
-    m_ofstream.open(m_recordingFile, std::ofstream::out | std::ofstream::app);
-
-    if (!m_ofstream.is_open())
-    {
-        SWSS_LOG_ERROR("failed to open recording file %s: %s", m_recordingFile.c_str(), strerror(errno));
-        return;
-    }
+    openRecordingFile();
 }
 
 void Recorder::startRecording()
 {
     SWSS_LOG_ENTER();
 
-    m_recordingFile = m_recordingOutputDirectory + "/" + m_recordingFileName;
-
-    m_ofstream.open(m_recordingFile, std::ofstream::out | std::ofstream::app);
+    m_recordingFile = m_recordingOutputDirectory + "/" + m_recordingFileName + getRecordingFileSuffix();
 
-    if (!m_ofstream.is_open())
     {
-        SWSS_LOG_ERROR("failed to open recording file %s: %s", m_recordingFile.c_str(), strerror(errno));
-        return;
+        FILE_MUTEX();
+
+        if (!openRecordingFile())
+        {
+            return;
+        }
     }
 
     recordLine("#|recording on: " + m_recordingFile);
@@ -249,9 +516,16 @@ void Recorder::stopRecording()
 
     SWSS_LOG_NOTICE("stopped recording");
 
-    if (m_ofstream.is_open())
+    if (m_writer)
     {
-        m_ofstream.close();
+        m_writer->flush();
+    }
+
+    FILE_MUTEX();
+
+    if (isRecordingFileOpen())
+    {
+        closeRecordingFile();
 
         SWSS_LOG_NOTICE("closed recording file: %s", m_recordingFileName.c_str());
     }
@@ -0,0 +1,182 @@
+#include "RecorderWriter.h"
+
+#include "swss/logger.h"
+
+#include <chrono>
+
+using namespace sairedis;
+
+#define RECORDER_WRITER_IDLE_WAIT_MS (100)
+
+RecorderWriter::RecorderWriter(
+        _In_ size_t maxRecords,
+        _In_ Sink sink):
+    m_sink(sink),
+    m_head(0),
+    m_tail(0),
+    m_written(0),
+    m_dropped(0),
+    m_overflows(0),
+    m_overflowing(false),
+    m_writerSleeping(false),
+    m_runThread(true)
+{
+    SWSS_LOG_ENTER();
+
+    size_t capacity = 2;
+
+    while (capacity < maxRecords)
+    {
+        capacity <<= 1;
+    }
+
+    m_slots.resize(capacity);
+
+    m_mask = capacity - 1;
+
+    m_writerThread = std::make_shared<std::thread>(&RecorderWriter::writerThreadFunction, this);
+}
+
+RecorderWriter::~RecorderWriter()
+{
+    SWSS_LOG_ENTER();
+
+    // writer will drain all remaining records before exit
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_runThread = false;
+    }
+
+    m_writerCv.notify_one();
+
+    m_writerThread->join();
+}
+
+bool RecorderWriter::push(
+        _Inout_ std::string&& record)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    uint64_t head = m_head.load(std::memory_order_acquire);
+
+    if (tail - head > m_mask)
+    {
+        m_dropped++;
+
+        if (!m_overflowing)
+        {
+            m_overflowing = true;
+
+            m_overflows++;
+        }
+
+        return false;
+    }
+
+    m_overflowing = false;
+
+    m_slots[tail & m_mask] = std::move(record);
+
+    // store and load must be sequentially consistent, paired with writer
+    // announcing sleep, otherwise we could miss sleeping writer
+
+    m_tail.store(tail + 1);
+
+    if (m_writerSleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_writerCv.notify_one();
+    }
+
+    return true;
+}
+
+void RecorderWriter::flush()
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t target = m_tail.load();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_writerCv.notify_one();
+
+    m_flushCv.wait(lock, [&]{ return m_written.load() >= target; });
+}
+
+uint64_t RecorderWriter::getDroppedCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_dropped.load();
+}
+
+uint64_t RecorderWriter::getOverflowCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_overflows.load();
+}
+
+void RecorderWriter::writerThreadFunction()
+{
+    SWSS_LOG_ENTER();
+
+    std::string batch;
+
+    while (true)
+    {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            if (!m_runThread)
+            {
+                break;
+            }
+
+            m_writerSleeping = true;
+
+            if (m_tail.load() == head)
+            {
+                m_writerCv.wait_for(lock, std::chrono::milliseconds(RECORDER_WRITER_IDLE_WAIT_MS));
+            }
+
+            m_writerSleeping = false;
+
+            continue;
+        }
+
+        batch.clear();
+
+        for (uint64_t pos = head; pos != tail; pos++)
+        {
+            auto& slot = m_slots[pos & m_mask];
+
+            batch += slot;
+
+            slot.clear();
+        }
+
+        // release slots to producer before doing actual write
+
+        m_head.store(tail, std::memory_order_release);
+
+        m_sink(batch);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_written = tail;
+        }
+
+        m_flushCv.notify_all();
+    }
+}
@@ -0,0 +1,329 @@
+#include "RecordingReader.h"
+#include "BinaryRecordingEncoder.h"
+
+#include "swss/logger.h"
+
+#include <cstring>
+#include <cinttypes>
+#include <algorithm>
+
+using namespace sairedis;
+
+#define RECORDING_READER_BUFFER_SIZE (64 * 1024)
+
+RecordingReader::RecordingReader(
+        _In_ const std::string& filename):
+    m_filename(filename),
+    m_binary(false),
+    m_buffer(RECORDING_READER_BUFFER_SIZE),
+    m_bufferPos(0),
+    m_bufferSize(0)
+{
+    SWSS_LOG_ENTER();
+
+    // gzip reader transparently reads not compressed files
+
+    m_file = gzopen(filename.c_str(), "rb");
+
+    if (m_file == nullptr)
+    {
+        SWSS_LOG_ERROR("failed to open recording file %s: %s", filename.c_str(), strerror(errno));
+
+        return;
+    }
+
+    gzbuffer(m_file, RECORDING_READER_BUFFER_SIZE);
+
+    int c = readByte();
+
+    if (c < 0)
+    {
+        return; // empty file
+    }
+
+    m_bufferPos--; // unread first byte
+
+    m_binary = (c == BinaryRecordingEncoder::SEGMENT_HEADER[0]);
+
+    SWSS_LOG_NOTICE("recording file %s format: %s", filename.c_str(), m_binary ? "binary" : "text");
+}
+
+RecordingReader::~RecordingReader()
+{
+    SWSS_LOG_ENTER();
+
+    close();
+}
+
+void RecordingReader::close()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_file)
+    {
+        gzclose(m_file);
+
+        m_file = nullptr;
+    }
+}
+
+bool RecordingReader::is_open() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_file != nullptr;
+}
+
+bool RecordingReader::isBinary() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_binary;
+}
+
+int RecordingReader::readByte()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bufferPos == m_bufferSize)
+    {
+        int size = gzread(m_file, m_buffer.data(), (unsigned)m_buffer.size());
+
+        if (size < 0)
+        {
+            int err;
+
+            SWSS_LOG_THROW("failed to read recording file %s: %s", m_filename.c_str(), gzerror(m_file, &err));
+        }
+
+        m_bufferPos = 0;
+        m_bufferSize = (size_t)size;
+
+        if (size == 0)
+        {
+            return -1;
+        }
+    }
+
+    return (uint8_t)m_buffer[m_bufferPos++];
+}
+
+uint8_t RecordingReader::readRequiredByte()
+{
+    SWSS_LOG_ENTER();
+
+    int c = readByte();
+
+    if (c < 0)
+    {
+        SWSS_LOG_THROW("binary recording file %s is truncated", m_filename.c_str());
+    }
+
+    return (uint8_t)c;
+}
+
+uint64_t RecordingReader::readVarint()
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t c = readRequiredByte();
+
+        value |= (uint64_t)(c & 0x7f) << shift;
+
+        if ((c & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    SWSS_LOG_THROW("binary recording file %s has invalid varint", m_filename.c_str());
+}
+
+void RecordingReader::readBytes(
+        _In_ size_t size,
+        _Out_ std::string& data)
+{
+    SWSS_LOG_ENTER();
+
+    data.clear();
+
+    while (data.size() < size)
+    {
+        if (m_bufferPos == m_bufferSize)
+        {
+            readRequiredByte();
+
+            m_bufferPos--; // unread, only refill buffer
+        }
+
+        size_t chunk = std::min(size - data.size(), m_bufferSize - m_bufferPos);
+
+        data.append(&m_buffer[m_bufferPos], chunk);
+
+        m_bufferPos += chunk;
+    }
+}
+
+bool RecordingReader::getline(
+        _Out_ std::string& line)
+{
+    SWSS_LOG_ENTER();
+
+    line.clear();
+
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    return m_binary ? readBinaryLine(line) : readTextLine(line);
+}
+
+bool RecordingReader::readTextLine(
+        _Out_ std::string& line)
+{
+    SWSS_LOG_ENTER();
+
+    while (true)
+    {
+        if (m_bufferPos == m_bufferSize)
+        {
+            if (readByte() < 0)
+            {
+                return line.size() > 0;
+            }
+
+            m_bufferPos--;
+        }
+
+        const char* start = &m_buffer[m_bufferPos];
+
+        size_t left = m_bufferSize - m_bufferPos;
+
+        const char* nl = (const char*)memchr(start, '\n', left);
+
+        if (nl)
+        {
+            line.append(start, (size_t)(nl - start));
+
+            m_bufferPos += (size_t)(nl - start) + 1;
+
+            return true;
+        }
+
+        line.append(start, left);
+
+        m_bufferPos = m_bufferSize;
+    }
+}
+
+void RecordingReader::readSegmentHeader()
+{
+    SWSS_LOG_ENTER();
+
+    // first byte of header is already consumed
+
+    for (size_t idx = 1; idx < BinaryRecordingEncoder::SEGMENT_HEADER_SIZE; idx++)
+    {
+        if (readRequiredByte() != (uint8_t)BinaryRecordingEncoder::SEGMENT_HEADER[idx])
+        {
+            SWSS_LOG_THROW("binary recording file %s has invalid segment header", m_filename.c_str());
+        }
+    }
+
+    m_dictionary.clear();
+
+    m_timestampPrefix.clear();
+}
+
+bool RecordingReader::readBinaryLine(
+        _Out_ std::string& line)
+{
+    SWSS_LOG_ENTER();
+
+    int tag;
+
+    while ((tag = readByte()) == BinaryRecordingEncoder::SEGMENT_HEADER[0])
+    {
+        readSegmentHeader();
+    }
+
+    if (tag < 0)
+    {
+        return false;
+    }
+
+    switch (tag)
+    {
+        case BinaryRecordingEncoder::TIMESTAMP_NEW_PREFIX:
+
+            readBytes(BinaryRecordingEncoder::TIMESTAMP_PREFIX_SIZE, m_timestampPrefix);
+
+            // fall through
+
+        case BinaryRecordingEncoder::TIMESTAMP_SAME_PREFIX:
+            {
+                if (m_timestampPrefix.empty())
+                {
+                    SWSS_LOG_THROW("binary recording file %s has no timestamp prefix", m_filename.c_str());
+                }
+
+                char usec[32];
+
+                snprintf(usec, sizeof(usec), "%06" PRIu64, readVarint());
+
+                line = m_timestampPrefix + usec;
+            }
+            break;
+
+        case BinaryRecordingEncoder::TIMESTAMP_LITERAL:
+
+            readBytes(readVarint(), line);
+            break;
+
+        default:
+            SWSS_LOG_THROW("binary recording file %s has invalid record tag 0x%x", m_filename.c_str(), tag);
+    }
+
+    uint64_t count = readVarint();
+
+    for (uint64_t idx = 0; idx < count; idx++)
+    {
+        uint64_t code = readVarint();
+
+        line += BinaryRecordingEncoder::getDelimiter((uint32_t)(code & 3));
+
+        uint64_t value = code >> 2;
+
+        if (value >= BinaryRecordingEncoder::CODE_REFERENCE)
+        {
+            uint64_t index = value - BinaryRecordingEncoder::CODE_REFERENCE;
+
+            if (index >= m_dictionary.size())
+            {
+                SWSS_LOG_THROW("binary recording file %s references unknown dictionary entry %" PRIu64,
+                        m_filename.c_str(),
+                        index);
+            }
+
+            line += m_dictionary[index];
+
+            continue;
+        }
+
+        readBytes(readVarint(), m_piece);
+
+        line += m_piece;
+
+        if (value == BinaryRecordingEncoder::CODE_INTERN)
+        {
+            m_dictionary.push_back(m_piece);
+        }
+    }
+
+    return true;
+}
@@ -6,6 +6,7 @@
 #include "SkipRecordAttrContainer.h"
 #include "SwitchContainer.h"
 #include "ZeroMQChannel.h"
+#include "ShmChannel.h"
 #include "PerformanceIntervalTimer.h"
 
 #include "sairediscommon.h"
@@ -35,7 +36,15 @@ RedisRemoteSaiInterface::RedisRemoteSaiInterface(
     m_contextConfig(contextConfig),
     m_redisCommunicationMode(SAI_REDIS_COMMUNICATION_MODE_REDIS_ASYNC),
     m_recorder(recorder),
-    m_notificationCallback(notificationCallback)
+    m_attributeCacheEnabled(false),
+    m_notificationCallback(notificationCallback),
+    m_asyncPipelineDepth(0),
+    m_asyncSequence(0),
+    m_asyncFailureNotify(nullptr),
+    m_autoBulkMaxSize(0),
+    m_autoBulkMaxDelayUs(1000),
+    m_autoBulkApi(SAI_COMMON_API_CREATE),
+    m_autoBulkObjectType(SAI_OBJECT_TYPE_NULL)
 {
     SWSS_LOG_ENTER();
 
@@ -69,22 +78,45 @@ sai_status_t RedisRemoteSaiInterface::initialize(
 
     m_skipRecordAttrContainer = std::make_shared<SkipRecordAttrContainer>();
 
+    m_attributeCache = std::make_shared<AttributeCache>();
+    m_attributeCacheEnabled = false;
+
     m_asicInitViewMode = false; // default mode is apply mode
     m_useTempView = false;
     m_syncMode = false;
     m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_REDIS_ASYNC;
 
+    m_asyncPipelineDepth = 0;
+    m_asyncPending.clear();
+    m_asyncFailures.clear();
+
+    m_autoBulkMaxSize = 0;
+    m_autoBulkEntries.clear();
+    m_autoBulkRequests.clear();
+
     if (m_contextConfig->m_zmqEnable)
     {
         m_communicationChannel = std::make_shared<ZeroMQChannel>(
                 m_contextConfig->m_zmqEndpoint,
                 m_contextConfig->m_zmqNtfEndpoint,
-                std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3));
+                std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3),
+                m_contextConfig->m_zmqCodec,
+                m_contextConfig->m_zmqPipeline);
 
         SWSS_LOG_NOTICE("zmq enabled, forcing sync mode");
 
         m_syncMode = true;
     }
+    else if (m_contextConfig->m_shmEnable)
+    {
+        m_communicationChannel = std::make_shared<ShmChannel>(
+                m_contextConfig->m_shmEndpoint,
+                std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3));
+
+        SWSS_LOG_NOTICE("shm enabled, forcing sync mode");
+
+        m_syncMode = true;
+    }
     else
     {
         m_communicationChannel = std::make_shared<RedisChannel>(
@@ -96,7 +128,7 @@ sai_status_t RedisRemoteSaiInterface::initialize(
 
     m_db = std::make_shared<swss::DBConnector>(m_contextConfig->m_dbAsic, 0);
 
-    m_redisVidIndexGenerator = std::make_shared<RedisVidIndexGenerator>(m_db, REDIS_KEY_VIDCOUNTER);
+    m_redisVidIndexGenerator = std::make_shared<RedisVidIndexGenerator>(m_db, REDIS_KEY_VIDCOUNTER, m_contextConfig->m_vidBlockSize);
 
     clear_local_state();
 
@@ -120,6 +152,8 @@ sai_status_t RedisRemoteSaiInterface::uninitialize(void)
         return SAI_STATUS_FAILURE;
     }
 
+    waitForAllAsyncResponses();
+
     m_communicationChannel = nullptr; // will stop thread
 
     // clear local state after stopping threads
@@ -289,10 +323,14 @@ sai_status_t RedisRemoteSaiInterface::remove(
             objectType,
             sai_serialize_object_id(objectId));
 
+    m_attributeCache->removeObject(objectId);
+
     if (objectType == SAI_OBJECT_TYPE_SWITCH && status == SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_NOTICE("removing switch id %s", sai_serialize_object_id(objectId).c_str());
 
+        m_attributeCache->removeSwitch(objectId);
+
         m_virtualObjectIdManager->releaseObjectId(objectId);
 
         // remove switch from container
@@ -371,11 +409,13 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
 
             SWSS_LOG_WARN("sync mode is depreacated, use communication mode");
 
+            waitForAllAsyncResponses();
+
             m_syncMode = attr->value.booldata;
 
-            if (m_contextConfig->m_zmqEnable)
+            if (m_contextConfig->m_zmqEnable || m_contextConfig->m_shmEnable)
             {
-                SWSS_LOG_NOTICE("zmq enabled, forcing sync mode");
+                SWSS_LOG_NOTICE("zmq or shm enabled, forcing sync mode");
 
                 m_syncMode = true;
             }
@@ -391,6 +431,8 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
 
         case SAI_REDIS_SWITCH_ATTR_REDIS_COMMUNICATION_MODE:
 
+            waitForAllAsyncResponses();
+
             m_redisCommunicationMode = (sai_redis_communication_mode_t)attr->value.s32;
 
             if (m_contextConfig->m_zmqEnable)
@@ -400,6 +442,13 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
                 m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_ZMQ_SYNC;
             }
 
+            if (m_contextConfig->m_shmEnable)
+            {
+                SWSS_LOG_NOTICE("shm enabled via context config");
+
+                m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC;
+            }
+
             m_communicationChannel = nullptr;
 
             switch (m_redisCommunicationMode)
@@ -446,7 +495,9 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
                     m_communicationChannel = std::make_shared<ZeroMQChannel>(
                             m_contextConfig->m_zmqEndpoint,
                             m_contextConfig->m_zmqNtfEndpoint,
-                            std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3));
+                            std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3),
+                            m_contextConfig->m_zmqCodec,
+                            m_contextConfig->m_zmqPipeline);
 
                     m_communicationChannel->setResponseTimeout(m_responseTimeoutMs);
 
@@ -458,6 +509,32 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
 
                     m_communicationChannel->setBuffered(false);
 
+                    if (m_asyncPipelineDepth && !m_contextConfig->m_zmqPipeline)
+                    {
+                        SWSS_LOG_WARN("async pipeline requires zmq_pipeline in context config, disabling");
+
+                        m_asyncPipelineDepth = 0;
+                    }
+
+                    return SAI_STATUS_SUCCESS;
+
+                case SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC:
+
+                    m_contextConfig->m_shmEnable = true;
+
+                    // main communication channel was created at initialize method
+                    // so this command will replace it with shm channel
+
+                    m_communicationChannel = std::make_shared<ShmChannel>(
+                            m_contextConfig->m_shmEndpoint,
+                            std::bind(&RedisRemoteSaiInterface::handleNotification, this, _1, _2, _3));
+
+                    m_communicationChannel->setResponseTimeout(m_responseTimeoutMs);
+
+                    SWSS_LOG_NOTICE("shm enabled, forcing sync mode");
+
+                    m_syncMode = true;
+
                     return SAI_STATUS_SUCCESS;
 
                 default:
@@ -482,6 +559,8 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
 
         case SAI_REDIS_SWITCH_ATTR_FLUSH:
 
+            flushAutoBulk();
+
             m_communicationChannel->flush();
 
             return SAI_STATUS_SUCCESS;
@@ -503,7 +582,71 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
             }
 
             return SAI_STATUS_SUCCESS;
-            
+
+        case SAI_REDIS_SWITCH_ATTR_RECORDING_ASYNC:
+
+            if (m_recorder)
+            {
+                m_recorder->enableAsyncRecording(attr->value.booldata);
+            }
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_RECORDING_FORMAT:
+
+            if (m_recorder && !m_recorder->setRecordingFormat((sai_redis_recording_format_t)attr->value.s32))
+            {
+                return SAI_STATUS_INVALID_PARAMETER;
+            }
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_ASYNC_PIPELINE_DEPTH:
+
+            return setAsyncPipelineDepth(attr->value.u32);
+
+        case SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY:
+
+            m_asyncFailureNotify = (sai_redis_async_failure_notification_fn)attr->value.ptr;
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN:
+
+            if (attr->value.booldata)
+            {
+                std::vector<AsyncFailure> failures;
+
+                return drainAsyncResponses(failures);
+            }
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_SIZE:
+
+            return setAutoBulkMaxSize(attr->value.u32);
+
+        case SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_DELAY:
+
+            m_autoBulkMaxDelayUs = attr->value.u32;
+
+            SWSS_LOG_NOTICE("set auto bulk max delay to %u us", m_autoBulkMaxDelayUs);
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE:
+
+            m_attributeCacheEnabled = attr->value.booldata;
+
+            if (!m_attributeCacheEnabled)
+            {
+                m_attributeCache->clear();
+            }
+
+            SWSS_LOG_NOTICE("attribute cache %s", m_attributeCacheEnabled ? "enabled" : "disabled");
+
+            return SAI_STATUS_SUCCESS;
+
         default:
             break;
     }
@@ -513,6 +656,36 @@ sai_status_t RedisRemoteSaiInterface::setRedisExtensionAttribute(
     return SAI_STATUS_FAILURE;
 }
 
+sai_status_t RedisRemoteSaiInterface::getRedisExtensionAttribute(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t objectId,
+        _Inout_ sai_attribute_t *attr)
+{
+    SWSS_LOG_ENTER();
+
+    switch (attr->id)
+    {
+        case SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE_HIT_COUNT:
+
+            attr->value.u64 = m_attributeCache->getHitCount();
+
+            return SAI_STATUS_SUCCESS;
+
+        case SAI_REDIS_SWITCH_ATTR_ATTRIBUTE_CACHE_MISS_COUNT:
+
+            attr->value.u64 = m_attributeCache->getMissCount();
+
+            return SAI_STATUS_SUCCESS;
+
+        default:
+            break;
+    }
+
+    SWSS_LOG_ERROR("redis extension attribute %d is not readable", attr->id);
+
+    return SAI_STATUS_NOT_SUPPORTED;
+}
+
 sai_status_t RedisRemoteSaiInterface::set(
         _In_ sai_object_type_t objectType,
         _In_ sai_object_id_t objectId,
@@ -559,11 +732,48 @@ sai_status_t RedisRemoteSaiInterface::get(
 {
     SWSS_LOG_ENTER();
 
-    return get(
+    if (attr_count == 1 && RedisRemoteSaiInterface::isRedisAttribute(objectType, attr_list))
+    {
+        return getRedisExtensionAttribute(objectType, objectId, attr_list);
+    }
+
+    sai_status_t status;
+
+    if (m_attributeCacheEnabled && m_attributeCache->get(objectType, objectId, attr_count, attr_list, status))
+    {
+        SWSS_LOG_DEBUG("get %s served from attribute cache", sai_serialize_object_id(objectId).c_str());
+
+        bool record = !m_skipRecordAttrContainer->canSkipRecording(objectType, attr_count, attr_list);
+
+        if (record)
+        {
+            auto key = sai_serialize_object_type(objectType) + ":" + sai_serialize_object_id(objectId);
+
+            m_recorder->recordGenericGet(key, SaiAttributeList::serialize_attr_list(objectType, attr_count, attr_list, false));
+
+            m_recorder->recordGenericGetResponse(status, objectType, attr_count, attr_list);
+        }
+
+        return status;
+    }
+
+    status = get(
             objectType,
             sai_serialize_object_id(objectId),
             attr_count,
             attr_list);
+
+    if (m_attributeCacheEnabled && status == SAI_STATUS_SUCCESS)
+    {
+        m_attributeCache->update(
+                objectType,
+                objectId,
+                m_virtualObjectIdManager->saiSwitchIdQuery(objectId),
+                attr_count,
+                attr_list);
+    }
+
+    return status;
 }
 
 
@@ -653,16 +863,37 @@ sai_status_t RedisRemoteSaiInterface::create(
         entry.push_back(null);
     }
 
+    if (isAutoBulkEnabled(object_type))
+    {
+        return enqueueAutoBulkRequest(SAI_COMMON_API_CREATE, object_type, serializedObjectId, joinFieldValues(entry));
+    }
+
     auto serializedObjectType = sai_serialize_object_type(object_type);
 
     const std::string key = serializedObjectType + ":" + serializedObjectId;
 
     SWSS_LOG_DEBUG("generic create key: %s, fields: %" PRIu64, key.c_str(), entry.size());
 
+    const bool pipelined = isAsyncPipelineEnabled(object_type);
+
+    flushAutoBulk();
+
+    if (!pipelined)
+    {
+        waitForAllAsyncResponses();
+    }
+
     m_recorder->recordGenericCreate(key, entry);
 
     m_communicationChannel->set(key, entry, REDIS_ASIC_STATE_COMMAND_CREATE);
 
+    if (pipelined)
+    {
+        // response is recorded when it's collected
+
+        return enqueueAsyncRequest(SAI_COMMON_API_CREATE, key);
+    }
+
     auto status = waitForResponse(SAI_COMMON_API_CREATE);
 
     m_recorder->recordGenericCreateResponse(status);
@@ -676,16 +907,37 @@ sai_status_t RedisRemoteSaiInterface::remove(
 {
     SWSS_LOG_ENTER();
 
+    if (isAutoBulkEnabled(objectType))
+    {
+        return enqueueAutoBulkRequest(SAI_COMMON_API_REMOVE, objectType, serializedObjectId, "");
+    }
+
     auto serializedObjectType = sai_serialize_object_type(objectType);
 
     const std::string key = serializedObjectType + ":" + serializedObjectId;
 
     SWSS_LOG_DEBUG("generic remove key: %s", key.c_str());
 
+    const bool pipelined = isAsyncPipelineEnabled(objectType);
+
+    flushAutoBulk();
+
+    if (!pipelined)
+    {
+        waitForAllAsyncResponses();
+    }
+
     m_recorder->recordGenericRemove(key);
 
     m_communicationChannel->del(key, REDIS_ASIC_STATE_COMMAND_REMOVE);
 
+    if (pipelined)
+    {
+        // response is recorded when it's collected
+
+        return enqueueAsyncRequest(SAI_COMMON_API_REMOVE, key);
+    }
+
     auto status = waitForResponse(SAI_COMMON_API_REMOVE);
 
     m_recorder->recordGenericRemoveResponse(status);
@@ -712,10 +964,26 @@ sai_status_t RedisRemoteSaiInterface::set(
 
     SWSS_LOG_DEBUG("generic set key: %s, fields: %lu", key.c_str(), entry.size());
 
+    const bool pipelined = isAsyncPipelineEnabled(objectType);
+
+    flushAutoBulk();
+
+    if (!pipelined)
+    {
+        waitForAllAsyncResponses();
+    }
+
     m_recorder->recordGenericSet(key, entry);
 
     m_communicationChannel->set(key, entry, REDIS_ASIC_STATE_COMMAND_SET);
 
+    if (pipelined)
+    {
+        // response is recorded when it's collected
+
+        return enqueueAsyncRequest(SAI_COMMON_API_SET, key);
+    }
+
     auto status = waitForResponse(SAI_COMMON_API_SET);
 
     m_recorder->recordGenericSetResponse(status);
@@ -745,6 +1013,334 @@ sai_status_t RedisRemoteSaiInterface::waitForResponse(
     return SAI_STATUS_SUCCESS;
 }
 
+bool RedisRemoteSaiInterface::isAsyncPipelineEnabled(
+        _In_ sai_object_type_t objectType) const
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Switch create and remove must be synchronous since switch container is
+     * updated based on status. Pipeline makes sense only in sync mode, in
+     * async mode there are no responses at all. Zmq REQ socket allows only
+     * single request in flight, so zmq requires DEALER socket.
+     */
+
+    return m_asyncPipelineDepth > 0
+        && m_syncMode
+        && (!m_contextConfig->m_zmqEnable || m_contextConfig->m_zmqPipeline)
+        && objectType != SAI_OBJECT_TYPE_SWITCH;
+}
+
+sai_status_t RedisRemoteSaiInterface::enqueueAsyncRequest(
+        _In_ sai_common_api_t api,
+        _In_ const std::string& key)
+{
+    SWSS_LOG_ENTER();
+
+    auto meta = m_meta.lock();
+
+    m_asyncPending.push_back({ ++m_asyncSequence, api, key, meta != nullptr });
+
+    while (m_asyncPending.size() > m_asyncPipelineDepth)
+    {
+        waitForAsyncResponse();
+    }
+
+    if (meta)
+    {
+        // local database will be updated when actual status arrives
+
+        meta->deferPostCommit();
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void RedisRemoteSaiInterface::waitForAsyncResponse()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_asyncPending.empty())
+    {
+        return;
+    }
+
+    /*
+     * Syncd is processing requests from single channel in order, so responses
+     * are arriving in the same order as requests were sent, and the oldest
+     * pending request is the one matching current response. Sequence is not
+     * sent to syncd, it only identifies request in failure reports.
+     */
+
+    AsyncRequest request = m_asyncPending.front();
+
+    m_asyncPending.pop_front();
+
+    swss::KeyOpFieldsValuesTuple kco;
+
+    auto status = m_communicationChannel->wait(REDIS_ASIC_STATE_COMMAND_GETRESPONSE, kco);
+
+    switch (request.m_api)
+    {
+        case SAI_COMMON_API_CREATE:
+            m_recorder->recordGenericCreateResponse(status);
+            break;
+
+        case SAI_COMMON_API_REMOVE:
+            m_recorder->recordGenericRemoveResponse(status);
+            break;
+
+        case SAI_COMMON_API_SET:
+            m_recorder->recordGenericSetResponse(status);
+            break;
+
+        default:
+            SWSS_LOG_THROW("api %s can't be pipelined", sai_serialize_common_api(request.m_api).c_str());
+    }
+
+    completeMetaCommit(request.m_deferredCommit, status);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        reportAsyncFailure(request.m_sequence, request.m_api, request.m_key, status);
+    }
+}
+
+void RedisRemoteSaiInterface::completeMetaCommit(
+        _In_ bool deferredCommit,
+        _In_ sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    if (!deferredCommit)
+    {
+        return;
+    }
+
+    auto meta = m_meta.lock();
+
+    if (!meta)
+    {
+        SWSS_LOG_WARN("meta pointer expired, can't complete deferred commit");
+
+        return;
+    }
+
+    meta->completeDeferredCommit(status);
+}
+
+void RedisRemoteSaiInterface::reportAsyncFailure(
+        _In_ uint64_t sequence,
+        _In_ sai_common_api_t api,
+        _In_ const std::string& key,
+        _In_ sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_ERROR("async %s (seq %" PRIu64 ") on %s failed: %s",
+            sai_serialize_common_api(api).c_str(),
+            sequence,
+            key.c_str(),
+            sai_serialize_status(status).c_str());
+
+    m_asyncFailures.push_back({ sequence, api, key, status });
+
+    if (m_asyncFailureNotify)
+    {
+        m_asyncFailureNotify(sequence, api, key.c_str(), status);
+    }
+}
+
+void RedisRemoteSaiInterface::waitForAllAsyncResponses()
+{
+    SWSS_LOG_ENTER();
+
+    flushAutoBulk();
+
+    while (m_asyncPending.size())
+    {
+        waitForAsyncResponse();
+    }
+}
+
+sai_status_t RedisRemoteSaiInterface::drainAsyncResponses(
+        _Out_ std::vector<AsyncFailure>& failures)
+{
+    SWSS_LOG_ENTER();
+
+    waitForAllAsyncResponses();
+
+    failures.clear();
+
+    failures.swap(m_asyncFailures);
+
+    if (failures.empty())
+    {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    SWSS_LOG_WARN("%zu pipelined requests failed since last drain", failures.size());
+
+    return failures.front().m_status;
+}
+
+sai_status_t RedisRemoteSaiInterface::setAsyncPipelineDepth(
+        _In_ uint32_t depth)
+{
+    SWSS_LOG_ENTER();
+
+    if (depth && m_contextConfig->m_zmqEnable && !m_contextConfig->m_zmqPipeline)
+    {
+        SWSS_LOG_ERROR("async pipeline in zmq sync mode requires zmq_pipeline in context config");
+
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    if (depth && !m_syncMode)
+    {
+        SWSS_LOG_WARN("async pipeline will only take effect in sync mode");
+    }
+
+    // make sure that new depth applies only to new requests
+
+    waitForAllAsyncResponses();
+
+    m_asyncPipelineDepth = depth;
+
+    SWSS_LOG_NOTICE("set async pipeline depth to %u", depth);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool RedisRemoteSaiInterface::isAutoBulkEnabled(
+        _In_ sai_object_type_t objectType) const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_autoBulkMaxSize <= 1)
+    {
+        return false;
+    }
+
+    switch (objectType)
+    {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+sai_status_t RedisRemoteSaiInterface::enqueueAutoBulkRequest(
+        _In_ sai_common_api_t api,
+        _In_ sai_object_type_t objectType,
+        _In_ const std::string& serializedObjectId,
+        _In_ const std::string& serializedAttributes)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_autoBulkEntries.size())
+    {
+        auto age = std::chrono::steady_clock::now() - m_autoBulkStart;
+
+        if (m_autoBulkApi != api
+                || m_autoBulkObjectType != objectType
+                || m_autoBulkEntries.size() >= m_autoBulkMaxSize
+                || (m_autoBulkMaxDelayUs && age >= std::chrono::microseconds(m_autoBulkMaxDelayUs)))
+        {
+            flushAutoBulk();
+        }
+    }
+
+    if (m_autoBulkEntries.empty())
+    {
+        m_autoBulkApi = api;
+        m_autoBulkObjectType = objectType;
+        m_autoBulkStart = std::chrono::steady_clock::now();
+    }
+
+    auto serializedObjectType = sai_serialize_object_type(objectType);
+
+    auto meta = m_meta.lock();
+
+    m_autoBulkEntries.emplace_back(serializedObjectId, serializedAttributes);
+
+    m_autoBulkRequests.push_back({ ++m_asyncSequence, api, serializedObjectType + ":" + serializedObjectId, meta != nullptr });
+
+    if (meta)
+    {
+        // local database will be updated when bulk status arrives
+
+        meta->deferPostCommit();
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void RedisRemoteSaiInterface::flushAutoBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_autoBulkEntries.empty())
+    {
+        return;
+    }
+
+    // swap buffer out first, since sending bulk will call flush again
+
+    std::vector<swss::FieldValueTuple> entries;
+    std::vector<AsyncRequest> requests;
+
+    entries.swap(m_autoBulkEntries);
+    requests.swap(m_autoBulkRequests);
+
+    auto serializedObjectType = sai_serialize_object_type(m_autoBulkObjectType);
+
+    auto bulkApi = (m_autoBulkApi == SAI_COMMON_API_CREATE)
+        ? SAI_COMMON_API_BULK_CREATE
+        : SAI_COMMON_API_BULK_REMOVE;
+
+    SWSS_LOG_DEBUG("auto bulk %s %zu entries of %s",
+            sai_serialize_common_api(bulkApi).c_str(),
+            entries.size(),
+            serializedObjectType.c_str());
+
+    std::vector<sai_status_t> statuses(entries.size());
+
+    sendBulkRequest(bulkApi, serializedObjectType, entries, statuses.data());
+
+    for (size_t idx = 0; idx < entries.size(); idx++)
+    {
+        const auto& request = requests[idx];
+
+        completeMetaCommit(request.m_deferredCommit, statuses[idx]);
+
+        if (statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            reportAsyncFailure(request.m_sequence, request.m_api, request.m_key, statuses[idx]);
+        }
+    }
+}
+
+sai_status_t RedisRemoteSaiInterface::setAutoBulkMaxSize(
+        _In_ uint32_t maxSize)
+{
+    SWSS_LOG_ENTER();
+
+    // make sure that new size applies only to new requests
+
+    flushAutoBulk();
+
+    m_autoBulkMaxSize = maxSize;
+
+    SWSS_LOG_NOTICE("set auto bulk max size to %u", maxSize);
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t RedisRemoteSaiInterface::waitForGetResponse(
         _In_ sai_object_type_t objectType,
         _In_ uint32_t attr_count,
@@ -816,6 +1412,8 @@ sai_status_t RedisRemoteSaiInterface::get(
         m_recorder->recordGenericGet(key, entry);
     }
 
+    waitForAllAsyncResponses();
+
     // get is special, it will not put data
     // into asic view, only to message queue
     m_communicationChannel->set(key, entry, REDIS_ASIC_STATE_COMMAND_GET);
@@ -884,6 +1482,8 @@ sai_status_t RedisRemoteSaiInterface::flushFdbEntries(
 
     SWSS_LOG_NOTICE("flush key: %s, fields: %lu", key.c_str(), entry.size());
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordFlushFdbEntries(switchId, attrCount, attrList);
    // TODO m_recorder->recordFlushFdbEntries(key, entry)
 
@@ -918,6 +1518,8 @@ sai_status_t RedisRemoteSaiInterface::objectTypeGetAvailability(
 
     // Syncd will pop this argument off before trying to deserialize the attribute list
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordObjectTypeGetAvailability(switchId, objectType, attrCount, attrList);
     // recordObjectTypeGetAvailability(strSwitchId, entry);
 
@@ -997,6 +1599,8 @@ sai_status_t RedisRemoteSaiInterface::queryAttributeCapability(
     // This query will not put any data into the ASIC view, just into the
     // message queue
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordQueryAttributeCapability(switchId, objectType, attrId, capability);
 
     m_communicationChannel->set(switchIdStr, entry, REDIS_ASIC_STATE_COMMAND_ATTR_CAPABILITY_QUERY);
@@ -1086,6 +1690,8 @@ sai_status_t RedisRemoteSaiInterface::queryAattributeEnumValuesCapability(
     // This query will not put any data into the ASIC view, just into the
     // message queue
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordQueryAattributeEnumValuesCapability(switchId, objectType, attrId, enumValuesCapability);
 
     m_communicationChannel->set(switch_id_str, entry, REDIS_ASIC_STATE_COMMAND_ATTR_ENUM_VALUES_CAPABILITY_QUERY);
@@ -1178,6 +1784,8 @@ sai_status_t RedisRemoteSaiInterface::getStats(
 
     // get_stats will not put data to asic view, only to message queue
 
+    waitForAllAsyncResponses();
+
     m_communicationChannel->set(key, entry, REDIS_ASIC_STATE_COMMAND_GET_STATS);
 
     return waitForGetStatsResponse(number_of_counters, counters);
@@ -1248,6 +1856,8 @@ sai_status_t RedisRemoteSaiInterface::clearStats(
 
     // clear_stats will not put data into asic view, only to message queue
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordGenericClearStats(object_type, object_id, number_of_counters, counter_ids);
 
     m_communicationChannel->set(key, values, REDIS_ASIC_STATE_COMMAND_CLEAR_STATS);
@@ -1270,6 +1880,111 @@ sai_status_t RedisRemoteSaiInterface::waitForClearStatsResponse()
     return status;
 }
 
+sai_status_t RedisRemoteSaiInterface::bulkGetStats(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    auto stats_enum = sai_metadata_get_object_type_info(object_type)->statenum;
+
+    auto counterIds = serialize_counter_id_list(stats_enum, number_of_counters, counter_ids);
+
+    auto key = sai_serialize_object_type(object_type) + ":" + sai_serialize_object_id(switchId);
+
+    // field = stats mode, value = object count, followed by object ids and
+    // counter ids shared by all objects
+
+    std::vector<swss::FieldValueTuple> entries;
+
+    entries.reserve(1 + object_count + counterIds.size());
+
+    entries.emplace_back(
+            sai_serialize_enum(mode, &sai_metadata_enum_sai_stats_mode_t),
+            sai_serialize_number(object_count));
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        entries.emplace_back(sai_serialize_object_id(object_key[idx].key.object_id), "");
+    }
+
+    entries.insert(entries.end(), counterIds.begin(), counterIds.end());
+
+    SWSS_LOG_DEBUG("bulk get stats key: %s, objects: %u, counters: %u", key.c_str(), object_count, number_of_counters);
+
+    // bulk_get_stats will not put data to asic view, only to message queue
+
+    waitForAllAsyncResponses();
+
+    m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_GET_STATS);
+
+    return waitForBulkGetStatsResponse(object_count, number_of_counters, object_statuses, counters);
+}
+
+sai_status_t RedisRemoteSaiInterface::waitForBulkGetStatsResponse(
+        _In_ uint32_t object_count,
+        _In_ uint32_t number_of_counters,
+        _Out_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    swss::KeyOpFieldsValuesTuple kco;
+
+    auto status = m_communicationChannel->wait(REDIS_ASIC_STATE_COMMAND_GETRESPONSE, kco);
+
+    auto &values = kfvFieldsValues(kco);
+
+    if (values.size() != object_count)
+    {
+        // syncd failed before executing any object
+
+        for (uint32_t idx = 0; idx < object_count; idx++)
+        {
+            object_statuses[idx] = status;
+        }
+
+        return status;
+    }
+
+    // field = object status, value = comma separated counters
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        sai_deserialize_status(fvField(values[idx]), object_statuses[idx]);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        const char* ptr = fvValue(values[idx]).c_str();
+
+        for (uint32_t c = 0; c < number_of_counters; c++)
+        {
+            char* end = nullptr;
+
+            counters[(size_t)idx * number_of_counters + c] = strtoull(ptr, &end, 10);
+
+            if (end == ptr || (*end != ',' && *end != 0))
+            {
+                SWSS_LOG_THROW("wrong counters for object %u: '%s', expected %u", idx, fvValue(values[idx]).c_str(), number_of_counters);
+            }
+
+            ptr = (*end == ',') ? end + 1 : end;
+        }
+    }
+
+    return status;
+}
+
 sai_status_t RedisRemoteSaiInterface::bulkRemove(
         _In_ sai_object_type_t object_type,
         _In_ const std::vector<std::string> &serialized_object_ids,
@@ -1295,6 +2010,17 @@ sai_status_t RedisRemoteSaiInterface::bulkRemove(
         entries.push_back(fvtNoStatus);
     }
 
+    return sendBulkRequest(SAI_COMMON_API_BULK_REMOVE, serializedObjectType, entries, object_statuses);
+}
+
+sai_status_t RedisRemoteSaiInterface::sendBulkRequest(
+        _In_ sai_common_api_t api,
+        _In_ const std::string& serializedObjectType,
+        _In_ const std::vector<swss::FieldValueTuple>& entries,
+        _Out_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
     /*
      * We are adding number of entries to actually add ':' to be compatible
      * with previous
@@ -1305,11 +2031,39 @@ sai_status_t RedisRemoteSaiInterface::bulkRemove(
     // value:       object_attrs
     std::string key = serializedObjectType + ":" + std::to_string(entries.size());
 
-    m_recorder->recordBulkGenericRemove(serializedObjectType, entries);
+    waitForAllAsyncResponses();
+
+    switch (api)
+    {
+        case SAI_COMMON_API_BULK_CREATE:
+
+            m_recorder->recordBulkGenericCreate(serializedObjectType, entries);
 
-    m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_REMOVE);
+            m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_CREATE);
+
+            break;
+
+        case SAI_COMMON_API_BULK_REMOVE:
+
+            m_recorder->recordBulkGenericRemove(serializedObjectType, entries);
+
+            m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_REMOVE);
+
+            break;
+
+        case SAI_COMMON_API_BULK_SET:
+
+            m_recorder->recordBulkGenericSet(serializedObjectType, entries);
+
+            m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_SET);
+
+            break;
+
+        default:
+            SWSS_LOG_THROW("api %s is not supported in bulk", sai_serialize_common_api(api).c_str());
+    }
 
-    return waitForBulkResponse(SAI_COMMON_API_BULK_REMOVE, (uint32_t)serialized_object_ids.size(), object_statuses);
+    return waitForBulkResponse(api, (uint32_t)entries.size(), object_statuses);
 }
 
 sai_status_t RedisRemoteSaiInterface::waitForBulkResponse(
@@ -1369,6 +2123,8 @@ sai_status_t RedisRemoteSaiInterface::bulkRemove(
     for (uint32_t idx = 0; idx < object_count; idx++)
     {
         serializedObjectIds.emplace_back(sai_serialize_object_id(object_id[idx]));
+
+        m_attributeCache->removeObject(object_id[idx]);
     }
 
     return bulkRemove(object_type, serializedObjectIds, mode, object_statuses);
@@ -1566,20 +2322,9 @@ sai_status_t RedisRemoteSaiInterface::bulkSet(
         entries.push_back(value);
     }
 
-    /*
-     * We are adding number of entries to actually add ':' to be compatible
-     * with previous
-     */
-
     auto serializedObjectType = sai_serialize_object_type(object_type);
 
-    std::string key = serializedObjectType + ":" + std::to_string(entries.size());
-
-    m_recorder->recordBulkGenericSet(serializedObjectType, entries);
-
-    m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_SET);
-
-    return waitForBulkResponse(SAI_COMMON_API_BULK_SET, (uint32_t)serialized_object_ids.size(), object_statuses);
+    return sendBulkRequest(SAI_COMMON_API_BULK_SET, serializedObjectType, entries, object_statuses);
 }
 
 sai_status_t RedisRemoteSaiInterface::bulkCreate(
@@ -1664,21 +2409,7 @@ sai_status_t RedisRemoteSaiInterface::bulkCreate(
         entries.push_back(fvtNoStatus);
     }
 
-    /*
-     * We are adding number of entries to actually add ':' to be compatible
-     * with previous
-     */
-
-    // key:         object_type:count
-    // field:       object_id
-    // value:       object_attrs
-    std::string key = str_object_type + ":" + std::to_string(entries.size());
-
-    m_recorder->recordBulkGenericCreate(str_object_type, entries);
-
-    m_communicationChannel->set(key, entries, REDIS_ASIC_STATE_COMMAND_BULK_CREATE);
-
-    return waitForBulkResponse(SAI_COMMON_API_BULK_CREATE, (uint32_t)serialized_object_ids.size(), object_statuses);
+    return sendBulkRequest(SAI_COMMON_API_BULK_CREATE, str_object_type, entries, object_statuses);
 }
 
 sai_status_t RedisRemoteSaiInterface::bulkCreate(
@@ -1843,6 +2574,8 @@ sai_status_t RedisRemoteSaiInterface::notifySyncd(
     // and then on syncd side read all the asic state queue
     // and apply changes before switching to init/apply mode
 
+    waitForAllAsyncResponses();
+
     m_recorder->recordNotifySyncd(switchId, redisNotifySyncd);
 
     m_communicationChannel->set(key, entry, REDIS_ASIC_STATE_COMMAND_NOTIFY);
@@ -2014,6 +2747,11 @@ void RedisRemoteSaiInterface::clear_local_state()
     // will clear switch container
     m_switchContainer = std::make_shared<SwitchContainer>();
 
+    if (m_attributeCache)
+    {
+        m_attributeCache->clear();
+    }
+
     m_virtualObjectIdManager = 
         std::make_shared<VirtualObjectIdManager>(
                 m_contextConfig->m_guid,
@@ -2034,6 +2772,15 @@ void RedisRemoteSaiInterface::setMeta(
     SWSS_LOG_ENTER();
 
     m_meta = meta;
+
+    auto ptr = meta.lock();
+
+    if (ptr)
+    {
+        // meta validation needs actual state of objects changed by pipelined requests
+
+        ptr->setDeferredCommitFlush(std::bind(&RedisRemoteSaiInterface::waitForAllAsyncResponses, this));
+    }
 }
 
 sai_switch_notifications_t RedisRemoteSaiInterface::syncProcessNotification(
@@ -1,31 +1,89 @@
 #include "RedisVidIndexGenerator.h"
 
 #include "swss/logger.h"
+#include "swss/redisreply.h"
+
+#include <cinttypes>
 
 using namespace sairedis;
 
 RedisVidIndexGenerator::RedisVidIndexGenerator(
         _In_ std::shared_ptr<swss::DBConnector> dbConnector,
-        _In_ const std::string& vidCounterName):
+        _In_ const std::string& vidCounterName,
+        _In_ uint64_t blockSize):
     m_dbConnector(dbConnector),
-    m_vidCounterName(vidCounterName)
+    m_vidCounterName(vidCounterName),
+    m_blockSize(blockSize),
+    m_next(1),
+    m_last(0)
 {
     SWSS_LOG_ENTER();
+
+    if (m_blockSize == 0)
+    {
+        SWSS_LOG_THROW("block size must be greater than 0");
+    }
 }
 
 uint64_t RedisVidIndexGenerator::increment()
 {
     SWSS_LOG_ENTER();
 
-    // this counter must be atomic since it can be independently accessed by
-    // sairedis and syncd
+    if (m_blockSize == 1)
+    {
+        // this counter must be atomic since it can be independently accessed by
+        // sairedis and syncd
+
+        return m_dbConnector->incr(m_vidCounterName); // "VIDCOUNTER"
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_next > m_last)
+    {
+        reserveBlock();
+    }
+
+    return m_next++;
+}
+
+void RedisVidIndexGenerator::reserveBlock()
+{
+    SWSS_LOG_ENTER();
+
+    // INCRBY is atomic, so sairedis and syncd will get disjoint ranges
+
+    swss::RedisCommand command;
+
+    command.format("INCRBY %s %" PRIu64, m_vidCounterName.c_str(), m_blockSize);
+
+    swss::RedisReply r(m_dbConnector.get(), command, REDIS_REPLY_INTEGER);
 
-    return m_dbConnector->incr(m_vidCounterName); // "VIDCOUNTER"
+    uint64_t last = (uint64_t)r.getContext()->integer;
+
+    if (last < m_blockSize)
+    {
+        SWSS_LOG_THROW("%s value %" PRIu64 " is lower than block size %" PRIu64,
+                m_vidCounterName.c_str(),
+                last,
+                m_blockSize);
+    }
+
+    m_next = last - m_blockSize + 1;
+    m_last = last;
+
+    SWSS_LOG_INFO("reserved %s range %" PRIu64 "-%" PRIu64,
+            m_vidCounterName.c_str(),
+            m_next,
+            m_last);
 }
 
 void RedisVidIndexGenerator::reset()
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_ERROR("not implemented");
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_next = 1;
+    m_last = 0;
 }
@@ -250,6 +250,31 @@ sai_status_t Sai::get(
     MUTEX();
     SWSS_LOG_ENTER();
     REDIS_CHECK_API_INITIALIZED();
+
+    if (attr_count == 1 && RedisRemoteSaiInterface::isRedisAttribute(objectType, attr_list))
+    {
+        // skip metadata if attribute is redis extension attribute, readable
+        // extension attributes are counters, so sum them from all contexts
+
+        uint64_t total = 0;
+
+        for (auto& kvp: m_contextMap)
+        {
+            sai_status_t status = kvp.second->m_redisSai->get(objectType, objectId, attr_count, attr_list);
+
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                return status;
+            }
+
+            total += attr_list->value.u64;
+        }
+
+        attr_list->value.u64 = total;
+
+        return SAI_STATUS_SUCCESS;
+    }
+
     REDIS_CHECK_CONTEXT(objectId);
 
     return context->m_meta->get(
@@ -409,6 +434,34 @@ sai_status_t Sai::clearStats(
             counter_ids);
 }
 
+sai_status_t Sai::bulkGetStats(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    MUTEX();
+    SWSS_LOG_ENTER();
+    REDIS_CHECK_API_INITIALIZED();
+    REDIS_CHECK_CONTEXT(switchId);
+
+    return context->m_meta->bulkGetStats(
+            switchId,
+            object_type,
+            object_count,
+            object_key,
+            number_of_counters,
+            counter_ids,
+            mode,
+            object_statuses,
+            counters);
+}
+
 // BULK QUAD OID
 
 sai_status_t Sai::bulkCreate(
@@ -0,0 +1,205 @@
+#include "ShmChannel.h"
+#include "ZeroMQMessageCodec.h"
+
+#include "sairediscommon.h"
+
+#include "meta/sai_serialize.h"
+
+#include "swss/logger.h"
+
+#include <cstring>
+
+#include <poll.h>
+
+using namespace sairedis;
+
+ShmChannel::ShmChannel(
+        _In_ const std::string& endpoint,
+        _In_ Channel::Callback callback):
+    Channel(callback),
+    m_endpoint(endpoint)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("opening shm endpoint: %s", endpoint.c_str());
+
+    m_transport = std::make_shared<ShmTransport>(endpoint, ShmTransport::ROLE_CLIENT);
+
+    // start thread
+
+    m_runNotificationThread = true;
+
+    SWSS_LOG_NOTICE("creating notification thread");
+
+    m_notificationThread = std::make_shared<std::thread>(&ShmChannel::notificationThreadFunction, this);
+}
+
+ShmChannel::~ShmChannel()
+{
+    SWSS_LOG_ENTER();
+
+    m_runNotificationThread = false;
+
+    // notify thread that it should end
+    m_notificationThreadShouldEndEvent.notify();
+
+    SWSS_LOG_NOTICE("join ntf thread begin");
+
+    m_notificationThread->join();
+
+    SWSS_LOG_NOTICE("join ntf thread end");
+}
+
+void ShmChannel::notificationThreadFunction()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("start listening for notifications");
+
+    auto& ring = m_transport->getRing(ShmTransport::RING_NOTIFICATION);
+
+    while (m_runNotificationThread)
+    {
+        size_t size;
+
+        const uint8_t* data = ring.front(size);
+
+        if (data)
+        {
+            swss::KeyOpFieldsValuesTuple kco;
+
+            ZeroMQMessageCodec::decode(data, size, kco);
+
+            ring.pop();
+
+            const std::string& op = kfvKey(kco);
+            const std::string& ntfData = kfvOp(kco);
+
+            SWSS_LOG_DEBUG("notification: op = %s, data = %s", op.c_str(), ntfData.c_str());
+
+            m_callback(op, ntfData, kfvFieldsValues(kco));
+
+            continue;
+        }
+
+        if (!ring.arm())
+        {
+            continue;
+        }
+
+        struct pollfd pfd[2] = {
+            { ring.getEventFd(), POLLIN, 0 },
+            { m_notificationThreadShouldEndEvent.getFd(), POLLIN, 0 } };
+
+        int rc = poll(pfd, 2, -1);
+
+        ring.disarm();
+
+        if (rc < 0 && errno != EINTR)
+        {
+            SWSS_LOG_ERROR("poll failed: %s", strerror(errno));
+            break;
+        }
+
+        ring.clearDoorbell();
+    }
+
+    SWSS_LOG_NOTICE("exiting notification thread");
+}
+
+void ShmChannel::setBuffered(
+        _In_ bool buffered)
+{
+    SWSS_LOG_ENTER();
+
+    // not supported
+}
+
+void ShmChannel::flush()
+{
+    SWSS_LOG_ENTER();
+
+    // not supported
+}
+
+void ShmChannel::set(
+        _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& values,
+        _In_ const std::string& command)
+{
+    SWSS_LOG_ENTER();
+
+    ZeroMQMessageCodec::encode(ZeroMQMessageCodec::CODEC_BINARY, key, command, values, m_sendBuffer);
+
+    SWSS_LOG_DEBUG("sending: %s %s, %zu bytes", command.c_str(), key.c_str(), m_sendBuffer.size());
+
+    auto& ring = m_transport->getRing(ShmTransport::RING_REQUEST);
+
+    if (!ring.push(m_sendBuffer.data(), m_sendBuffer.size(), m_responseTimeoutMs))
+    {
+        SWSS_LOG_THROW("request ring full on shm endpoint %s, syncd is not responding", m_endpoint.c_str());
+    }
+}
+
+void ShmChannel::del(
+        _In_ const std::string& key,
+        _In_ const std::string& command)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<swss::FieldValueTuple> values;
+
+    set(key, values, command);
+}
+
+sai_status_t ShmChannel::wait(
+        _In_ const std::string& command,
+        _Out_ swss::KeyOpFieldsValuesTuple& kco)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_INFO("wait for %s response", command.c_str());
+
+    auto& ring = m_transport->getRing(ShmTransport::RING_RESPONSE);
+
+    const uint8_t* data = nullptr;
+
+    size_t size = 0;
+
+    while (data == nullptr)
+    {
+        if (!ring.wait(m_responseTimeoutMs))
+        {
+            SWSS_LOG_ERROR("shm response timed out for: %s", command.c_str());
+
+            return SAI_STATUS_FAILURE;
+        }
+
+        // ring may only contain wrap marker, then front will be empty
+
+        data = ring.front(size);
+    }
+
+    ZeroMQMessageCodec::decode(data, size, kco);
+
+    ring.pop();
+
+    const std::string& opkey = kfvKey(kco);
+    const std::string& op = kfvOp(kco);
+
+    SWSS_LOG_INFO("response: op = %s, key = %s", opkey.c_str(), op.c_str());
+
+    if (op != command)
+    {
+        // we can hit this place if there were some timeouts
+
+        SWSS_LOG_THROW("got not expected response: %s:%s, expected: %s", opkey.c_str(), op.c_str(), command.c_str());
+    }
+
+    sai_status_t status;
+    sai_deserialize_status(opkey, status);
+
+    SWSS_LOG_DEBUG("%s status: %s", command.c_str(), opkey.c_str());
+
+    return status;
+}
@@ -0,0 +1,322 @@
+#include "ShmRing.h"
+
+#include "swss/logger.h"
+
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include <poll.h>
+#include <unistd.h>
+
+using namespace sairedis;
+
+#define SHM_RING_WRAP_MARKER    (0xFFFFFFFF)
+#define SHM_RING_SPIN_COUNT     (256)
+#define SHM_RING_FULL_SLEEP_US  (10)
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "ring requires lock free 64 bit atomics to be shared between processes");
+
+static inline size_t align8(
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    return (size + 7) & ~(size_t)7;
+}
+
+ShmRing::ShmRing(
+        _In_ void* memory,
+        _In_ size_t capacity,
+        _In_ int eventFd):
+    m_header((Header*)memory),
+    m_data((uint8_t*)memory + sizeof(Header)),
+    m_capacity(capacity),
+    m_eventFd(eventFd),
+    m_frontSize(0)
+{
+    SWSS_LOG_ENTER();
+
+    if (capacity < 64 || (capacity & (capacity - 1)))
+    {
+        SWSS_LOG_THROW("ring capacity %zu must be power of 2", capacity);
+    }
+}
+
+size_t ShmRing::getRequiredSize(
+        _In_ size_t capacity)
+{
+    SWSS_LOG_ENTER();
+
+    return sizeof(Header) + capacity;
+}
+
+size_t ShmRing::getMaxRecordSize() const
+{
+    SWSS_LOG_ENTER();
+
+    // half of capacity guarantees that record will fit into empty ring
+    // regardless of current offset
+
+    return m_capacity / 2 - sizeof(uint32_t);
+}
+
+int ShmRing::getEventFd() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_eventFd;
+}
+
+void ShmRing::reset()
+{
+    SWSS_LOG_ENTER();
+
+    m_header->m_head = 0;
+    m_header->m_tail = 0;
+    m_header->m_waiting = 0;
+
+    m_frontSize = 0;
+}
+
+bool ShmRing::empty() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_header->m_head.load() == m_header->m_tail.load();
+}
+
+bool ShmRing::tryPush(
+        _In_ const void* data,
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    size_t total = align8(sizeof(uint32_t) + size);
+
+    uint64_t tail = m_header->m_tail.load(std::memory_order_relaxed);
+    uint64_t head = m_header->m_head.load(std::memory_order_acquire);
+
+    size_t offset = (size_t)(tail & (m_capacity - 1));
+    size_t contiguous = m_capacity - offset;
+    size_t skip = (total > contiguous) ? contiguous : 0;
+
+    if (skip + total > m_capacity - (size_t)(tail - head))
+    {
+        return false;
+    }
+
+    if (skip)
+    {
+        uint32_t marker = SHM_RING_WRAP_MARKER;
+
+        memcpy(m_data + offset, &marker, sizeof(marker));
+
+        tail += skip;
+        offset = 0;
+    }
+
+    uint32_t len = (uint32_t)size;
+
+    memcpy(m_data + offset, &len, sizeof(len));
+    memcpy(m_data + offset + sizeof(len), data, size);
+
+    // store and load must be sequentially consistent, paired with arm(),
+    // otherwise we could miss sleeping consumer
+
+    m_header->m_tail.store(tail + total);
+
+    if (m_header->m_waiting.load() && m_header->m_waiting.exchange(0))
+    {
+        uint64_t one = 1;
+
+        if (write(m_eventFd, &one, sizeof(one)) != sizeof(one))
+        {
+            SWSS_LOG_ERROR("failed to ring doorbell: %s", strerror(errno));
+        }
+    }
+
+    return true;
+}
+
+bool ShmRing::push(
+        _In_ const void* data,
+        _In_ size_t size,
+        _In_ uint64_t timeoutMs)
+{
+    SWSS_LOG_ENTER();
+
+    if (size > getMaxRecordSize())
+    {
+        SWSS_LOG_THROW("record size %zu exceeds ring max record size %zu", size, getMaxRecordSize());
+    }
+
+    if (tryPush(data, size))
+    {
+        return true;
+    }
+
+    // ring is full, consumer is not keeping up
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        usleep(SHM_RING_FULL_SLEEP_US);
+
+        if (tryPush(data, size))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const uint8_t* ShmRing::front(
+        _Out_ size_t& size)
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t head = m_header->m_head.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        uint64_t tail = m_header->m_tail.load(std::memory_order_acquire);
+
+        if (head == tail)
+        {
+            return nullptr;
+        }
+
+        size_t offset = (size_t)(head & (m_capacity - 1));
+
+        uint32_t len;
+
+        memcpy(&len, m_data + offset, sizeof(len));
+
+        if (len == SHM_RING_WRAP_MARKER)
+        {
+            head += m_capacity - offset;
+
+            m_header->m_head.store(head, std::memory_order_release);
+
+            continue;
+        }
+
+        size = len;
+
+        m_frontSize = align8(sizeof(len) + len);
+
+        return m_data + offset + sizeof(len);
+    }
+}
+
+void ShmRing::pop()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_frontSize == 0)
+    {
+        SWSS_LOG_THROW("pop called without front");
+    }
+
+    uint64_t head = m_header->m_head.load(std::memory_order_relaxed);
+
+    m_header->m_head.store(head + m_frontSize, std::memory_order_release);
+
+    m_frontSize = 0;
+}
+
+bool ShmRing::arm()
+{
+    SWSS_LOG_ENTER();
+
+    m_header->m_waiting.store(1);
+
+    if (empty())
+    {
+        return true;
+    }
+
+    m_header->m_waiting.store(0);
+
+    return false;
+}
+
+void ShmRing::disarm()
+{
+    SWSS_LOG_ENTER();
+
+    m_header->m_waiting.store(0);
+}
+
+void ShmRing::clearDoorbell()
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t value;
+
+    // eventfd is non blocking, so EAGAIN is expected when doorbell was not rung
+
+    if (read(m_eventFd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    {
+        SWSS_LOG_ERROR("failed to clear doorbell: %s", strerror(errno));
+    }
+}
+
+bool ShmRing::wait(
+        _In_ uint64_t timeoutMs)
+{
+    SWSS_LOG_ENTER();
+
+    // response is usually ready quickly, so spin a bit before going to sleep
+
+    for (int i = 0; i < SHM_RING_SPIN_COUNT; i++)
+    {
+        if (!empty())
+        {
+            return true;
+        }
+
+        std::this_thread::yield();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (true)
+    {
+        if (!arm())
+        {
+            return true;
+        }
+
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+        struct pollfd pfd = { m_eventFd, POLLIN, 0 };
+
+        int rc = poll(&pfd, 1, (int)std::max<int64_t>(0, left.count()));
+
+        if (rc < 0 && errno != EINTR)
+        {
+            SWSS_LOG_THROW("poll on doorbell failed: %s", strerror(errno));
+        }
+
+        clearDoorbell();
+
+        if (!empty())
+        {
+            disarm();
+
+            return true;
+        }
+
+        if (rc == 0)
+        {
+            disarm();
+
+            return false;
+        }
+    }
+}
@@ -0,0 +1,535 @@
+#include "ShmTransport.h"
+
+#include "swss/logger.h"
+
+#include <cstring>
+#include <chrono>
+#include <cinttypes>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/eventfd.h>
+
+using namespace sairedis;
+
+#define SHM_TRANSPORT_MAGIC             (0x53484d52) // "SHMR"
+#define SHM_TRANSPORT_VERSION           (1)
+#define SHM_TRANSPORT_HEADER_SIZE       (64)
+#define SHM_TRANSPORT_CONNECT_TIMEOUT   (10*1000)
+#define SHM_TRANSPORT_DEFAULT_CAPACITY  (8*1024*1024)
+#define SHM_TRANSPORT_SOCKET_MODE       (0600)
+
+#define SHM_TRANSPORT_ACCEPTED          'S'
+#define SHM_TRANSPORT_BUSY              'B'
+
+typedef struct _ShmTransportHeader
+{
+    uint32_t m_magic;
+
+    uint32_t m_version;
+
+    uint64_t m_ringCapacity;
+
+} ShmTransportHeader;
+
+static_assert(sizeof(ShmTransportHeader) <= SHM_TRANSPORT_HEADER_SIZE, "header too big");
+
+static size_t roundUpPowerOf2(
+        _In_ size_t value)
+{
+    SWSS_LOG_ENTER();
+
+    size_t result = 64;
+
+    while (result < value)
+    {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+ShmTransport::ShmTransport(
+        _In_ const std::string& endpoint,
+        _In_ Role role,
+        _In_ size_t ringCapacity):
+    m_endpoint(endpoint),
+    m_role(role),
+    m_memFd(-1),
+    m_memory(nullptr),
+    m_size(0),
+    m_listenFd(-1),
+    m_stopFd(-1),
+    m_clientFd(-1),
+    m_clientConnected(false)
+{
+    SWSS_LOG_ENTER();
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        m_eventFds[idx] = -1;
+    }
+
+    if (endpoint.size() >= sizeof(((struct sockaddr_un*)nullptr)->sun_path))
+    {
+        SWSS_LOG_THROW("shm endpoint path too long: %s", endpoint.c_str());
+    }
+
+    if (role == ROLE_SERVER)
+    {
+        createServer(ringCapacity ? ringCapacity : SHM_TRANSPORT_DEFAULT_CAPACITY);
+    }
+    else
+    {
+        connectClient();
+    }
+}
+
+ShmTransport::~ShmTransport()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_acceptThread)
+    {
+        uint64_t one = 1;
+
+        if (write(m_stopFd, &one, sizeof(one)) != sizeof(one))
+        {
+            SWSS_LOG_ERROR("failed to notify accept thread: %s", strerror(errno));
+        }
+
+        m_acceptThread->join();
+    }
+
+    if (m_listenFd >= 0)
+    {
+        close(m_listenFd);
+
+        unlink(m_endpoint.c_str());
+    }
+
+    if (m_stopFd >= 0)
+    {
+        close(m_stopFd);
+    }
+
+    if (m_clientFd >= 0)
+    {
+        close(m_clientFd);
+    }
+
+    if (m_memory)
+    {
+        munmap(m_memory, m_size);
+    }
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        if (m_eventFds[idx] >= 0)
+        {
+            close(m_eventFds[idx]);
+        }
+    }
+
+    if (m_memFd >= 0)
+    {
+        close(m_memFd);
+    }
+}
+
+ShmRing& ShmTransport::getRing(
+        _In_ RingType type)
+{
+    SWSS_LOG_ENTER();
+
+    if (type < 0 || type >= RING_MAX)
+    {
+        SWSS_LOG_THROW("invalid ring type %d", type);
+    }
+
+    return *m_rings[type];
+}
+
+void ShmTransport::mapMemory(
+        _In_ size_t size)
+{
+    SWSS_LOG_ENTER();
+
+    m_size = size;
+
+    m_memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_memFd, 0);
+
+    if (m_memory == MAP_FAILED)
+    {
+        m_memory = nullptr;
+
+        SWSS_LOG_THROW("failed to map %zu bytes of shared memory: %s", size, strerror(errno));
+    }
+
+    auto* header = (ShmTransportHeader*)m_memory;
+
+    size_t capacity = (size_t)header->m_ringCapacity;
+
+    uint8_t* ptr = (uint8_t*)m_memory + SHM_TRANSPORT_HEADER_SIZE;
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        m_rings[idx] = std::make_shared<ShmRing>(ptr, capacity, m_eventFds[idx]);
+
+        ptr += ShmRing::getRequiredSize(capacity);
+    }
+}
+
+void ShmTransport::createServer(
+        _In_ size_t ringCapacity)
+{
+    SWSS_LOG_ENTER();
+
+    size_t capacity = roundUpPowerOf2(ringCapacity);
+
+    size_t size = SHM_TRANSPORT_HEADER_SIZE + RING_MAX * ShmRing::getRequiredSize(capacity);
+
+    m_memFd = memfd_create("sairedis_shm", MFD_CLOEXEC);
+
+    if (m_memFd < 0)
+    {
+        SWSS_LOG_THROW("memfd_create failed: %s", strerror(errno));
+    }
+
+    if (ftruncate(m_memFd, (off_t)size) != 0)
+    {
+        SWSS_LOG_THROW("failed to resize shared memory to %zu bytes: %s", size, strerror(errno));
+    }
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        m_eventFds[idx] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (m_eventFds[idx] < 0)
+        {
+            SWSS_LOG_THROW("eventfd failed: %s", strerror(errno));
+        }
+    }
+
+    // memfd is zero filled, set header before mapping rings
+
+    ShmTransportHeader header = { SHM_TRANSPORT_MAGIC, SHM_TRANSPORT_VERSION, capacity };
+
+    if (pwrite(m_memFd, &header, sizeof(header), 0) != sizeof(header))
+    {
+        SWSS_LOG_THROW("failed to write shared memory header: %s", strerror(errno));
+    }
+
+    mapMemory(size);
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        m_rings[idx]->reset();
+    }
+
+    m_listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (m_listenFd < 0)
+    {
+        SWSS_LOG_THROW("failed to create unix socket: %s", strerror(errno));
+    }
+
+    struct sockaddr_un addr = { };
+
+    addr.sun_family = AF_UNIX;
+
+    strncpy(addr.sun_path, m_endpoint.c_str(), sizeof(addr.sun_path) - 1);
+
+    unlink(m_endpoint.c_str());
+
+    if (bind(m_listenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        SWSS_LOG_THROW("failed to bind shm endpoint %s: %s", m_endpoint.c_str(), strerror(errno));
+    }
+
+    // whoever connects gets full access to shared memory, restrict socket
+    // before listen, so there is no window when others could connect
+
+    if (chmod(m_endpoint.c_str(), SHM_TRANSPORT_SOCKET_MODE) != 0)
+    {
+        SWSS_LOG_THROW("failed to set mode of shm endpoint %s: %s", m_endpoint.c_str(), strerror(errno));
+    }
+
+    if (listen(m_listenFd, 1) != 0)
+    {
+        SWSS_LOG_THROW("failed to listen on shm endpoint %s: %s", m_endpoint.c_str(), strerror(errno));
+    }
+
+    m_stopFd = eventfd(0, EFD_CLOEXEC);
+
+    if (m_stopFd < 0)
+    {
+        SWSS_LOG_THROW("eventfd failed: %s", strerror(errno));
+    }
+
+    SWSS_LOG_NOTICE("listening on shm endpoint %s, ring capacity %zu", m_endpoint.c_str(), capacity);
+
+    m_acceptThread = std::make_shared<std::thread>(&ShmTransport::acceptThread, this);
+}
+
+void ShmTransport::acceptThread()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("begin");
+
+    while (true)
+    {
+        // client never writes to its socket, so readable client socket
+        // means that client closed connection
+
+        struct pollfd pfd[3] = {
+            { m_listenFd, POLLIN, 0 },
+            { m_stopFd, POLLIN, 0 },
+            { m_clientFd, POLLIN, 0 } };
+
+        int rc = poll(pfd, m_clientFd >= 0 ? 3 : 2, -1);
+
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            SWSS_LOG_ERROR("poll failed: %s", strerror(errno));
+            break;
+        }
+
+        if (pfd[1].revents)
+            break;
+
+        if (m_clientFd >= 0 && pfd[2].revents)
+        {
+            SWSS_LOG_NOTICE("shm client disconnected from %s", m_endpoint.c_str());
+
+            m_clientConnected = false;
+
+            close(m_clientFd);
+
+            m_clientFd = -1;
+        }
+
+        if (pfd[0].revents == 0)
+            continue;
+
+        int socket = accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+
+        if (socket < 0)
+        {
+            SWSS_LOG_ERROR("accept failed on %s: %s", m_endpoint.c_str(), strerror(errno));
+            continue;
+        }
+
+        if (m_clientFd >= 0)
+        {
+            // rings are single producer single consumer, second client
+            // would corrupt them
+
+            SWSS_LOG_ERROR("shm endpoint %s already has connected client, rejecting new one", m_endpoint.c_str());
+
+            char busy = SHM_TRANSPORT_BUSY;
+
+            if (send(socket, &busy, sizeof(busy), MSG_NOSIGNAL) != sizeof(busy))
+            {
+                SWSS_LOG_ERROR("failed to reject shm client on %s: %s", m_endpoint.c_str(), strerror(errno));
+            }
+
+            close(socket);
+            continue;
+        }
+
+        if (!sendDescriptors(socket))
+        {
+            close(socket);
+            continue;
+        }
+
+        // connection is kept open for client lifetime to detect disconnect
+
+        m_clientFd = socket;
+
+        m_clientConnected = true;
+    }
+
+    SWSS_LOG_NOTICE("end");
+}
+
+bool ShmTransport::isClientConnected() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_clientConnected;
+}
+
+bool ShmTransport::sendDescriptors(
+        _In_ int socket)
+{
+    SWSS_LOG_ENTER();
+
+    int fds[1 + RING_MAX] = { m_memFd };
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        fds[1 + idx] = m_eventFds[idx];
+    }
+
+    char control[CMSG_SPACE(sizeof(fds))] = { };
+
+    char data = SHM_TRANSPORT_ACCEPTED;
+
+    struct iovec iov = { &data, sizeof(data) };
+
+    struct msghdr msg = { };
+
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    if (sendmsg(socket, &msg, MSG_NOSIGNAL) < 0)
+    {
+        SWSS_LOG_ERROR("failed to send shm descriptors on %s: %s", m_endpoint.c_str(), strerror(errno));
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("shm client connected on %s", m_endpoint.c_str());
+
+    return true;
+}
+
+void ShmTransport::connectClient()
+{
+    SWSS_LOG_ENTER();
+
+    struct sockaddr_un addr = { };
+
+    addr.sun_family = AF_UNIX;
+
+    strncpy(addr.sun_path, m_endpoint.c_str(), sizeof(addr.sun_path) - 1);
+
+    int socket = -1;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHM_TRANSPORT_CONNECT_TIMEOUT);
+
+    // syncd may be still starting, retry for a while
+
+    while (true)
+    {
+        socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        if (socket < 0)
+        {
+            SWSS_LOG_THROW("failed to create unix socket: %s", strerror(errno));
+        }
+
+        if (connect(socket, (struct sockaddr*)&addr, sizeof(addr)) == 0)
+            break;
+
+        close(socket);
+
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            SWSS_LOG_THROW("failed to connect to shm endpoint %s: %s", m_endpoint.c_str(), strerror(errno));
+        }
+
+        usleep(100*1000);
+    }
+
+    int fds[1 + RING_MAX];
+
+    char control[CMSG_SPACE(sizeof(fds))] = { };
+
+    char data;
+
+    struct iovec iov = { &data, sizeof(data) };
+
+    struct msghdr msg = { };
+
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t rc = recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+
+    if (rc == sizeof(data) && data == SHM_TRANSPORT_BUSY)
+    {
+        close(socket);
+
+        SWSS_LOG_THROW("shm endpoint %s already has connected client", m_endpoint.c_str());
+    }
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+
+    if (rc != sizeof(data) || data != SHM_TRANSPORT_ACCEPTED || cmsg == nullptr ||
+            cmsg->cmsg_type != SCM_RIGHTS ||
+            cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+    {
+        close(socket);
+
+        SWSS_LOG_THROW("failed to receive shm descriptors from %s", m_endpoint.c_str());
+    }
+
+    // server detects disconnect of this client when socket is closed
+
+    m_clientFd = socket;
+
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+    m_memFd = fds[0];
+
+    for (int idx = 0; idx < RING_MAX; idx++)
+    {
+        m_eventFds[idx] = fds[1 + idx];
+    }
+
+    struct stat st;
+
+    if (fstat(m_memFd, &st) != 0 || (size_t)st.st_size < SHM_TRANSPORT_HEADER_SIZE)
+    {
+        SWSS_LOG_THROW("invalid shared memory received from %s", m_endpoint.c_str());
+    }
+
+    ShmTransportHeader header;
+
+    if (pread(m_memFd, &header, sizeof(header), 0) != sizeof(header) ||
+            header.m_magic != SHM_TRANSPORT_MAGIC ||
+            header.m_version != SHM_TRANSPORT_VERSION ||
+            SHM_TRANSPORT_HEADER_SIZE + RING_MAX * ShmRing::getRequiredSize(header.m_ringCapacity) > (size_t)st.st_size)
+    {
+        SWSS_LOG_THROW("shared memory header mismatch on %s", m_endpoint.c_str());
+    }
+
+    mapMemory((size_t)st.st_size);
+
+    // previous client could leave unread responses and notifications, we are
+    // the only consumer of those rings, so it's safe to skip them
+
+    for (auto type: { RING_RESPONSE, RING_NOTIFICATION })
+    {
+        size_t size;
+
+        while (m_rings[type]->front(size))
+        {
+            m_rings[type]->pop();
+        }
+    }
+
+    SWSS_LOG_NOTICE("connected to shm endpoint %s, ring capacity %" PRIu64, m_endpoint.c_str(), header.m_ringCapacity);
+}
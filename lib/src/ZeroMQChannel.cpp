@@ -10,6 +10,9 @@
 #include <zmq.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <algorithm>
+
 using namespace sairedis;
 
 #define ZMQ_RESPONSE_BUFFER_SIZE (4*1024*1024)
@@ -17,10 +20,15 @@ using namespace sairedis;
 ZeroMQChannel::ZeroMQChannel(
         _In_ const std::string& endpoint,
         _In_ const std::string& ntfEndpoint,
-        _In_ Channel::Callback callback):
+        _In_ Channel::Callback callback,
+        _In_ ZeroMQMessageCodec::Codec codec,
+        _In_ bool pipeline):
     Channel(callback),
     m_endpoint(endpoint),
     m_ntfEndpoint(ntfEndpoint),
+    m_codec(codec),
+    m_pipeline(pipeline),
+    m_requestId(0),
     m_context(nullptr),
     m_socket(nullptr),
     m_ntfContext(nullptr),
@@ -30,13 +38,19 @@ ZeroMQChannel::ZeroMQChannel(
 
     m_buffer.resize(ZMQ_RESPONSE_BUFFER_SIZE);
 
+    SWSS_LOG_NOTICE("using zmq %s codec", ZeroMQMessageCodec::codecName(codec).c_str());
+
     // configure ZMQ for main communication
 
     m_context = zmq_ctx_new();
 
-    m_socket = zmq_socket(m_context, ZMQ_REQ);
+    // DEALER socket allows multiple requests in flight, each request is
+    // prefixed with request id and empty delimiter frame, so it's compatible
+    // with REQ envelope and can be served by both ROUTER and REP sockets
 
-    SWSS_LOG_NOTICE("opening zmq main endpoint: %s", endpoint.c_str());
+    m_socket = zmq_socket(m_context, pipeline ? ZMQ_DEALER : ZMQ_REQ);
+
+    SWSS_LOG_NOTICE("opening zmq main endpoint: %s (%s)", endpoint.c_str(), pipeline ? "DEALER" : "REQ");
 
     int rc = zmq_connect(m_socket, endpoint.c_str());
 
@@ -164,20 +178,14 @@ void ZeroMQChannel::notificationThreadFunction()
             continue;
         }
 
-        buffer.at(rc) = 0; // make sure that we end string with zero before parse
-
-        SWSS_LOG_DEBUG("ntf: %s", buffer.data());
+        swss::KeyOpFieldsValuesTuple kco;
 
-        std::vector<swss::FieldValueTuple> values;
+        ZeroMQMessageCodec::decode(buffer.data(), rc, kco);
 
-        swss::JSon::readJson((char*)buffer.data(), values);
+        const std::string& op = kfvKey(kco);
+        const std::string& data = kfvOp(kco);
 
-        swss::FieldValueTuple fvt = values.at(0);
-
-        const std::string& op = fvField(fvt);
-        const std::string& data = fvValue(fvt);
-
-        values.erase(values.begin());
+        const auto& values = kfvFieldsValues(kco);
 
         SWSS_LOG_DEBUG("notification: op = %s, data = %s", op.c_str(), data.c_str());
 
@@ -209,43 +217,47 @@ void ZeroMQChannel::set(
 {
     SWSS_LOG_ENTER();
 
-    std::vector<swss::FieldValueTuple> copy = values;
-
-    swss::FieldValueTuple opdata(key, command);
-
-    copy.insert(copy.begin(), opdata);
-
-    std::string msg = swss::JSon::buildJson(copy);
+    send(key, values, command);
+}
 
-    SWSS_LOG_DEBUG("sending: %s", msg.c_str());
+void ZeroMQChannel::del(
+        _In_ const std::string& key,
+        _In_ const std::string& command)
+{
+    SWSS_LOG_ENTER();
 
-    int rc = zmq_send(m_socket, msg.c_str(), msg.length(), 0);
+    std::vector<swss::FieldValueTuple> values;
 
-    if (rc <= 0)
-    {
-        SWSS_LOG_THROW("zmq_send failed, on endpoint %s, zmqerrno: %d",
-                m_endpoint.c_str(),
-                zmq_errno());
-    }
+    send(key, values, command);
 }
 
-void ZeroMQChannel::del(
+void ZeroMQChannel::send(
         _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& values,
         _In_ const std::string& command)
 {
     SWSS_LOG_ENTER();
 
-    std::vector<swss::FieldValueTuple> values;
+    ZeroMQMessageCodec::encode(m_codec, key, command, values, m_sendBuffer);
 
-    swss::FieldValueTuple opdata(key, command);
+    SWSS_LOG_DEBUG("sending: %s %s, %zu bytes", command.c_str(), key.c_str(), m_sendBuffer.size());
 
-    values.insert(values.begin(), opdata);
+    if (m_pipeline)
+    {
+        uint64_t requestId = ++m_requestId;
 
-    std::string msg = swss::JSon::buildJson(values);
+        if (zmq_send(m_socket, &requestId, sizeof(requestId), ZMQ_SNDMORE) < 0 ||
+                zmq_send(m_socket, nullptr, 0, ZMQ_SNDMORE) < 0)
+        {
+            SWSS_LOG_THROW("zmq_send envelope failed, on endpoint %s, zmqerrno: %d",
+                    m_endpoint.c_str(),
+                    zmq_errno());
+        }
 
-    SWSS_LOG_DEBUG("sending: %s", msg.c_str());
+        m_pendingRequests.push_back(requestId);
+    }
 
-    int rc = zmq_send(m_socket, msg.c_str(), msg.length(), 0);
+    int rc = zmq_send(m_socket, m_sendBuffer.data(), m_sendBuffer.size(), 0);
 
     if (rc <= 0)
     {
@@ -263,33 +275,49 @@ sai_status_t ZeroMQChannel::wait(
 
     SWSS_LOG_INFO("wait for %s response", command.c_str());
 
-    zmq_pollitem_t items [1] = { };
+    int rc;
 
-    items[0].socket = m_socket;
-    items[0].events = ZMQ_POLLIN;
+    if (m_pipeline)
+    {
+        rc = receivePipelinedResponse();
 
-    int rc = zmq_poll(items, 1, (int)m_responseTimeoutMs);
+        if (rc < 0)
+        {
+            SWSS_LOG_ERROR("zmq_poll timed out for: %s", command.c_str());
 
-    if (rc == 0)
+            return SAI_STATUS_FAILURE;
+        }
+    }
+    else
     {
-        SWSS_LOG_ERROR("zmq_poll timed out for: %s", command.c_str());
+        zmq_pollitem_t items [1] = { };
 
-        // notice, at this point we could throw, since in REP/REQ pattern
-        // we are forced to use send/recv in that specific order
+        items[0].socket = m_socket;
+        items[0].events = ZMQ_POLLIN;
 
-        return SAI_STATUS_FAILURE;
-    }
+        rc = zmq_poll(items, 1, (int)m_responseTimeoutMs);
 
-    if (rc < 0)
-    {
-        SWSS_LOG_THROW("zmq_poll failed, zmqerrno: %d", zmq_errno());
-    }
+        if (rc == 0)
+        {
+            SWSS_LOG_ERROR("zmq_poll timed out for: %s", command.c_str());
 
-    rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, 0);
+            // notice, at this point we could throw, since in REP/REQ pattern
+            // we are forced to use send/recv in that specific order
 
-    if (rc < 0)
-    {
-        SWSS_LOG_THROW("zmq_recv failed, zmqerrno: %d", zmq_errno());
+            return SAI_STATUS_FAILURE;
+        }
+
+        if (rc < 0)
+        {
+            SWSS_LOG_THROW("zmq_poll failed, zmqerrno: %d", zmq_errno());
+        }
+
+        rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, 0);
+
+        if (rc < 0)
+        {
+            SWSS_LOG_THROW("zmq_recv failed, zmqerrno: %d", zmq_errno());
+        }
     }
 
     if (rc >= ZMQ_RESPONSE_BUFFER_SIZE)
@@ -299,24 +327,10 @@ sai_status_t ZeroMQChannel::wait(
                 rc);
     }
 
-    m_buffer.at(rc) = 0; // make sure that we end string with zero before parse
-
-    SWSS_LOG_DEBUG("response: %s", m_buffer.data());
-
-    std::vector<swss::FieldValueTuple> values;
-
-    swss::JSon::readJson((char*)m_buffer.data(), values);
-
-    swss::FieldValueTuple fvt = values.at(0);
+    ZeroMQMessageCodec::decode(m_buffer.data(), rc, kco);
 
-    const std::string& opkey = fvField(fvt);
-    const std::string& op= fvValue(fvt);
-
-    values.erase(values.begin());
-
-    kfvFieldsValues(kco) = values;
-    kfvOp(kco) = op;
-    kfvKey(kco) = opkey;
+    const std::string& opkey = kfvKey(kco);
+    const std::string& op = kfvOp(kco);
 
     SWSS_LOG_INFO("response: op = %s, key = %s", opkey.c_str(), op.c_str());
 
@@ -336,3 +350,92 @@ sai_status_t ZeroMQChannel::wait(
 
     return status;
 }
+
+bool ZeroMQChannel::isPipelined() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_pipeline;
+}
+
+int ZeroMQChannel::receivePipelinedResponse()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pendingRequests.empty())
+    {
+        SWSS_LOG_THROW("no pending requests on %s, response not expected", m_endpoint.c_str());
+    }
+
+    uint64_t expected = m_pendingRequests.front();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_responseTimeoutMs);
+
+    while (true)
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+        zmq_pollitem_t items [1] = { };
+
+        items[0].socket = m_socket;
+        items[0].events = ZMQ_POLLIN;
+
+        int rc = zmq_poll(items, 1, (long)std::max<int64_t>(0, left.count()));
+
+        if (rc == 0)
+        {
+            // unlike REQ socket, DEALER is still usable after timeout, late
+            // response will be discarded based on its request id
+
+            m_pendingRequests.pop_front();
+
+            return -1;
+        }
+
+        if (rc < 0)
+        {
+            SWSS_LOG_THROW("zmq_poll failed, zmqerrno: %d", zmq_errno());
+        }
+
+        // response envelope: request id, empty delimiter, payload
+
+        uint64_t requestId = 0;
+
+        rc = zmq_recv(m_socket, &requestId, sizeof(requestId), 0);
+
+        if (rc != sizeof(requestId))
+        {
+            SWSS_LOG_THROW("zmq_recv request id failed, rc: %d, zmqerrno: %d", rc, zmq_errno());
+        }
+
+        rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, 0);
+
+        if (rc != 0)
+        {
+            SWSS_LOG_THROW("expected empty delimiter frame, rc: %d, zmqerrno: %d", rc, zmq_errno());
+        }
+
+        rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, 0);
+
+        if (rc < 0)
+        {
+            SWSS_LOG_THROW("zmq_recv failed, zmqerrno: %d", zmq_errno());
+        }
+
+        if (requestId < expected)
+        {
+            SWSS_LOG_WARN("discarding late response for request %" PRIu64 ", expected %" PRIu64, requestId, expected);
+
+            continue;
+        }
+
+        if (requestId != expected)
+        {
+            SWSS_LOG_THROW("got response for request %" PRIu64 ", expected %" PRIu64, requestId, expected);
+        }
+
+        m_pendingRequests.pop_front();
+
+        return rc;
+    }
+}
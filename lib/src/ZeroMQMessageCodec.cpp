@@ -0,0 +1,244 @@
+#include "ZeroMQMessageCodec.h"
+
+#include "swss/logger.h"
+#include "swss/json.h"
+
+#include <cstring>
+
+using namespace sairedis;
+
+#define ZMQ_BINARY_CODEC_MAGIC      (0xB1)
+#define ZMQ_BINARY_CODEC_VERSION    (1)
+#define ZMQ_BINARY_CODEC_HEADER     (1 + 1 + 4)
+
+static inline void putUint32(
+        _Inout_ char*& ptr,
+        _In_ uint32_t value)
+{
+    SWSS_LOG_ENTER();
+
+    ptr[0] = (char)(value & 0xff);
+    ptr[1] = (char)((value >> 8) & 0xff);
+    ptr[2] = (char)((value >> 16) & 0xff);
+    ptr[3] = (char)((value >> 24) & 0xff);
+
+    ptr += 4;
+}
+
+static inline void putString(
+        _Inout_ char*& ptr,
+        _In_ const std::string& str)
+{
+    SWSS_LOG_ENTER();
+
+    putUint32(ptr, (uint32_t)str.size());
+
+    memcpy(ptr, str.data(), str.size());
+
+    ptr += str.size();
+}
+
+static inline uint32_t getUint32(
+        _Inout_ const uint8_t*& ptr,
+        _In_ const uint8_t* end)
+{
+    SWSS_LOG_ENTER();
+
+    if (end - ptr < 4)
+    {
+        SWSS_LOG_THROW("binary message truncated, expected length field");
+    }
+
+    uint32_t value = (uint32_t)ptr[0]
+        | ((uint32_t)ptr[1] << 8)
+        | ((uint32_t)ptr[2] << 16)
+        | ((uint32_t)ptr[3] << 24);
+
+    ptr += 4;
+
+    return value;
+}
+
+static inline void getString(
+        _Inout_ const uint8_t*& ptr,
+        _In_ const uint8_t* end,
+        _Out_ std::string& str)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t len = getUint32(ptr, end);
+
+    if ((size_t)(end - ptr) < len)
+    {
+        SWSS_LOG_THROW("binary message truncated, expected %u bytes, only %zu left", len, (size_t)(end - ptr));
+    }
+
+    str.assign((const char*)ptr, len);
+
+    ptr += len;
+}
+
+ZeroMQMessageCodec::Codec ZeroMQMessageCodec::parseCodec(
+        _In_ const std::string& name)
+{
+    SWSS_LOG_ENTER();
+
+    if (name == "json")
+        return CODEC_JSON;
+
+    if (name == "binary")
+        return CODEC_BINARY;
+
+    SWSS_LOG_THROW("unknown zmq codec '%s', expected json|binary", name.c_str());
+}
+
+std::string ZeroMQMessageCodec::codecName(
+        _In_ Codec codec)
+{
+    SWSS_LOG_ENTER();
+
+    switch (codec)
+    {
+        case CODEC_JSON:
+            return "json";
+
+        case CODEC_BINARY:
+            return "binary";
+
+        default:
+            SWSS_LOG_THROW("unknown zmq codec %d", codec);
+    }
+}
+
+void ZeroMQMessageCodec::encode(
+        _In_ Codec codec,
+        _In_ const std::string& key,
+        _In_ const std::string& op,
+        _In_ const std::vector<swss::FieldValueTuple>& values,
+        _Out_ std::string& buffer)
+{
+    SWSS_LOG_ENTER();
+
+    if (codec == CODEC_JSON)
+    {
+        std::vector<swss::FieldValueTuple> copy;
+
+        copy.reserve(values.size() + 1);
+
+        copy.emplace_back(key, op);
+
+        copy.insert(copy.end(), values.begin(), values.end());
+
+        buffer = swss::JSon::buildJson(copy);
+
+        return;
+    }
+
+    if (codec != CODEC_BINARY)
+    {
+        SWSS_LOG_THROW("unknown zmq codec %d", codec);
+    }
+
+    size_t size = ZMQ_BINARY_CODEC_HEADER + 8 + key.size() + op.size();
+
+    for (auto& fvt: values)
+    {
+        size += 8 + fvField(fvt).size() + fvValue(fvt).size();
+    }
+
+    buffer.resize(size);
+
+    char* ptr = &buffer[0];
+
+    *ptr++ = (char)ZMQ_BINARY_CODEC_MAGIC;
+    *ptr++ = (char)ZMQ_BINARY_CODEC_VERSION;
+
+    putUint32(ptr, (uint32_t)(values.size() + 1));
+
+    putString(ptr, key);
+    putString(ptr, op);
+
+    for (auto& fvt: values)
+    {
+        putString(ptr, fvField(fvt));
+        putString(ptr, fvValue(fvt));
+    }
+}
+
+ZeroMQMessageCodec::Codec ZeroMQMessageCodec::decode(
+        _In_ const uint8_t* buffer,
+        _In_ size_t size,
+        _Out_ swss::KeyOpFieldsValuesTuple& kco)
+{
+    SWSS_LOG_ENTER();
+
+    auto& values = kfvFieldsValues(kco);
+
+    values.clear();
+
+    if (size == 0 || buffer[0] != ZMQ_BINARY_CODEC_MAGIC)
+    {
+        // legacy JSON message
+
+        swss::JSon::readJson(std::string((const char*)buffer, size), values);
+
+        if (values.empty())
+        {
+            SWSS_LOG_THROW("json message is empty");
+        }
+
+        kfvKey(kco) = fvField(values.at(0));
+        kfvOp(kco) = fvValue(values.at(0));
+
+        values.erase(values.begin());
+
+        return CODEC_JSON;
+    }
+
+    const uint8_t* ptr = buffer;
+    const uint8_t* end = buffer + size;
+
+    if (size < ZMQ_BINARY_CODEC_HEADER)
+    {
+        SWSS_LOG_THROW("binary message too short: %zu bytes", size);
+    }
+
+    if (ptr[1] != ZMQ_BINARY_CODEC_VERSION)
+    {
+        SWSS_LOG_THROW("unsupported binary message version: %u", ptr[1]);
+    }
+
+    ptr += 2;
+
+    uint32_t count = getUint32(ptr, end);
+
+    if (count == 0)
+    {
+        SWSS_LOG_THROW("binary message has no key/op tuple");
+    }
+
+    // each tuple takes at least 8 bytes, so don't trust count blindly
+
+    if ((size_t)(end - ptr) / 8 < count)
+    {
+        SWSS_LOG_THROW("binary message tuple count %u exceeds message size %zu", count, size);
+    }
+
+    getString(ptr, end, kfvKey(kco));
+    getString(ptr, end, kfvOp(kco));
+
+    values.resize(count - 1);
+
+    for (auto& fvt: values)
+    {
+        getString(ptr, end, fvField(fvt));
+        getString(ptr, end, fvValue(fvt));
+    }
+
+    if (ptr != end)
+    {
+        SWSS_LOG_THROW("binary message has %zu trailing bytes", (size_t)(end - ptr));
+    }
+
+    return CODEC_BINARY;
+}
@@ -3,19 +3,45 @@ extern "C" {
 }
 
 #include "ContextConfigContainer.h"
+#include "ZeroMQMessageCodec.h"
+#include "ShmRing.h"
+#include "RecorderWriter.h"
+#include "BinaryRecordingEncoder.h"
+#include "RecordingReader.h"
+#include "AttributeCache.h"
+#include "Sai.h"
+#include "RedisVidIndexGenerator.h"
+#include "sairediscommon.h"
 
 #include "swss/logger.h"
 #include "swss/table.h"
 #include "swss/tokenize.h"
+#include "swss/select.h"
+#include "swss/consumertable.h"
+#include "swss/producertable.h"
+#include "swss/redisreply.h"
 
 #include "meta/sai_serialize.h"
 #include "meta/SaiAttributeList.h"
 
 #include <unistd.h>
+#include <sys/eventfd.h>
+#include <arpa/inet.h>
 
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <mutex>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <tuple>
+#include <set>
+#include <cinttypes>
 
 using namespace saimeta;
 using namespace sairedis;
@@ -722,6 +748,384 @@ void test_ContextConfigContainer()
     auto ccc = ContextConfigContainer::loadFromFile("context_config.json");
 }
 
+static void test_zmq_codec(
+        _In_ ZeroMQMessageCodec::Codec codec,
+        _In_ int n)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<swss::FieldValueTuple> values;
+
+    for (int i = 0; i < n; i++)
+    {
+        sai_route_entry_t e = get_route_entry();
+
+        e.destination.addr.ip4 = 0x0a000000 | i;
+
+        values.emplace_back(sai_serialize_route_entry(e), "SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID=oid:0x500000000066c");
+    }
+
+    std::string msg;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    ZeroMQMessageCodec::encode(codec, "SAI_OBJECT_TYPE_ROUTE_ENTRY:" + std::to_string(n), "bulkcreate", values, msg);
+
+    swss::KeyOpFieldsValuesTuple kco;
+
+    auto decoded = ZeroMQMessageCodec::decode((const uint8_t*)msg.data(), msg.size(), kco);
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+
+    if (decoded != codec || kfvOp(kco) != "bulkcreate" || kfvFieldsValues(kco) != values)
+    {
+        SWSS_LOG_THROW("codec %s round trip failed", ZeroMQMessageCodec::codecName(codec).c_str());
+    }
+
+    std::cout << ZeroMQMessageCodec::codecName(codec) << " ms: " << (double)us.count()/1000.0 << " bytes: " << msg.size() << " n " << n << std::endl;
+}
+
+void test_zmq_codecs()
+{
+    SWSS_LOG_ENTER();
+
+    test_zmq_codec(ZeroMQMessageCodec::CODEC_JSON, 10000);
+    test_zmq_codec(ZeroMQMessageCodec::CODEC_BINARY, 10000);
+}
+
+void test_shm_ring()
+{
+    SWSS_LOG_ENTER();
+
+    size_t capacity = 4096;
+
+    std::vector<uint64_t> memory(ShmRing::getRequiredSize(capacity) / sizeof(uint64_t) + 8);
+
+    // header requires 64 byte alignment
+
+    void* ptr = (void*)(((uintptr_t)memory.data() + 63) & ~(uintptr_t)63);
+
+    int fd = eventfd(0, EFD_NONBLOCK);
+
+    ShmRing ring(ptr, capacity, fd);
+
+    ring.reset();
+
+    uint64_t pushed = 0;
+    uint64_t popped = 0;
+
+    // records of different sizes will force wrap many times
+
+    for (int i = 0; i < 10000; i++)
+    {
+        std::string record(1 + (i * 37) % 700, (char)('a' + i % 26));
+
+        while (!ring.push(record.data(), record.size(), 0))
+        {
+            size_t size;
+
+            const uint8_t* data = ring.front(size);
+
+            if (data == nullptr || size != 1 + (popped * 37) % 700 || data[0] != (uint8_t)('a' + popped % 26))
+            {
+                SWSS_LOG_THROW("ring record %" PRIu64 " mismatch", popped);
+            }
+
+            ring.pop();
+
+            popped++;
+        }
+
+        pushed++;
+    }
+
+    size_t size;
+
+    while (ring.front(size))
+    {
+        ring.pop();
+
+        popped++;
+    }
+
+    if (pushed != popped || !ring.empty() || !ring.arm())
+    {
+        SWSS_LOG_THROW("ring pushed %" PRIu64 " popped %" PRIu64, pushed, popped);
+    }
+
+    close(fd);
+}
+
+void test_recorder_writer()
+{
+    SWSS_LOG_ENTER();
+
+    std::string output;
+
+    {
+        RecorderWriter writer(16, [&](const std::string& batch) { output += batch; });
+
+        std::string expected;
+
+        for (int i = 0; i < 10000; i++)
+        {
+            std::string record = std::to_string(i) + "\n";
+
+            expected += record;
+
+            // record is moved only when push succeeds
+
+            while (!writer.push(std::move(record)))
+            {
+                writer.flush();
+            }
+        }
+
+        writer.flush();
+
+        if (output != expected)
+        {
+            SWSS_LOG_THROW("recorder writer output mismatch");
+        }
+    }
+
+    // writer blocked in sink can hold at most single batch, so with ring of
+    // 2 records at least 6 out of 10 must be dropped
+
+    std::mutex blocker;
+
+    size_t written = 0;
+
+    blocker.lock();
+
+    {
+        RecorderWriter writer(2, [&](const std::string& batch) {
+                std::lock_guard<std::mutex> lock(blocker);
+                written += std::count(batch.begin(), batch.end(), '\n'); });
+
+        for (int i = 0; i < 10; i++)
+        {
+            writer.push("x\n");
+        }
+
+        if (writer.getDroppedCount() < 6 || writer.getOverflowCount() == 0)
+        {
+            SWSS_LOG_THROW("recorder writer dropped %" PRIu64 " records", writer.getDroppedCount());
+        }
+
+        blocker.unlock();
+
+        writer.flush();
+
+        if (written + writer.getDroppedCount() != 10)
+        {
+            SWSS_LOG_THROW("recorder writer written %zu dropped %" PRIu64, written, writer.getDroppedCount());
+        }
+    }
+}
+
+void test_binary_recording()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> lines = {
+        "2020-01-01.10:00:00.000001|c|SAI_OBJECT_TYPE_SWITCH:oid:0x21000000000000|SAI_SWITCH_ATTR_INIT_SWITCH=true",
+        "2020-01-01.10:00:00.000002|c|SAI_OBJECT_TYPE_ROUTE_ENTRY:{\"dest\":\"10.0.0.0/8\",\"switch_id\":\"oid:0x21000000000000\",\"vr\":\"oid:0x3000000000022\"}|SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION=SAI_PACKET_ACTION_FORWARD",
+        "2020-01-01.10:00:01.000003|#|comment",
+        "2020-01-01.10:00:01.000004|a|INIT_VIEW",
+        "invalid timestamp|x",
+        "",
+        "no pipe",
+    };
+
+    const char* filename = "binary_recording.rec";
+
+    for (bool compressed: { false, true })
+    {
+        BinaryRecordingEncoder encoder;
+
+        std::string buffer;
+
+        // second segment has its own dictionary
+
+        for (int segment = 0; segment < 2; segment++)
+        {
+            encoder.startSegment(buffer);
+
+            for (auto& line: lines)
+            {
+                encoder.encode(line.data(), line.size(), buffer);
+            }
+        }
+
+        gzFile file = gzopen(filename, compressed ? "wb" : "wbT");
+
+        gzwrite(file, buffer.data(), (unsigned)buffer.size());
+
+        gzclose(file);
+
+        RecordingReader reader(filename);
+
+        if (!reader.isBinary())
+        {
+            SWSS_LOG_THROW("binary recording not detected");
+        }
+
+        std::string line;
+
+        size_t count = 0;
+
+        while (reader.getline(line))
+        {
+            if (line != lines[count++ % lines.size()])
+            {
+                SWSS_LOG_THROW("binary recording line mismatch: %s", line.c_str());
+            }
+        }
+
+        if (count != 2 * lines.size())
+        {
+            SWSS_LOG_THROW("binary recording read %zu lines", count);
+        }
+    }
+
+    // text recording is read by the same reader
+
+    {
+        std::ofstream file(filename);
+
+        for (auto& line: lines)
+        {
+            file << line << "\n";
+        }
+    }
+
+    RecordingReader reader(filename);
+
+    std::string line;
+
+    size_t count = 0;
+
+    while (reader.getline(line))
+    {
+        if (reader.isBinary() || line != lines[count++])
+        {
+            SWSS_LOG_THROW("text recording line mismatch: %s", line.c_str());
+        }
+    }
+
+    if (count != lines.size())
+    {
+        SWSS_LOG_THROW("text recording read %zu lines", count);
+    }
+
+    reader.close();
+
+    remove(filename);
+}
+
+void test_attribute_cache()
+{
+    SWSS_LOG_ENTER();
+
+    AttributeCache cache;
+
+    sai_object_id_t switchId = 0x21000000000000;
+    sai_object_id_t portId = 0x1000000000002;
+
+    if (cache.isCacheable(SAI_OBJECT_TYPE_PORT, SAI_PORT_ATTR_OPER_STATUS))
+    {
+        SWSS_LOG_THROW("port oper status should not be cacheable");
+    }
+
+    if (!cache.isCacheable(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_CPU_PORT))
+    {
+        SWSS_LOG_THROW("switch cpu port should be cacheable");
+    }
+
+    if (cache.add(SAI_OBJECT_TYPE_SWITCH, SAI_SWITCH_ATTR_SRC_MAC_ADDRESS))
+    {
+        SWSS_LOG_THROW("only READ_ONLY attributes can be added");
+    }
+
+    sai_attribute_t attr;
+    sai_status_t status;
+
+    attr.id = SAI_SWITCH_ATTR_CPU_PORT;
+
+    if (cache.get(SAI_OBJECT_TYPE_SWITCH, switchId, 1, &attr, status) || cache.getMissCount() != 1)
+    {
+        SWSS_LOG_THROW("empty cache should miss");
+    }
+
+    attr.value.oid = portId;
+
+    cache.update(SAI_OBJECT_TYPE_SWITCH, switchId, switchId, 1, &attr);
+
+    attr.value.oid = SAI_NULL_OBJECT_ID;
+
+    if (!cache.get(SAI_OBJECT_TYPE_SWITCH, switchId, 1, &attr, status) ||
+            status != SAI_STATUS_SUCCESS ||
+            attr.value.oid != portId ||
+            cache.getHitCount() != 1)
+    {
+        SWSS_LOG_THROW("cpu port should be served from cache");
+    }
+
+    // list attribute
+
+    int32_t speeds[] = { 10000, 25000, 40000, 100000 };
+
+    attr.id = SAI_PORT_ATTR_SUPPORTED_SPEED;
+    attr.value.u32list.count = 4;
+    attr.value.u32list.list = (uint32_t*)speeds;
+
+    cache.update(SAI_OBJECT_TYPE_PORT, portId, switchId, 1, &attr);
+
+    uint32_t list[4] = { 0 };
+
+    attr.value.u32list.count = 2;
+    attr.value.u32list.list = list;
+
+    if (!cache.get(SAI_OBJECT_TYPE_PORT, portId, 1, &attr, status) ||
+            status != SAI_STATUS_BUFFER_OVERFLOW ||
+            attr.value.u32list.count != 4)
+    {
+        SWSS_LOG_THROW("expected buffer overflow with required count");
+    }
+
+    if (!cache.get(SAI_OBJECT_TYPE_PORT, portId, 1, &attr, status) ||
+            status != SAI_STATUS_SUCCESS ||
+            list[3] != 100000)
+    {
+        SWSS_LOG_THROW("supported speeds should be served from cache");
+    }
+
+    // mixed request is not served from cache
+
+    sai_attribute_t attrs[2];
+
+    attrs[0].id = SAI_PORT_ATTR_TYPE;
+    attrs[1].id = SAI_PORT_ATTR_OPER_STATUS;
+
+    if (cache.get(SAI_OBJECT_TYPE_PORT, portId, 2, attrs, status))
+    {
+        SWSS_LOG_THROW("not cacheable attribute should not be served from cache");
+    }
+
+    cache.removeSwitch(switchId);
+
+    attr.id = SAI_SWITCH_ATTR_CPU_PORT;
+
+    if (cache.get(SAI_OBJECT_TYPE_SWITCH, switchId, 1, &attr, status) ||
+            cache.get(SAI_OBJECT_TYPE_PORT, portId, 1, &attr, status))
+    {
+        SWSS_LOG_THROW("switch removal should invalidate all switch objects");
+    }
+}
+
 static std::vector<std::string> tokenize(
         _In_ std::string input,
         _In_ const std::string &delim)
@@ -841,17 +1245,852 @@ void test_tokenize_bulk_route_entry()
     std::cout << "s: " << (double)us.count()/1000000.0 << " for total routes: " <<( n * per) << std::endl;
 }
 
-int main()
+static const char* profile_get_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _In_ const char* variable)
 {
     SWSS_LOG_ENTER();
 
-    std::cout << " * test tokenize bulk route entry" << std::endl;
+    return NULL;
+}
 
-    test_tokenize_bulk_route_entry();
+static int profile_get_next_value(
+        _In_ sai_switch_profile_id_t profile_id,
+        _Out_ const char** variable,
+        _Out_ const char** value)
+{
+    SWSS_LOG_ENTER();
 
-    std::cout << " * test ContextConfigContainer" << std::endl;
+    return -1;
+}
 
-    test_ContextConfigContainer();
+static sai_service_method_table_t test_services = {
+    profile_get_value,
+    profile_get_next_value
+};
+
+/*
+ * Syncd replacement for asynchronous pipeline and auto bulk tests, it answers
+ * requests from redis channel and records them. When holding, responses are
+ * sent only after client stopped sending requests, which is when client is
+ * waiting for response, so any request sent before pending responses were
+ * collected is recorded with zero responded count.
+ */
+class FakeSyncd
+{
+    public:
+
+        struct Request
+        {
+            std::string m_op;
+
+            std::string m_key;
+
+            size_t m_entries;
+
+            size_t m_responded;
+        };
+
+    public:
+
+        FakeSyncd():
+            m_hold(false),
+            m_responded(0),
+            m_run(true)
+        {
+            SWSS_LOG_ENTER();
+
+            m_db = std::make_shared<swss::DBConnector>("ASIC_DB", 0, true);
+
+            swss::RedisReply r(m_db.get(), "FLUSHALL", REDIS_REPLY_STATUS);
+
+            r.checkStatusOK();
+
+            m_asicState = std::make_shared<swss::ConsumerTable>(m_db.get(), ASIC_STATE_TABLE);
+
+            m_asicState->setModifyRedis(false);
+
+            m_getResponse = std::make_shared<swss::ProducerTable>(m_db.get(), REDIS_TABLE_GETRESPONSE);
+
+            m_thread = std::make_shared<std::thread>(&FakeSyncd::run, this);
+        }
+
+        virtual ~FakeSyncd()
+        {
+            SWSS_LOG_ENTER();
+
+            m_run = false;
+
+            m_thread->join();
+        }
+
+    public:
+
+        void fail(
+                _In_ const std::string& serializedEntry,
+                _In_ sai_status_t status)
+        {
+            SWSS_LOG_ENTER();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_failures[serializedEntry] = status;
+        }
+
+        void hold(
+                _In_ bool hold)
+        {
+            SWSS_LOG_ENTER();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_hold = hold;
+        }
+
+        void clearRequests()
+        {
+            SWSS_LOG_ENTER();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_requests.clear();
+
+            m_responded = 0;
+        }
+
+        std::vector<Request> getRequests()
+        {
+            SWSS_LOG_ENTER();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_requests;
+        }
+
+    private:
+
+        void run()
+        {
+            SWSS_LOG_ENTER();
+
+            swss::Select s;
+
+            s.addSelectable(m_asicState.get());
+
+            std::deque<swss::KeyOpFieldsValuesTuple> held;
+
+            while (m_run)
+            {
+                swss::Selectable *sel;
+
+                int result = s.select(&sel, 100);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (result == swss::Select::OBJECT)
+                {
+                    std::deque<swss::KeyOpFieldsValuesTuple> kcos;
+
+                    m_asicState->pops(kcos);
+
+                    for (auto& kco: kcos)
+                    {
+                        m_requests.push_back({ kfvOp(kco), kfvKey(kco), kfvFieldsValues(kco).size(), m_responded });
+
+                        held.push_back(kco);
+                    }
+
+                    if (m_hold)
+                    {
+                        continue;
+                    }
+                }
+
+                // client is idle, it waits for responses
+
+                for (auto& kco: held)
+                {
+                    respond(kco);
+                }
+
+                held.clear();
+            }
+        }
+
+        sai_status_t getStatus(
+                _In_ const std::string& key) const
+        {
+            SWSS_LOG_ENTER();
+
+            for (auto& kvp: m_failures)
+            {
+                if (key.find(kvp.first) != std::string::npos)
+                {
+                    return kvp.second;
+                }
+            }
+
+            return SAI_STATUS_SUCCESS;
+        }
+
+        void respond(
+                _In_ const swss::KeyOpFieldsValuesTuple& kco)
+        {
+            SWSS_LOG_ENTER();
+
+            const auto& op = kfvOp(kco);
+
+            std::vector<swss::FieldValueTuple> values;
+
+            sai_status_t status = SAI_STATUS_SUCCESS;
+
+            if (op == REDIS_ASIC_STATE_COMMAND_BULK_CREATE || op == REDIS_ASIC_STATE_COMMAND_BULK_REMOVE)
+            {
+                for (auto& fv: kfvFieldsValues(kco))
+                {
+                    auto entryStatus = getStatus(fvField(fv));
+
+                    values.emplace_back(sai_serialize_status(entryStatus), "");
+
+                    if (entryStatus != SAI_STATUS_SUCCESS)
+                    {
+                        status = SAI_STATUS_FAILURE;
+                    }
+                }
+            }
+            else if (op == REDIS_ASIC_STATE_COMMAND_CREATE || op == REDIS_ASIC_STATE_COMMAND_REMOVE || op == REDIS_ASIC_STATE_COMMAND_SET)
+            {
+                status = getStatus(kfvKey(kco));
+            }
+            else
+            {
+                status = SAI_STATUS_NOT_IMPLEMENTED;
+            }
+
+            m_getResponse->set(sai_serialize_status(status), values, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+
+            m_responded++;
+        }
+
+    private:
+
+        std::mutex m_mutex;
+
+        bool m_hold;
+
+        size_t m_responded;
+
+        std::vector<Request> m_requests;
+
+        std::map<std::string, sai_status_t> m_failures;
+
+        std::atomic<bool> m_run;
+
+        std::shared_ptr<swss::DBConnector> m_db;
+
+        std::shared_ptr<swss::ConsumerTable> m_asicState;
+
+        std::shared_ptr<swss::ProducerTable> m_getResponse;
+
+        std::shared_ptr<std::thread> m_thread;
+};
+
+static void set_redis_attr(
+        _In_ Sai& sai,
+        _In_ const sai_attribute_t& attr,
+        _In_ sai_status_t expected)
+{
+    SWSS_LOG_ENTER();
+
+    auto status = sai.set(SAI_OBJECT_TYPE_SWITCH, SAI_NULL_OBJECT_ID, &attr);
+
+    if (status != expected)
+    {
+        SWSS_LOG_THROW("set redis attribute 0x%x returned %s, expected %s",
+                attr.id,
+                sai_serialize_status(status).c_str(),
+                sai_serialize_status(expected).c_str());
+    }
+}
+
+static void async_drain(
+        _In_ Sai& sai,
+        _In_ sai_status_t expected)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_DRAIN;
+    attr.value.booldata = true;
+
+    set_redis_attr(sai, attr, expected);
+}
+
+/*
+ * Creates sairedis in redis sync mode with switch and virtual router,
+ * recording is disabled.
+ */
+static std::shared_ptr<Sai> create_sync_sai(
+        _Out_ sai_object_id_t& switchId,
+        _Out_ sai_object_id_t& vrId)
+{
+    SWSS_LOG_ENTER();
+
+    auto sai = std::make_shared<Sai>();
+
+    if (sai->initialize(0, &test_services) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to initialize sairedis");
+    }
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_RECORD;
+    attr.value.booldata = false;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_REDIS_COMMUNICATION_MODE;
+    attr.value.s32 = SAI_REDIS_COMMUNICATION_MODE_REDIS_SYNC;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+    attr.value.booldata = true;
+
+    if (sai->create(SAI_OBJECT_TYPE_SWITCH, &switchId, SAI_NULL_OBJECT_ID, 1, &attr) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to create switch");
+    }
+
+    if (sai->create(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, &vrId, switchId, 0, nullptr) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to create virtual router");
+    }
+
+    return sai;
+}
+
+static sai_route_entry_t make_route_entry(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_id_t vrId,
+        _In_ uint32_t index)
+{
+    SWSS_LOG_ENTER();
+
+    sai_route_entry_t route_entry = { };
+
+    route_entry.switch_id = switchId;
+    route_entry.vr_id = vrId;
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.addr.ip4 = htonl(0x0a000000 | index);
+    route_entry.destination.mask.ip4 = htonl(0xffffffff);
+
+    return route_entry;
+}
+
+static std::vector<std::tuple<uint64_t, std::string, sai_status_t>> g_asyncFailures;
+
+static void async_failure_notification(
+        _In_ uint64_t sequence,
+        _In_ sai_common_api_t api,
+        _In_ const char *serialized_key,
+        _In_ sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    g_asyncFailures.emplace_back(sequence, serialized_key, status);
+}
+
+void test_async_pipeline_in_flight()
+{
+    SWSS_LOG_ENTER();
+
+    FakeSyncd syncd;
+
+    sai_object_id_t switchId;
+    sai_object_id_t vrId;
+
+    auto sai = create_sync_sai(switchId, vrId);
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_PIPELINE_DEPTH;
+    attr.value.u32 = 64;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    syncd.clearRequests();
+    syncd.hold(true);
+
+    const uint32_t count = 16;
+
+    for (uint32_t idx = 0; idx < count; idx++)
+    {
+        auto route = make_route_entry(switchId, vrId, idx);
+
+        if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("failed to create route %u", idx);
+        }
+    }
+
+    async_drain(*sai, SAI_STATUS_SUCCESS);
+
+    // routes share switch and virtual router, but none of them waited for response
+
+    auto requests = syncd.getRequests();
+
+    if (requests.size() != count)
+    {
+        SWSS_LOG_THROW("expected %u requests, got %zu", count, requests.size());
+    }
+
+    for (auto& request: requests)
+    {
+        if (request.m_op != REDIS_ASIC_STATE_COMMAND_CREATE || request.m_responded != 0)
+        {
+            SWSS_LOG_THROW("request %s %s was sent after %zu responses",
+                    request.m_op.c_str(),
+                    request.m_key.c_str(),
+                    request.m_responded);
+        }
+    }
+
+    syncd.hold(false);
+
+    // routes are in metadata after drain
+
+    auto route = make_route_entry(switchId, vrId, 0);
+
+    if (sai->create(&route, 0, nullptr) == SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("route created twice");
+    }
+
+    sai->uninitialize();
+}
+
+void test_async_pipeline_failures()
+{
+    SWSS_LOG_ENTER();
+
+    FakeSyncd syncd;
+
+    sai_object_id_t switchId;
+    sai_object_id_t vrId;
+
+    auto sai = create_sync_sai(switchId, vrId);
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_PIPELINE_DEPTH;
+    attr.value.u32 = 64;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY;
+    attr.value.ptr = (void*)&async_failure_notification;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    g_asyncFailures.clear();
+
+    std::vector<sai_route_entry_t> routes;
+
+    for (uint32_t idx = 0; idx < 5; idx++)
+    {
+        routes.push_back(make_route_entry(switchId, vrId, idx));
+    }
+
+    syncd.fail(sai_serialize_route_entry(routes[1]), SAI_STATUS_INSUFFICIENT_RESOURCES);
+    syncd.fail(sai_serialize_route_entry(routes[3]), SAI_STATUS_TABLE_FULL);
+
+    for (auto& route: routes)
+    {
+        if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("pipelined create should succeed");
+        }
+    }
+
+    async_drain(*sai, SAI_STATUS_FAILURE);
+
+    // each response is matched with request in order it was sent
+
+    if (g_asyncFailures.size() != 2)
+    {
+        SWSS_LOG_THROW("expected 2 failures, got %zu", g_asyncFailures.size());
+    }
+
+    auto& first = g_asyncFailures[0];
+    auto& second = g_asyncFailures[1];
+
+    if (std::get<1>(first).find(sai_serialize_route_entry(routes[1])) == std::string::npos ||
+            std::get<2>(first) != SAI_STATUS_INSUFFICIENT_RESOURCES ||
+            std::get<1>(second).find(sai_serialize_route_entry(routes[3])) == std::string::npos ||
+            std::get<2>(second) != SAI_STATUS_TABLE_FULL ||
+            std::get<0>(second) - std::get<0>(first) != 2)
+    {
+        SWSS_LOG_THROW("failures don't match failed requests");
+    }
+
+    // failures are reported only once
+
+    async_drain(*sai, SAI_STATUS_SUCCESS);
+
+    // failed create is not committed to metadata, so remove is rejected locally
+
+    if (sai->remove(&routes[1]) == SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed route should not be in metadata");
+    }
+
+    if (sai->remove(&routes[0]) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to remove route");
+    }
+
+    async_drain(*sai, SAI_STATUS_SUCCESS);
+
+    sai->uninitialize();
+}
+
+void test_async_pipeline_dependency()
+{
+    SWSS_LOG_ENTER();
+
+    FakeSyncd syncd;
+
+    sai_object_id_t switchId;
+    sai_object_id_t vrId;
+
+    auto sai = create_sync_sai(switchId, vrId);
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_PIPELINE_DEPTH;
+    attr.value.u32 = 64;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    syncd.clearRequests();
+    syncd.hold(true);
+
+    sai_object_id_t vrId2;
+
+    if (sai->create(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, &vrId2, switchId, 0, nullptr) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to create virtual router");
+    }
+
+    // route in pending virtual router waits until router create is committed
+
+    auto route = make_route_entry(switchId, vrId2, 1);
+
+    if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to create route");
+    }
+
+    async_drain(*sai, SAI_STATUS_SUCCESS);
+
+    auto requests = syncd.getRequests();
+
+    if (requests.size() != 2 ||
+            requests[0].m_key.find(sai_serialize_object_id(vrId2)) == std::string::npos ||
+            requests[0].m_responded != 0 ||
+            requests[1].m_key.find(sai_serialize_route_entry(route)) == std::string::npos ||
+            requests[1].m_responded != 1)
+    {
+        SWSS_LOG_THROW("route create was sent before virtual router create response");
+    }
+
+    syncd.hold(false);
+
+    sai->uninitialize();
+}
+
+static void check_requests(
+        _In_ FakeSyncd& syncd,
+        _In_ const std::vector<std::pair<std::string, size_t>>& expected)
+{
+    SWSS_LOG_ENTER();
+
+    auto requests = syncd.getRequests();
+
+    bool match = requests.size() == expected.size();
+
+    for (size_t idx = 0; match && idx < requests.size(); idx++)
+    {
+        match = requests[idx].m_op == expected[idx].first && requests[idx].m_entries == expected[idx].second;
+    }
+
+    if (!match)
+    {
+        for (auto& request: requests)
+        {
+            SWSS_LOG_ERROR("request %s %s, entries %zu", request.m_op.c_str(), request.m_key.c_str(), request.m_entries);
+        }
+
+        SWSS_LOG_THROW("requests don't match expected requests");
+    }
+}
+
+void test_auto_bulk()
+{
+    SWSS_LOG_ENTER();
+
+    FakeSyncd syncd;
+
+    sai_object_id_t switchId;
+    sai_object_id_t vrId;
+
+    auto sai = create_sync_sai(switchId, vrId);
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_SIZE;
+    attr.value.u32 = 4;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_AUTO_BULK_MAX_DELAY;
+    attr.value.u32 = 0;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_ASYNC_FAILURE_NOTIFY;
+    attr.value.ptr = (void*)&async_failure_notification;
+
+    set_redis_attr(*sai, attr, SAI_STATUS_SUCCESS);
+
+    g_asyncFailures.clear();
+
+    std::vector<sai_route_entry_t> routes;
+
+    for (uint32_t idx = 0; idx < 10; idx++)
+    {
+        routes.push_back(make_route_entry(switchId, vrId, idx));
+    }
+
+    syncd.fail(sai_serialize_route_entry(routes[5]), SAI_STATUS_TABLE_FULL);
+
+    syncd.clearRequests();
+
+    for (auto& route: routes)
+    {
+        if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("buffered create should succeed");
+        }
+    }
+
+    // full buffer is sent on next call, rest is sent on drain
+
+    check_requests(syncd, {
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 4 },
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 4 } });
+
+    async_drain(*sai, SAI_STATUS_FAILURE);
+
+    check_requests(syncd, {
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 4 },
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 4 },
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 2 } });
+
+    // per entry status is returned to entry caller
+
+    if (g_asyncFailures.size() != 1 ||
+            std::get<1>(g_asyncFailures[0]).find(sai_serialize_route_entry(routes[5])) == std::string::npos ||
+            std::get<2>(g_asyncFailures[0]) != SAI_STATUS_TABLE_FULL)
+    {
+        SWSS_LOG_THROW("failure of buffered route was not reported");
+    }
+
+    if (sai->remove(&routes[5]) == SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed route should not be in metadata");
+    }
+
+    // operation change sends buffer
+
+    syncd.clearRequests();
+
+    for (uint32_t idx = 20; idx < 23; idx++)
+    {
+        auto route = make_route_entry(switchId, vrId, idx);
+
+        if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("buffered create should succeed");
+        }
+    }
+
+    if (sai->remove(&routes[0]) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("buffered remove should succeed");
+    }
+
+    check_requests(syncd, {
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 3 } });
+
+    async_drain(*sai, SAI_STATUS_SUCCESS);
+
+    check_requests(syncd, {
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 3 },
+            { REDIS_ASIC_STATE_COMMAND_BULK_REMOVE, 1 } });
+
+    // object type change sends buffer
+
+    syncd.clearRequests();
+
+    for (uint32_t idx = 30; idx < 32; idx++)
+    {
+        auto route = make_route_entry(switchId, vrId, idx);
+
+        if (sai->create(&route, 0, nullptr) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("buffered create should succeed");
+        }
+    }
+
+    sai_object_id_t vrId2;
+
+    if (sai->create(SAI_OBJECT_TYPE_VIRTUAL_ROUTER, &vrId2, switchId, 0, nullptr) != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to create virtual router");
+    }
+
+    check_requests(syncd, {
+            { REDIS_ASIC_STATE_COMMAND_BULK_CREATE, 2 },
+            { REDIS_ASIC_STATE_COMMAND_CREATE, 1 } }); // NULL attribute
+
+    sai->uninitialize();
+}
+
+void test_redis_vid_index_generator()
+{
+    SWSS_LOG_ENTER();
+
+    auto db = std::make_shared<swss::DBConnector>("ASIC_DB", 0, true);
+
+    const std::string counter = "TEST_VIDCOUNTER";
+
+    db->del(counter);
+
+    RedisVidIndexGenerator gen1(db, counter, 4);
+    RedisVidIndexGenerator gen2(db, counter, 4);
+
+    // first range is 1-4, indexes within range don't touch counter
+
+    for (uint64_t expected = 1; expected <= 3; expected++)
+    {
+        if (gen1.increment() != expected)
+        {
+            SWSS_LOG_THROW("expected index %" PRIu64 " from first range", expected);
+        }
+    }
+
+    if (std::stoull(*db->get(counter)) != 4)
+    {
+        SWSS_LOG_THROW("counter should be advanced by single range");
+    }
+
+    // other generator sharing counter gets next range 5-8
+
+    if (gen2.increment() != 5)
+    {
+        SWSS_LOG_THROW("second generator should start at next range");
+    }
+
+    // crossing range boundary reserves range after the one taken by second generator
+
+    if (gen1.increment() != 4 || gen1.increment() != 9)
+    {
+        SWSS_LOG_THROW("first generator should continue in new range");
+    }
+
+    std::set<uint64_t> indexes;
+
+    for (int i = 0; i < 100; i++)
+    {
+        indexes.insert(gen1.increment());
+        indexes.insert(gen2.increment());
+    }
+
+    if (indexes.size() != 200)
+    {
+        SWSS_LOG_THROW("generators sharing counter returned overlapping indexes");
+    }
+
+    // counter is high-water mark of all reserved ranges
+
+    if (*indexes.rbegin() > std::stoull(*db->get(counter)))
+    {
+        SWSS_LOG_THROW("index above counter value was returned");
+    }
+
+    // reset drops reserved range, next index comes from new range
+
+    gen1.reset();
+
+    uint64_t last = std::stoull(*db->get(counter));
+
+    if (gen1.increment() != last + 1)
+    {
+        SWSS_LOG_THROW("index after reset should come from new range");
+    }
+
+    db->del(counter);
+}
+
+int main()
+{
+    SWSS_LOG_ENTER();
+
+    std::cout << " * test tokenize bulk route entry" << std::endl;
+
+    test_tokenize_bulk_route_entry();
+
+    std::cout << " * test ContextConfigContainer" << std::endl;
+
+    test_ContextConfigContainer();
+
+    std::cout << " * test zmq codecs" << std::endl;
+
+    test_zmq_codecs();
+
+    std::cout << " * test shm ring" << std::endl;
+
+    test_shm_ring();
+
+    std::cout << " * test recorder writer" << std::endl;
+
+    test_recorder_writer();
+
+    std::cout << " * test binary recording" << std::endl;
+
+    test_binary_recording();
+
+    std::cout << " * test attribute cache" << std::endl;
+
+    test_attribute_cache();
+
+    std::cout << " * test redis vid index generator" << std::endl;
+
+    test_redis_vid_index_generator();
+
+    std::cout << " * test async pipeline" << std::endl;
+
+    test_async_pipeline_in_flight();
+    test_async_pipeline_failures();
+    test_async_pipeline_dependency();
+
+    std::cout << " * test auto bulk" << std::endl;
+
+    test_auto_bulk();
 
     std::cout << " * test deserialize route_entry" << std::endl;
 
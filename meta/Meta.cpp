@@ -47,6 +47,8 @@ Meta::Meta(
     // then warm boot must be per each switch
 
     m_warmBoot = false;
+
+    m_deferPostCommit = false;
 }
 
 sai_status_t Meta::initialize(
@@ -98,6 +100,13 @@ void Meta::meta_init_db()
 
     m_warmBoot = false;
 
+    m_deferPostCommit = false;
+    m_deferredCommits.clear();
+    m_deferredKeys.clear();
+    m_deferredObjectIds.clear();
+    m_deferredReferences.clear();
+    m_deferredRemoveTypes.clear();
+
     SWSS_LOG_NOTICE("end");
 }
 
@@ -1549,6 +1558,10 @@ sai_status_t Meta::flushFdbEntries(
 {
     SWSS_LOG_ENTER();
 
+    // attributes may reference objects changed by deferred requests
+
+    flushDeferredCommits();
+
     if (attr_count > MAX_LIST_COUNT)
     {
         SWSS_LOG_ERROR("create attribute count %u > max list count %u", attr_count, MAX_LIST_COUNT);
@@ -1783,6 +1796,10 @@ sai_status_t Meta::objectTypeGetAvailability(
 {
     SWSS_LOG_ENTER();
 
+    // attributes may reference objects changed by deferred requests
+
+    flushDeferredCommits();
+
     PARAMETER_CHECK_OID_OBJECT_TYPE(switchId, SAI_OBJECT_TYPE_SWITCH);
     PARAMETER_CHECK_OID_EXISTS(switchId, SAI_OBJECT_TYPE_SWITCH);
     PARAMETER_CHECK_OBJECT_TYPE_VALID(objectType);
@@ -2079,6 +2096,65 @@ sai_status_t Meta::clearStats(
     return status;
 }
 
+sai_status_t Meta::bulkGetStats(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    PARAMETER_CHECK_IF_NOT_NULL(object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+    }
+
+    PARAMETER_CHECK_OID_OBJECT_TYPE(switchId, SAI_OBJECT_TYPE_SWITCH);
+    PARAMETER_CHECK_OID_EXISTS(switchId, SAI_OBJECT_TYPE_SWITCH);
+    PARAMETER_CHECK_POSITIVE(object_count);
+    PARAMETER_CHECK_IF_NOT_NULL(object_key);
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        sai_object_id_t object_id = object_key[idx].key.object_id;
+
+        auto status = meta_validate_stats(object_type, object_id, number_of_counters, counter_ids, counters, mode);
+
+        CHECK_STATUS_SUCCESS(status);
+
+        if (switchIdQuery(object_id) != switchId)
+        {
+            SWSS_LOG_ERROR("object %s does not belong to switch %s",
+                    sai_serialize_object_id(object_id).c_str(),
+                    sai_serialize_object_id(switchId).c_str());
+
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+    }
+
+    auto status = m_implementation->bulkGetStats(
+            switchId,
+            object_type,
+            object_count,
+            object_key,
+            number_of_counters,
+            counter_ids,
+            mode,
+            object_statuses,
+            counters);
+
+    // no post validation required
+
+    return status;
+}
+
 // for bulk operations actually we could make copy of current db and actually
 // execute to see if all will succeed
 
@@ -3095,6 +3171,8 @@ sai_status_t Meta::meta_generic_validation_remove(
 {
     SWSS_LOG_ENTER();
 
+    flushDeferredCommitsOnRemove(meta_key);
+
     if (!m_saiObjectCollection.objectExists(meta_key))
     {
         SWSS_LOG_ERROR("object key %s doesn't exist",
@@ -3377,6 +3455,8 @@ sai_status_t Meta::meta_sai_validate_oid(
 
     sai_object_meta_key_t meta_key_oid = { .objecttype = expected, .objectkey = { .key = { .object_id = oid } } };
 
+    flushDeferredCommitsIfNeeded(meta_key_oid, 0, nullptr);
+
     if (!m_saiObjectCollection.objectExists(meta_key_oid))
     {
         SWSS_LOG_ERROR("object key %s doesn't exist",
@@ -3393,6 +3473,11 @@ void Meta::meta_generic_validation_post_remove(
 {
     SWSS_LOG_ENTER();
 
+    if (deferCommit(SAI_COMMON_API_REMOVE, meta_key, SAI_NULL_OBJECT_ID, 0, nullptr))
+    {
+        return;
+    }
+
     if (meta_key.objecttype == SAI_OBJECT_TYPE_SWITCH)
     {
         /*
@@ -3637,6 +3722,10 @@ sai_status_t Meta::meta_sai_validate_fdb_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = *fdb_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     //sai_vlan_id_t vlan_id = fdb_entry->vlan_id;
 
     //if (vlan_id < MINIMUM_VLAN_NUMBER || vlan_id > MAXIMUM_VLAN_NUMBER)
@@ -3692,6 +3781,10 @@ sai_status_t Meta::meta_sai_validate_mcast_fdb_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_MCAST_FDB_ENTRY, .objectkey = { .key = { .mcast_fdb_entry = *mcast_fdb_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     sai_object_id_t bv_id = mcast_fdb_entry->bv_id;
 
     if (bv_id == SAI_NULL_OBJECT_ID)
@@ -3774,6 +3867,10 @@ sai_status_t Meta::meta_sai_validate_neighbor_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, .objectkey = { .key = { .neighbor_entry = *neighbor_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     switch (neighbor_entry->ip_address.addr_family)
     {
         case SAI_IP_ADDR_FAMILY_IPV4:
@@ -3870,6 +3967,10 @@ sai_status_t Meta::meta_sai_validate_route_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = *route_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     auto family = route_entry->destination.addr_family;
 
     switch (family)
@@ -3977,6 +4078,10 @@ sai_status_t Meta::meta_sai_validate_l2mc_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_L2MC_ENTRY, .objectkey = { .key = { .l2mc_entry = *l2mc_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     switch (l2mc_entry->type)
     {
         case SAI_L2MC_ENTRY_TYPE_SG:
@@ -4100,6 +4205,10 @@ sai_status_t Meta::meta_sai_validate_ipmc_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_IPMC_ENTRY, .objectkey = { .key = { .ipmc_entry = *ipmc_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     switch (ipmc_entry->type)
     {
         case SAI_IPMC_ENTRY_TYPE_SG:
@@ -4223,6 +4332,10 @@ sai_status_t Meta::meta_sai_validate_nat_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_NAT_ENTRY, .objectkey = { .key = { .nat_entry = *nat_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     sai_object_id_t vr = nat_entry->vr_id;
 
     if (vr == SAI_NULL_OBJECT_ID)
@@ -4304,6 +4417,10 @@ sai_status_t Meta::meta_sai_validate_inseg_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    sai_object_meta_key_t meta_key_entry = { .objecttype = SAI_OBJECT_TYPE_INSEG_ENTRY, .objectkey = { .key = { .inseg_entry = *inseg_entry } } };
+
+    flushDeferredCommitsIfNeeded(meta_key_entry, 0, nullptr);
+
     // validate mpls label
 
     return SAI_STATUS_SUCCESS;
@@ -4331,6 +4448,8 @@ sai_status_t Meta::meta_generic_validation_create(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    flushDeferredCommitsIfNeeded(meta_key, attr_count, attr_list);
+
     bool switchcreate = meta_key.objecttype == SAI_OBJECT_TYPE_SWITCH;
 
     if (switchcreate)
@@ -5076,6 +5195,8 @@ sai_status_t Meta::meta_generic_validation_set(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
+    flushDeferredCommitsIfNeeded(meta_key, 1, attr);
+
     auto mdp = sai_metadata_get_attr_metadata(meta_key.objecttype, attr->id);
 
     if (mdp == NULL)
@@ -6648,6 +6769,11 @@ void Meta::meta_generic_validation_post_create(
 {
     SWSS_LOG_ENTER();
 
+    if (deferCommit(SAI_COMMON_API_CREATE, meta_key, switch_id, attr_count, attr_list))
+    {
+        return;
+    }
+
     if (m_saiObjectCollection.objectExists(meta_key))
     {
         if (m_warmBoot && meta_key.objecttype == SAI_OBJECT_TYPE_SWITCH)
@@ -6933,6 +7059,11 @@ void Meta::meta_generic_validation_post_set(
 {
     SWSS_LOG_ENTER();
 
+    if (deferCommit(SAI_COMMON_API_SET, meta_key, SAI_NULL_OBJECT_ID, 1, attr))
+    {
+        return;
+    }
+
     auto mdp = sai_metadata_get_attr_metadata(meta_key.objecttype, attr->id);
 
     const sai_attribute_value_t& value = attr->value;
@@ -7890,3 +8021,343 @@ void Meta::populate(
         }
     }
 }
+
+void Meta::deferPostCommit()
+{
+    SWSS_LOG_ENTER();
+
+    m_deferPostCommit = true;
+}
+
+void Meta::setDeferredCommitFlush(
+        _In_ std::function<void()> flush)
+{
+    SWSS_LOG_ENTER();
+
+    m_deferredCommitFlush = flush;
+}
+
+bool Meta::deferCommit(
+        _In_ sai_common_api_t api,
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_deferPostCommit)
+    {
+        return false;
+    }
+
+    m_deferPostCommit = false;
+
+    DeferredCommit commit;
+
+    commit.m_api = api;
+    commit.m_metaKey = meta_key;
+    commit.m_switchId = switch_id;
+    commit.m_attributes = SaiAttributeList::serialize_attr_list(meta_key.objecttype, attr_count, attr_list, false);
+
+    m_deferredCommits.push_back(commit);
+
+    /*
+     * Remember object ids which existence will change when this commit is
+     * applied, requests referencing them must wait for this commit.
+     */
+
+    auto info = sai_metadata_get_object_type_info(meta_key.objecttype);
+
+    if (!info->isnonobjectid && api != SAI_COMMON_API_SET)
+    {
+        m_deferredObjectIds.insert(meta_key.objectkey.key.object_id);
+    }
+
+    /*
+     * Remember object ids which reference count will change, new references
+     * and old references which will be released, only remove of those
+     * objects must wait for this commit.
+     */
+
+    std::vector<sai_object_id_t> oids;
+
+    getMetaKeyOids(meta_key, oids);
+
+    for (uint32_t idx = 0; idx < attr_count; idx++)
+    {
+        getAttrOids(meta_key.objecttype, &attr_list[idx], oids);
+    }
+
+    if (api != SAI_COMMON_API_CREATE && m_saiObjectCollection.objectExists(meta_key))
+    {
+        auto obj = m_saiObjectCollection.getObject(meta_key);
+
+        for (auto& attr: obj->getAttributes())
+        {
+            if (api == SAI_COMMON_API_REMOVE || attr->getSaiAttr()->id == attr_list[0].id)
+            {
+                getAttrOids(meta_key.objecttype, attr->getSaiAttr(), oids);
+            }
+        }
+    }
+
+    m_deferredReferences.insert(oids.begin(), oids.end());
+
+    m_deferredKeys.insert(sai_serialize_object_meta_key(meta_key));
+
+    if (api == SAI_COMMON_API_REMOVE)
+    {
+        m_deferredRemoveTypes.insert(meta_key.objecttype);
+    }
+
+    return true;
+}
+
+void Meta::completeDeferredCommit(
+        _In_ sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_deferredCommits.empty())
+    {
+        SWSS_LOG_THROW("no deferred commit to complete with status %s", sai_serialize_status(status).c_str());
+    }
+
+    auto commit = m_deferredCommits.front();
+
+    m_deferredCommits.pop_front();
+
+    if (m_deferredCommits.empty())
+    {
+        m_deferredKeys.clear();
+        m_deferredObjectIds.clear();
+        m_deferredReferences.clear();
+        m_deferredRemoveTypes.clear();
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("deferred %s on %s failed: %s, not committed",
+                sai_serialize_common_api(commit.m_api).c_str(),
+                sai_serialize_object_meta_key(commit.m_metaKey).c_str(),
+                sai_serialize_status(status).c_str());
+        return;
+    }
+
+    // commit may be completed while next request is being deferred
+
+    bool deferPostCommit = m_deferPostCommit;
+
+    m_deferPostCommit = false;
+
+    SaiAttributeList list(commit.m_metaKey.objecttype, commit.m_attributes, false);
+
+    switch (commit.m_api)
+    {
+        case SAI_COMMON_API_CREATE:
+            meta_generic_validation_post_create(commit.m_metaKey, commit.m_switchId, list.get_attr_count(), list.get_attr_list());
+            break;
+
+        case SAI_COMMON_API_REMOVE:
+            meta_generic_validation_post_remove(commit.m_metaKey);
+            break;
+
+        case SAI_COMMON_API_SET:
+            meta_generic_validation_post_set(commit.m_metaKey, list.get_attr_list());
+            break;
+
+        default:
+            SWSS_LOG_THROW("api %s can't be deferred", sai_serialize_common_api(commit.m_api).c_str());
+    }
+
+    m_deferPostCommit = deferPostCommit;
+}
+
+void Meta::flushDeferredCommits()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_deferredCommits.empty())
+    {
+        return;
+    }
+
+    if (!m_deferredCommitFlush)
+    {
+        SWSS_LOG_THROW("%zu deferred commits, but flush function is not set", m_deferredCommits.size());
+    }
+
+    m_deferredCommitFlush();
+
+    if (m_deferredCommits.size())
+    {
+        SWSS_LOG_THROW("%zu deferred commits not completed after flush", m_deferredCommits.size());
+    }
+}
+
+void Meta::flushDeferredCommitsIfNeeded(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_deferredCommits.empty())
+    {
+        return;
+    }
+
+    auto info = sai_metadata_get_object_type_info(meta_key.objecttype);
+
+    if (info == NULL)
+    {
+        return;
+    }
+
+    bool create = !info->isnonobjectid && meta_key.objectkey.key.object_id == SAI_NULL_OBJECT_ID;
+
+    // object created after remove of the same type may reuse its key attributes
+
+    bool needed = create
+        ? m_deferredRemoveTypes.find(meta_key.objecttype) != m_deferredRemoveTypes.end()
+        : m_deferredKeys.find(sai_serialize_object_meta_key(meta_key)) != m_deferredKeys.end();
+
+    std::vector<sai_object_id_t> oids;
+
+    getMetaKeyOids(meta_key, oids);
+
+    for (uint32_t idx = 0; idx < attr_count && attr_list; idx++)
+    {
+        getAttrOids(meta_key.objecttype, &attr_list[idx], oids);
+    }
+
+    for (auto oid: oids)
+    {
+        needed |= m_deferredObjectIds.find(oid) != m_deferredObjectIds.end();
+    }
+
+    if (needed)
+    {
+        SWSS_LOG_INFO("%s depends on deferred commits, flushing %zu",
+                sai_serialize_object_meta_key(meta_key).c_str(),
+                m_deferredCommits.size());
+
+        flushDeferredCommits();
+    }
+}
+
+void Meta::flushDeferredCommitsOnRemove(
+        _In_ const sai_object_meta_key_t& meta_key)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_deferredCommits.empty())
+    {
+        return;
+    }
+
+    auto info = sai_metadata_get_object_type_info(meta_key.objecttype);
+
+    if (info == NULL || info->isnonobjectid)
+    {
+        return; // entries are not referenced
+    }
+
+    // port remove checks reference count of port related objects too
+
+    sai_object_id_t oid = meta_key.objectkey.key.object_id;
+
+    if (meta_key.objecttype == SAI_OBJECT_TYPE_PORT ||
+            m_deferredReferences.find(oid) != m_deferredReferences.end())
+    {
+        SWSS_LOG_INFO("reference count of %s depends on deferred commits, flushing %zu",
+                sai_serialize_object_meta_key(meta_key).c_str(),
+                m_deferredCommits.size());
+
+        flushDeferredCommits();
+    }
+}
+
+void Meta::getMetaKeyOids(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _Inout_ std::vector<sai_object_id_t>& oids) const
+{
+    SWSS_LOG_ENTER();
+
+    auto info = sai_metadata_get_object_type_info(meta_key.objecttype);
+
+    if (!info->isnonobjectid)
+    {
+        if (meta_key.objectkey.key.object_id != SAI_NULL_OBJECT_ID)
+        {
+            oids.push_back(meta_key.objectkey.key.object_id);
+        }
+
+        return;
+    }
+
+    for (size_t j = 0; j < info->structmemberscount; ++j)
+    {
+        const sai_struct_member_info_t *m = info->structmembers[j];
+
+        if (m->membervaluetype == SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+        {
+            oids.push_back(m->getoid(&meta_key));
+        }
+    }
+}
+
+void Meta::getAttrOids(
+        _In_ sai_object_type_t object_type,
+        _In_ const sai_attribute_t* attr,
+        _Inout_ std::vector<sai_object_id_t>& oids)
+{
+    SWSS_LOG_ENTER();
+
+    auto md = sai_metadata_get_attr_metadata(object_type, attr->id);
+
+    if (md == NULL || !md->isoidattribute)
+    {
+        return;
+    }
+
+    const sai_attribute_value_t& value = attr->value;
+
+    const sai_object_list_t* list = NULL;
+
+    switch (md->attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            oids.push_back(value.oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            list = &value.objlist;
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+            oids.push_back(value.aclfield.data.oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+            list = &value.aclfield.data.objlist;
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+            oids.push_back(value.aclaction.parameter.oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+            list = &value.aclaction.parameter.objlist;
+            break;
+
+        default:
+            break;
+    }
+
+    if (list && list->list)
+    {
+        oids.insert(oids.end(), list->list, list->list + list->count);
+    }
+}
@@ -13,6 +13,8 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <deque>
+#include <functional>
 
 #define SAIREDIS_META_DECLARE_REMOVE_ENTRY(ot) \
     virtual sai_status_t remove(                                    \
@@ -224,6 +226,17 @@ namespace saimeta
                     _In_ uint32_t number_of_counters,
                     _In_ const sai_stat_id_t *counter_ids) override;
 
+            virtual sai_status_t bulkGetStats(
+                    _In_ sai_object_id_t switchId,
+                    _In_ sai_object_type_t object_type,
+                    _In_ uint32_t object_count,
+                    _In_ const sai_object_key_t *object_key,
+                    _In_ uint32_t number_of_counters,
+                    _In_ const sai_stat_id_t *counter_ids,
+                    _In_ sai_stats_mode_t mode,
+                    _Inout_ sai_status_t *object_statuses,
+                    _Out_ uint64_t *counters) override;
+
         public: // non QUAD API
 
             virtual sai_status_t flushFdbEntries(
@@ -268,6 +281,39 @@ namespace saimeta
 
             bool isEmpty();
 
+        public: // deferred commit
+
+            /**
+             * @brief Defer post commit of currently executed create, remove
+             * or set.
+             *
+             * Called by implementation which sent the request and returned
+             * success before its actual status is known. Local database is
+             * not updated until completeDeferredCommit is called for this
+             * request.
+             */
+            void deferPostCommit();
+
+            /**
+             * @brief Apply or drop oldest deferred commit.
+             *
+             * Must be called for each deferred request, in the same order as
+             * requests were deferred, with status returned by syncd.
+             */
+            void completeDeferredCommit(
+                    _In_ sai_status_t status);
+
+            /**
+             * @brief Set function which collects statuses of all deferred
+             * requests.
+             *
+             * It's called before validating request which depends on object
+             * changed by deferred request, since local database is not yet
+             * updated.
+             */
+            void setDeferredCommitFlush(
+                    _In_ std::function<void()> flush);
+
         public: // notifications
 
             void meta_sai_on_fdb_event(
@@ -551,6 +597,47 @@ namespace saimeta
             void clean_after_switch_remove(
                     _In_ sai_object_id_t switchId);
 
+        private: // deferred commit helpers
+
+            bool deferCommit(
+                    _In_ sai_common_api_t api,
+                    _In_ const sai_object_meta_key_t& meta_key,
+                    _In_ sai_object_id_t switch_id,
+                    _In_ uint32_t attr_count,
+                    _In_ const sai_attribute_t *attr_list);
+
+            void flushDeferredCommits();
+
+            /**
+             * @brief Flush deferred commits if object is changed by deferred
+             * request, or any object id referenced by request is created or
+             * removed by deferred request.
+             *
+             * Only reference count change of referenced object don't need
+             * flush, so entries using the same switch and virtual router can
+             * stay in flight.
+             */
+            void flushDeferredCommitsIfNeeded(
+                    _In_ const sai_object_meta_key_t& meta_key,
+                    _In_ uint32_t attr_count,
+                    _In_ const sai_attribute_t *attr_list);
+
+            /**
+             * @brief Flush deferred commits if reference count of removed
+             * object will change when they are committed.
+             */
+            void flushDeferredCommitsOnRemove(
+                    _In_ const sai_object_meta_key_t& meta_key);
+
+            void getMetaKeyOids(
+                    _In_ const sai_object_meta_key_t& meta_key,
+                    _Inout_ std::vector<sai_object_id_t>& oids) const;
+
+            static void getAttrOids(
+                    _In_ sai_object_type_t object_type,
+                    _In_ const sai_attribute_t* attr,
+                    _Inout_ std::vector<sai_object_id_t>& oids);
+
         private:
 
             std::shared_ptr<sairedis::SaiInterface> m_implementation;
@@ -589,6 +676,39 @@ namespace saimeta
         private: // warm boot
 
             bool m_warmBoot;
+
+        private: // deferred commit
+
+            struct DeferredCommit
+            {
+                sai_common_api_t m_api;
+
+                sai_object_meta_key_t m_metaKey;
+
+                sai_object_id_t m_switchId;
+
+                std::vector<swss::FieldValueTuple> m_attributes;
+            };
+
+            bool m_deferPostCommit;
+
+            std::deque<DeferredCommit> m_deferredCommits;
+
+            /**
+             * @brief Serialized keys of objects changed by deferred requests,
+             * object ids created or removed by deferred requests and object
+             * ids which reference count will change, cleared when all deferred
+             * commits are done.
+             */
+            std::set<std::string> m_deferredKeys;
+
+            std::set<sai_object_id_t> m_deferredObjectIds;
+
+            std::set<sai_object_id_t> m_deferredReferences;
+
+            std::set<sai_object_type_t> m_deferredRemoveTypes;
+
+            std::function<void()> m_deferredCommitFlush;
     };
 }
 
@@ -1988,6 +1988,7 @@ std::string sai_serialize(
 #define REDIS_COMMUNICATION_MODE_REDIS_ASYNC_STRING "redis_async"
 #define REDIS_COMMUNICATION_MODE_REDIS_SYNC_STRING  "redis_sync"
 #define REDIS_COMMUNICATION_MODE_ZMQ_SYNC_STRING    "zmq_sync"
+#define REDIS_COMMUNICATION_MODE_SHM_SYNC_STRING    "shm_sync"
 
 std::string sai_serialize_redis_communication_mode(
         _In_ sai_redis_communication_mode_t value)
@@ -2005,6 +2006,9 @@ std::string sai_serialize_redis_communication_mode(
         case SAI_REDIS_COMMUNICATION_MODE_ZMQ_SYNC:
             return REDIS_COMMUNICATION_MODE_ZMQ_SYNC_STRING;
 
+        case SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC:
+            return REDIS_COMMUNICATION_MODE_SHM_SYNC_STRING;
+
         default:
 
             SWSS_LOG_WARN("unknown value on sai_redis_communication_mode_t: %d", value);
@@ -3763,6 +3767,10 @@ void sai_deserialize_redis_communication_mode(
     {
         value = SAI_REDIS_COMMUNICATION_MODE_ZMQ_SYNC;
     }
+    else if (s == REDIS_COMMUNICATION_MODE_SHM_SYNC_STRING)
+    {
+        value = SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC;
+    }
     else
     {
         SWSS_LOG_THROW("enum '%s' not found in sai_redis_communication_mode_t", s.c_str());
@@ -4,6 +4,7 @@
 #include "sairediscommon.h"
 #include "VirtualObjectIdManager.h"
 #include "PerformanceIntervalTimer.h"
+#include "RecordingReader.h"
 
 #include "meta/sai_serialize.h"
 #include "meta/SaiAttributeList.h"
@@ -1894,7 +1895,9 @@ int SaiPlayer::replay()
 
     SWSS_LOG_NOTICE("using file: %s", filename.c_str());
 
-    std::ifstream infile(filename);
+    // text and binary recordings are supported, optionally compressed
+
+    sairedis::RecordingReader infile(filename);
 
     if (!infile.is_open())
     {
@@ -1904,7 +1907,7 @@ int SaiPlayer::replay()
 
     std::string line;
 
-    while (std::getline(infile, line))
+    while (infile.getline(line))
     {
         // std::cout << "processing " << line << std::endl;
 
@@ -1923,7 +1926,7 @@ int SaiPlayer::replay()
                     do
                     {
                         // this line may be notification, we need to skip
-                        if (!std::getline(infile, response))
+                        if (!infile.getline(response))
                         {
                             SWSS_LOG_THROW("failed to read next file from file, previous: %s", line.c_str());
                         }
@@ -1941,7 +1944,7 @@ int SaiPlayer::replay()
                     do
                     {
                         // this line may be notification, we need to skip
-                        if (!std::getline(infile, response))
+                        if (!infile.getline(response))
                         {
                             SWSS_LOG_THROW("failed to read next file from file, previous: %s", line.c_str());
                         }
@@ -2068,7 +2071,7 @@ int SaiPlayer::replay()
             do
             {
                 // this line may be notification, we need to skip
-                std::getline(infile, response);
+                infile.getline(response);
             }
             while (response[response.find_first_of("|") + 1] == 'n');
 
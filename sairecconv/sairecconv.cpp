@@ -0,0 +1,256 @@
+#include "RecordingReader.h"
+#include "BinaryRecordingEncoder.h"
+
+#include "swss/logger.h"
+
+#include <zlib.h>
+#include <getopt.h>
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+using namespace sairedis;
+
+typedef enum _OutputFormat
+{
+    OUTPUT_FORMAT_TEXT,
+
+    OUTPUT_FORMAT_BINARY,
+
+    OUTPUT_FORMAT_BINARY_COMPRESSED,
+
+} OutputFormat;
+
+struct CmdOptions
+{
+    OutputFormat format;
+
+    std::string input;
+
+    std::string output;
+};
+
+void printUsage()
+{
+    SWSS_LOG_ENTER();
+
+    std::cout << "Usage: sairecconv [-t] [-b] [-z] [-h] input [output]" << std::endl;
+    std::cout << "    Converts sairedis recording between text and binary format." << std::endl;
+    std::cout << "    Input format is detected automatically, when output is not" << std::endl;
+    std::cout << "    specified, text is printed to standard output." << std::endl;
+    std::cout << "    -t --text:" << std::endl;
+    std::cout << "        Convert to text format (default)" << std::endl;
+    std::cout << "    -b --binary:" << std::endl;
+    std::cout << "        Convert to binary format" << std::endl;
+    std::cout << "    -z --compressed:" << std::endl;
+    std::cout << "        Convert to gzip compressed binary format" << std::endl;
+    std::cout << "    -h --help:" << std::endl;
+    std::cout << "        Print out this message" << std::endl;
+}
+
+CmdOptions handleCmdLine(int argc, char **argv)
+{
+    SWSS_LOG_ENTER();
+
+    CmdOptions options;
+
+    options.format = OUTPUT_FORMAT_TEXT;
+
+    const char* const optstring = "tbzh";
+
+    while (true)
+    {
+        static struct option long_options[] =
+        {
+            { "text",           no_argument,       0, 't' },
+            { "binary",         no_argument,       0, 'b' },
+            { "compressed",     no_argument,       0, 'z' },
+            { "help",           no_argument,       0, 'h' },
+            { 0,                0,                 0,  0  }
+        };
+
+        int option_index = 0;
+
+        int c = getopt_long(argc, argv, optstring, long_options, &option_index);
+
+        if (c == -1)
+        {
+            break;
+        }
+
+        switch (c)
+        {
+            case 't':
+                options.format = OUTPUT_FORMAT_TEXT;
+                break;
+
+            case 'b':
+                options.format = OUTPUT_FORMAT_BINARY;
+                break;
+
+            case 'z':
+                options.format = OUTPUT_FORMAT_BINARY_COMPRESSED;
+                break;
+
+            case 'h':
+                printUsage();
+                exit(EXIT_SUCCESS);
+
+            case '?':
+                SWSS_LOG_WARN("unknown option %c", optopt);
+                printUsage();
+                exit(EXIT_FAILURE);
+
+            default:
+                SWSS_LOG_ERROR("getopt_long failure");
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (optind >= argc || argc - optind > 2)
+    {
+        printUsage();
+        exit(EXIT_FAILURE);
+    }
+
+    options.input = argv[optind];
+
+    if (optind + 1 < argc)
+    {
+        options.output = argv[optind + 1];
+    }
+
+    if (options.output.empty() && options.format != OUTPUT_FORMAT_TEXT)
+    {
+        std::cerr << "output file is required for binary format" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return options;
+}
+
+int convertToText(
+        _In_ RecordingReader& reader,
+        _In_ const std::string& output)
+{
+    SWSS_LOG_ENTER();
+
+    std::ofstream file;
+
+    if (output.size())
+    {
+        file.open(output);
+
+        if (!file.is_open())
+        {
+            std::cerr << "failed to open " << output << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ostream& out = output.size() ? file : std::cout;
+
+    std::string line;
+
+    while (reader.getline(line))
+    {
+        out << line << "\n";
+    }
+
+    out.flush();
+
+    return out.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int convertToBinary(
+        _In_ RecordingReader& reader,
+        _In_ const std::string& output,
+        _In_ bool compressed)
+{
+    SWSS_LOG_ENTER();
+
+    gzFile file = gzopen(output.c_str(), compressed ? "wb9" : "wbT");
+
+    if (file == nullptr)
+    {
+        std::cerr << "failed to open " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    BinaryRecordingEncoder encoder;
+
+    std::string buffer;
+
+    encoder.startSegment(buffer);
+
+    std::string line;
+
+    bool success = true;
+
+    while (reader.getline(line))
+    {
+        encoder.encode(line.data(), line.size(), buffer);
+
+        if (buffer.size() >= 64 * 1024)
+        {
+            success &= gzwrite(file, buffer.data(), (unsigned)buffer.size()) == (int)buffer.size();
+
+            buffer.clear();
+        }
+    }
+
+    if (buffer.size())
+    {
+        success &= gzwrite(file, buffer.data(), (unsigned)buffer.size()) == (int)buffer.size();
+    }
+
+    success &= gzclose(file) == Z_OK;
+
+    if (!success)
+    {
+        std::cerr << "failed to write " << output << std::endl;
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, char **argv)
+{
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    SWSS_LOG_ENTER();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+
+    auto options = handleCmdLine(argc, argv);
+
+    RecordingReader reader(options.input);
+
+    if (!reader.is_open())
+    {
+        std::cerr << "failed to open " << options.input << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        switch (options.format)
+        {
+            case OUTPUT_FORMAT_BINARY:
+                return convertToBinary(reader, options.output, false);
+
+            case OUTPUT_FORMAT_BINARY_COMPRESSED:
+                return convertToBinary(reader, options.output, true);
+
+            default:
+                return convertToText(reader, options.output);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "conversion failed: " << e.what() << std::endl;
+    }
+
+    return EXIT_FAILURE;
+}
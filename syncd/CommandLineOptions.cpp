@@ -1,4 +1,6 @@
 #include "CommandLineOptions.h"
+#include "RedisClient.h"
+#include "NotificationQueue.h"
 
 #include "meta/sai_serialize.h"
 
@@ -34,6 +36,20 @@ CommandLineOptions::CommandLineOptions()
 
     m_breakConfig = "";
 
+    m_fdbCoalesceWindowMs = 0;
+
+    m_flexCounterWorkers = 0;
+
+    m_flexCounterThreads = 0;
+
+    m_eventPipelineDepth = 0;
+
+    m_redisScanBatchSize = REDIS_CLIENT_DEFAULT_SCAN_BATCH_SIZE;
+
+    m_notificationQueueLimit = DEFAULT_NOTIFICATION_QUEUE_SIZE_LIMIT;
+
+    m_notificationLaneLimit = DEFAULT_NOTIFICATION_LANE_SIZE_LIMIT;
+
 #ifdef SAITHRIFT
 
     m_runRPCServer = false;
@@ -63,6 +79,19 @@ std::string CommandLineOptions::getCommandLineString() const
     ss << " GlobalContext=" << m_globalContext;
     ss << " ContextConfig=" << m_contextConfig;
     ss << " BreakConfig=" << m_breakConfig;
+    ss << " FdbCoalesceWindowMs=" << m_fdbCoalesceWindowMs;
+    ss << " FlexCounterWorkers=" << m_flexCounterWorkers;
+    ss << " FlexCounterThreads=" << m_flexCounterThreads;
+    ss << " EventPipelineDepth=" << m_eventPipelineDepth;
+    ss << " RedisScanBatchSize=" << m_redisScanBatchSize;
+    ss << " NotificationQueueLimit=" << m_notificationQueueLimit;
+    ss << " NotificationLaneLimit=" << m_notificationLaneLimit;
+    ss << " NotificationLaneWeights=";
+
+    for (size_t idx = 0; idx < m_notificationLaneWeights.size(); idx++)
+    {
+        ss << (idx ? "," : "") << m_notificationLaneWeights[idx];
+    }
 
 #ifdef SAITHRIFT
 
@@ -5,6 +5,7 @@
 #include "swss/sal.h"
 
 #include <string>
+#include <vector>
 
 #define STRING_SAI_START_TYPE_COLD_BOOT         "cold"
 #define STRING_SAI_START_TYPE_WARM_BOOT         "warm"
@@ -84,6 +85,56 @@ namespace syncd
 
             std::string m_breakConfig;
 
+            /**
+             * FDB events coalescing window in milliseconds, multiple events
+             * for the same FDB entry received during window are collapsed
+             * into single event. Zero disables coalescing.
+             */
+            uint32_t m_fdbCoalesceWindowMs;
+
+            /**
+             * Number of worker threads shared by all flex counter groups to
+             * collect counters in parallel. Zero or one keeps collection on
+             * group thread.
+             */
+            uint32_t m_flexCounterWorkers;
+
+            /**
+             * Number of threads polling all flex counter groups using common
+             * scheduler. Zero keeps thread per flex counter group.
+             */
+            uint32_t m_flexCounterThreads;
+
+            /**
+             * Number of ASIC channel events popped ahead and decoded on
+             * separate thread while previous events are executed. Zero
+             * disables pipelining.
+             */
+            uint32_t m_eventPipelineDepth;
+
+            /**
+             * Number of keys requested by single SCAN call and read by
+             * pipelined HGETALL when ASIC state is loaded from redis.
+             */
+            uint32_t m_redisScanBatchSize;
+
+            /**
+             * Size limit of FDB notification lane.
+             */
+            uint32_t m_notificationQueueLimit;
+
+            /**
+             * Size limit of each non FDB notification lane.
+             */
+            uint32_t m_notificationLaneLimit;
+
+            /**
+             * Weights of notification lanes in class priority order, when
+             * set, lanes are dequeued by weighted policy instead of strict
+             * priority.
+             */
+            std::vector<uint32_t> m_notificationLaneWeights;
+
 #ifdef SAITHRIFT
             bool m_runRPCServer;
             std::string m_portMapFile;
@@ -1,4 +1,6 @@
 #include "CommandLineOptionsParser.h"
+#include "RedisClient.h"
+#include "NotificationQueue.h"
 
 #include "meta/sai_serialize.h"
 
@@ -7,6 +9,7 @@
 #include <getopt.h>
 
 #include <iostream>
+#include <sstream>
 
 using namespace syncd;
 
@@ -19,9 +22,9 @@ std::shared_ptr<CommandLineOptions> CommandLineOptionsParser::parseCommandLine(
     auto options = std::make_shared<CommandLineOptions>();
 
 #ifdef SAITHRIFT
-    const char* const optstring = "dp:t:g:x:b:uSUCsz:lrm:h";
+    const char* const optstring = "dp:t:g:x:b:w:j:T:e:B:Q:L:N:uSUCsz:lrm:h";
 #else
-    const char* const optstring = "dp:t:g:x:b:uSUCsz:lh";
+    const char* const optstring = "dp:t:g:x:b:w:j:T:e:B:Q:L:N:uSUCsz:lh";
 #endif // SAITHRIFT
 
     while (true)
@@ -41,6 +44,14 @@ std::shared_ptr<CommandLineOptions> CommandLineOptionsParser::parseCommandLine(
             { "globalContext",           required_argument, 0, 'g' },
             { "contextContig",           required_argument, 0, 'x' },
             { "breakConfig",             required_argument, 0, 'b' },
+            { "fdbCoalesceWindow",       required_argument, 0, 'w' },
+            { "flexCounterWorkers",      required_argument, 0, 'j' },
+            { "flexCounterThreads",      required_argument, 0, 'T' },
+            { "eventPipelineDepth",      required_argument, 0, 'e' },
+            { "redisScanBatchSize",      required_argument, 0, 'B' },
+            { "notificationQueueLimit",  required_argument, 0, 'Q' },
+            { "notificationLaneLimit",   required_argument, 0, 'L' },
+            { "notificationLaneWeights", required_argument, 0, 'N' },
 #ifdef SAITHRIFT
             { "rpcserver",               no_argument,       0, 'r' },
             { "portmap",                 required_argument, 0, 'm' },
@@ -119,6 +130,54 @@ std::shared_ptr<CommandLineOptions> CommandLineOptionsParser::parseCommandLine(
                 options->m_breakConfig = std::string(optarg);
                 break;
 
+            case 'w':
+                options->m_fdbCoalesceWindowMs = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'j':
+                options->m_flexCounterWorkers = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'T':
+                options->m_flexCounterThreads = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'e':
+                options->m_eventPipelineDepth = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'B':
+                options->m_redisScanBatchSize = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'Q':
+                options->m_notificationQueueLimit = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'L':
+                options->m_notificationLaneLimit = (uint32_t)std::stoul(optarg);
+                break;
+
+            case 'N':
+                {
+                    std::stringstream ss(optarg);
+                    std::string weight;
+
+                    options->m_notificationLaneWeights.clear();
+
+                    while (std::getline(ss, weight, ','))
+                    {
+                        options->m_notificationLaneWeights.push_back((uint32_t)std::stoul(weight));
+                    }
+
+                    if (options->m_notificationLaneWeights.size() != NOTIFICATION_CLASS_MAX)
+                    {
+                        SWSS_LOG_ERROR("expected %d notification lane weights, got '%s'", NOTIFICATION_CLASS_MAX, optarg);
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                break;
+
 #ifdef SAITHRIFT
             case 'r':
                 options->m_runRPCServer = true;
@@ -151,9 +210,9 @@ void CommandLineOptionsParser::printUsage()
     SWSS_LOG_ENTER();
 
 #ifdef SAITHRIFT
-    std::cout << "Usage: syncd [-d] [-p profile] [-t type] [-u] [-S] [-U] [-C] [-s] [-z mode] [-l] [-g idx] [-x contextConfig] [-b breakConfig] [-r] [-m portmap] [-h]" << std::endl;
+    std::cout << "Usage: syncd [-d] [-p profile] [-t type] [-u] [-S] [-U] [-C] [-s] [-z mode] [-l] [-g idx] [-x contextConfig] [-b breakConfig] [-w ms] [-j workers] [-T threads] [-e depth] [-B size] [-Q size] [-L size] [-N weights] [-r] [-m portmap] [-h]" << std::endl;
 #else
-    std::cout << "Usage: syncd [-d] [-p profile] [-t type] [-u] [-S] [-U] [-C] [-s] [-z mode] [-l] [-g idx] [-x contextConfig] [-b breakConfig] [-h]" << std::endl;
+    std::cout << "Usage: syncd [-d] [-p profile] [-t type] [-u] [-S] [-U] [-C] [-s] [-z mode] [-l] [-g idx] [-x contextConfig] [-b breakConfig] [-w ms] [-j workers] [-T threads] [-e depth] [-B size] [-Q size] [-L size] [-N weights] [-h]" << std::endl;
 #endif // SAITHRIFT
 
     std::cout << "    -d --diag" << std::endl;
@@ -173,7 +232,7 @@ void CommandLineOptionsParser::printUsage()
     std::cout << "    -s --syncMode" << std::endl;
     std::cout << "        Enable synchronous mode (depreacated, use -z)" << std::endl;
     std::cout << "    -z --redisCommunicationMode" << std::endl;
-    std::cout << "        Redis communication mode (redis_async|redis_sync|zmq_sync), default: redis_async" << std::endl;
+    std::cout << "        Redis communication mode (redis_async|redis_sync|zmq_sync|shm_sync), default: redis_async" << std::endl;
     std::cout << "    -l --enableBulk" << std::endl;
     std::cout << "        Enable SAI Bulk support" << std::endl;
     std::cout << "    -g --globalContext" << std::endl;
@@ -182,6 +241,22 @@ void CommandLineOptionsParser::printUsage()
     std::cout << "        Context configuration file" << std::endl;
     std::cout << "    -b --breakConfig" << std::endl;
     std::cout << "        Comparison logic 'break before make' configuration file" << std::endl;
+    std::cout << "    -w --fdbCoalesceWindow ms" << std::endl;
+    std::cout << "        Coalesce FDB events for the same entry received within window, default: 0 (disabled)" << std::endl;
+    std::cout << "    -j --flexCounterWorkers workers" << std::endl;
+    std::cout << "        Number of threads shared by flex counter groups to collect counters in parallel, default: 0 (disabled)" << std::endl;
+    std::cout << "    -T --flexCounterThreads threads" << std::endl;
+    std::cout << "        Number of threads polling all flex counter groups by common scheduler, default: 0 (thread per group)" << std::endl;
+    std::cout << "    -e --eventPipelineDepth depth" << std::endl;
+    std::cout << "        Number of events decoded ahead while previous event is executed, default: 0 (disabled)" << std::endl;
+    std::cout << "    -B --redisScanBatchSize size" << std::endl;
+    std::cout << "        Number of keys scanned and read at once when loading ASIC state from redis, default: " << REDIS_CLIENT_DEFAULT_SCAN_BATCH_SIZE << std::endl;
+    std::cout << "    -Q --notificationQueueLimit size" << std::endl;
+    std::cout << "        Size limit of FDB notification lane, default: " << DEFAULT_NOTIFICATION_QUEUE_SIZE_LIMIT << std::endl;
+    std::cout << "    -L --notificationLaneLimit size" << std::endl;
+    std::cout << "        Size limit of each non FDB notification lane, default: " << DEFAULT_NOTIFICATION_LANE_SIZE_LIMIT << std::endl;
+    std::cout << "    -N --notificationLaneWeights switch,port_state,pfc_deadlock,other,fdb" << std::endl;
+    std::cout << "        Dequeue notification lanes by weights instead of strict priority, 0 drains lane in each round" << std::endl;
 
 #ifdef SAITHRIFT
 
@@ -0,0 +1,19 @@
+#include "CounterPlugin.h"
+#include "PortRatesCounterPlugin.h"
+
+#include "swss/logger.h"
+
+using namespace syncd;
+
+std::shared_ptr<CounterPlugin> CounterPlugin::create(
+        _In_ const std::string& name)
+{
+    SWSS_LOG_ENTER();
+
+    if (name == PORT_RATES_COUNTER_PLUGIN_NAME)
+    {
+        return std::make_shared<PortRatesCounterPlugin>();
+    }
+
+    return nullptr;
+}
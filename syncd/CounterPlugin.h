@@ -0,0 +1,93 @@
+#pragma once
+
+extern "C" {
+#include <sai.h>
+}
+
+#include "swss/table.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Prefix of native plugin name in flex counter plugin fields, other
+ * values are Lua script SHAs.
+ */
+#define NATIVE_COUNTER_PLUGIN_PREFIX "native:"
+
+namespace syncd
+{
+    /**
+     * @brief Native counter plugin.
+     *
+     * In process alternative to Lua counter plugins. Plugin is run by flex
+     * counter group after each poll on values just collected in memory, so
+     * counters don't need to be read back from COUNTERS_DB, and results are
+     * written by the same pipeline as counters.
+     */
+    class CounterPlugin
+    {
+        public:
+
+            /**
+             * @brief Counters of single object collected in current cycle.
+             *
+             * Counter names are in fields of counters, stats have the same
+             * order. Pointers are valid only during process call, and
+             * counters pointer is changed when object counter list changes.
+             */
+            struct Object
+            {
+                sai_object_id_t vid;
+
+                const std::string *key;
+
+                const std::vector<swss::FieldValueTuple> *counters;
+
+                const std::vector<uint64_t> *stats;
+
+                /**
+                 * @brief False when object poll failed in current cycle,
+                 * stats are then stale.
+                 */
+                bool valid;
+            };
+
+        public:
+
+            CounterPlugin() = default;
+
+            virtual ~CounterPlugin() = default;
+
+        public:
+
+            /**
+             * @brief Table in COUNTERS_DB where results are written.
+             */
+            virtual const std::string& getTableName() const = 0;
+
+            /**
+             * @brief Process counters of all registered objects.
+             *
+             * @param objects Registered objects of plugin object type.
+             * @param now Time when counters were collected.
+             * @param results Entries to write, appended by plugin.
+             */
+            virtual void process(
+                    _In_ const std::vector<Object>& objects,
+                    _In_ std::chrono::steady_clock::time_point now,
+                    _Inout_ std::vector<swss::KeyOpFieldsValuesTuple>& results) = 0;
+
+        public:
+
+            /**
+             * @brief Create native plugin by name, without prefix.
+             *
+             * @return Plugin or nullptr if name is unknown.
+             */
+            static std::shared_ptr<CounterPlugin> create(
+                    _In_ const std::string& name);
+    };
+}
@@ -0,0 +1,241 @@
+#include "EventDecoder.h"
+
+#include "sairediscommon.h"
+
+#include "meta/sai_serialize.h"
+
+#include "swss/logger.h"
+#include "swss/tokenize.h"
+
+using namespace syncd;
+using namespace saimeta;
+
+DecodedEvent::DecodedEvent():
+    isQuad(false),
+    isBulk(false)
+{
+    SWSS_LOG_ENTER();
+
+    future = promise.get_future();
+}
+
+void DecodedEvent::wait()
+{
+    SWSS_LOG_ENTER();
+
+    future.get();
+}
+
+EventDecoder::EventDecoder():
+    m_run(true)
+{
+    SWSS_LOG_ENTER();
+
+    m_thread = std::make_shared<std::thread>(&EventDecoder::decoderThreadFunction, this);
+}
+
+EventDecoder::~EventDecoder()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_run = false;
+    }
+
+    m_cv.notify_all();
+
+    m_thread->join();
+}
+
+void EventDecoder::submit(
+        _In_ std::shared_ptr<DecodedEvent> event)
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_queue.push_back(event);
+    }
+
+    m_cv.notify_one();
+}
+
+void EventDecoder::decoderThreadFunction()
+{
+    SWSS_LOG_ENTER();
+
+    while (true)
+    {
+        std::shared_ptr<DecodedEvent> event;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_cv.wait(lock, [this] { return !m_run || !m_queue.empty(); });
+
+            if (!m_run)
+            {
+                break;
+            }
+
+            event = m_queue.front();
+
+            m_queue.pop_front();
+        }
+
+        complete(*event);
+    }
+}
+
+void EventDecoder::complete(
+        _Inout_ DecodedEvent& event)
+{
+    SWSS_LOG_ENTER();
+
+    try
+    {
+        decode(event);
+
+        event.promise.set_value();
+    }
+    catch (...)
+    {
+        // exception is thrown to main thread when event is executed
+
+        event.promise.set_exception(std::current_exception());
+    }
+}
+
+bool EventDecoder::isQuadEvent(
+        _In_ const std::string& op)
+{
+    SWSS_LOG_ENTER();
+
+    return op == REDIS_ASIC_STATE_COMMAND_CREATE ||
+        op == REDIS_ASIC_STATE_COMMAND_REMOVE ||
+        op == REDIS_ASIC_STATE_COMMAND_SET ||
+        op == REDIS_ASIC_STATE_COMMAND_GET;
+}
+
+bool EventDecoder::isBulkQuadEvent(
+        _In_ const std::string& op)
+{
+    SWSS_LOG_ENTER();
+
+    return op == REDIS_ASIC_STATE_COMMAND_BULK_CREATE ||
+        op == REDIS_ASIC_STATE_COMMAND_BULK_REMOVE ||
+        op == REDIS_ASIC_STATE_COMMAND_BULK_SET;
+}
+
+void EventDecoder::decode(
+        _Inout_ DecodedEvent& event)
+{
+    SWSS_LOG_ENTER();
+
+    auto& key = kfvKey(event.kco);
+    auto& op = kfvOp(event.kco);
+
+    if (key.length() == 0)
+    {
+        return;
+    }
+
+    if (isQuadEvent(op))
+    {
+        decodeQuadEvent(event.kco, event.quad);
+
+        event.isQuad = true;
+    }
+    else if (isBulkQuadEvent(op))
+    {
+        decodeBulkQuadEvent(event.kco, event.bulk);
+
+        event.isBulk = true;
+    }
+}
+
+void EventDecoder::decodeQuadEvent(
+        _In_ const swss::KeyOpFieldsValuesTuple& kco,
+        _Out_ DecodedQuadEvent& decoded)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string& key = kfvKey(kco);
+
+    decoded.strObjectId = key.substr(key.find(":") + 1);
+
+    sai_deserialize_object_meta_key(key, decoded.metaKey);
+
+    if (!sai_metadata_is_object_type_valid(decoded.metaKey.objecttype))
+    {
+        SWSS_LOG_THROW("invalid object type %s", key.c_str());
+    }
+
+    auto& values = kfvFieldsValues(kco);
+
+    for (auto& v: values)
+    {
+        SWSS_LOG_DEBUG("attr: %s: %s", fvField(v).c_str(), fvValue(v).c_str());
+    }
+
+    decoded.list = std::make_shared<SaiAttributeList>(decoded.metaKey.objecttype, values, false);
+}
+
+void EventDecoder::decodeBulkQuadEvent(
+        _In_ const swss::KeyOpFieldsValuesTuple& kco,
+        _Out_ DecodedBulkQuadEvent& decoded)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string& key = kfvKey(kco); // objectType:count
+
+    decoded.strObjectType = key.substr(0, key.find(":"));
+
+    sai_deserialize_object_type(decoded.strObjectType, decoded.objectType);
+
+    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
+
+    decoded.objectIds.clear();
+    decoded.strAttributes.clear();
+    decoded.attributes.clear();
+
+    // field = objectId
+    // value = attrid=attrvalue|...
+
+    for (const auto &fvt: values)
+    {
+        std::string strObjectId = fvField(fvt);
+        std::string joined = fvValue(fvt);
+
+        // decode values
+
+        auto v = swss::tokenize(joined, '|');
+
+        decoded.objectIds.push_back(strObjectId);
+
+        std::vector<swss::FieldValueTuple> entries; // attributes per object id
+
+        for (size_t i = 0; i < v.size(); ++i)
+        {
+            const std::string item = v.at(i);
+
+            auto start = item.find_first_of("=");
+
+            auto field = item.substr(0, start);
+            auto value = item.substr(start + 1);
+
+            entries.emplace_back(field, value);
+        }
+
+        decoded.strAttributes.push_back(entries);
+
+        // since now we converted this to proper list, we can extract attributes
+
+        auto list = std::make_shared<SaiAttributeList>(decoded.objectType, entries, false);
+
+        decoded.attributes.push_back(list);
+    }
+}
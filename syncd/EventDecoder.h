@@ -0,0 +1,143 @@
+#pragma once
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "meta/SaiAttributeList.h"
+
+#include "swss/table.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace syncd
+{
+    /**
+     * @brief Quad event after key and attributes deserialization.
+     */
+    struct DecodedQuadEvent
+    {
+        sai_object_meta_key_t metaKey;
+
+        std::string strObjectId;
+
+        std::shared_ptr<saimeta::SaiAttributeList> list;
+    };
+
+    /**
+     * @brief Bulk quad event after object ids and attributes
+     * deserialization.
+     */
+    struct DecodedBulkQuadEvent
+    {
+        std::string strObjectType;
+
+        sai_object_type_t objectType;
+
+        std::vector<std::string> objectIds;
+
+        std::vector<std::vector<swss::FieldValueTuple>> strAttributes;
+
+        std::vector<std::shared_ptr<saimeta::SaiAttributeList>> attributes;
+    };
+
+    /**
+     * @brief ASIC channel event decoded ahead of execution.
+     */
+    struct DecodedEvent
+    {
+        DecodedEvent();
+
+        /**
+         * @brief Wait until event is decoded, rethrows decode exception.
+         */
+        void wait();
+
+        swss::KeyOpFieldsValuesTuple kco;
+
+        bool isQuad;
+
+        bool isBulk;
+
+        DecodedQuadEvent quad;
+
+        DecodedBulkQuadEvent bulk;
+
+        std::promise<void> promise;
+
+        std::future<void> future;
+    };
+
+    /**
+     * @brief Event decoder.
+     *
+     * Deserializes quad and bulk quad events on own thread, so parsing of
+     * next events overlaps with vendor call of current event. Events are
+     * decoded in submit order, other event types are passed as is.
+     */
+    class EventDecoder
+    {
+        private:
+
+            EventDecoder(const EventDecoder&) = delete;
+
+        public:
+
+            EventDecoder();
+
+            virtual ~EventDecoder();
+
+        public:
+
+            void submit(
+                    _In_ std::shared_ptr<DecodedEvent> event);
+
+        public:
+
+            static bool isQuadEvent(
+                    _In_ const std::string& op);
+
+            static bool isBulkQuadEvent(
+                    _In_ const std::string& op);
+
+            /**
+             * @brief Decode event on caller thread and make result
+             * available to DecodedEvent::wait.
+             */
+            static void complete(
+                    _Inout_ DecodedEvent& event);
+
+            static void decode(
+                    _Inout_ DecodedEvent& event);
+
+            static void decodeQuadEvent(
+                    _In_ const swss::KeyOpFieldsValuesTuple& kco,
+                    _Out_ DecodedQuadEvent& decoded);
+
+            static void decodeBulkQuadEvent(
+                    _In_ const swss::KeyOpFieldsValuesTuple& kco,
+                    _Out_ DecodedBulkQuadEvent& decoded);
+
+        private:
+
+            void decoderThreadFunction();
+
+        private:
+
+            std::mutex m_mutex;
+
+            std::condition_variable m_cv;
+
+            std::deque<std::shared_ptr<DecodedEvent>> m_queue;
+
+            bool m_run;
+
+            std::shared_ptr<std::thread> m_thread;
+    };
+}
@@ -0,0 +1,192 @@
+#include "FdbEventCoalescer.h"
+
+#include "swss/logger.h"
+
+using namespace syncd;
+
+FdbEventCoalescer::FdbEventCoalescer():
+    m_windowMs(0),
+    m_suppressedCount(0)
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+void FdbEventCoalescer::setWindow(
+        _In_ uint32_t windowMs)
+{
+    SWSS_LOG_ENTER();
+
+    m_windowMs = windowMs;
+}
+
+uint32_t FdbEventCoalescer::getWindow() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_windowMs;
+}
+
+bool FdbEventCoalescer::isEnabled() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_windowMs != 0;
+}
+
+bool FdbEventCoalescer::Key::operator==(
+        _In_ const Key& other) const
+{
+    SWSS_LOG_ENTER();
+
+    return switchId == other.switchId && bvId == other.bvId && mac == other.mac;
+}
+
+size_t FdbEventCoalescer::KeyHash::operator()(
+        _In_ const Key& key) const
+{
+    SWSS_LOG_ENTER();
+
+    return std::hash<uint64_t>()(key.mac ^ (key.bvId * 31) ^ (key.switchId * 131));
+}
+
+FdbEventCoalescer::Key FdbEventCoalescer::getKey(
+        _In_ const sai_fdb_entry_t& fdbEntry)
+{
+    SWSS_LOG_ENTER();
+
+    Key key;
+
+    key.switchId = fdbEntry.switch_id;
+    key.bvId = fdbEntry.bv_id;
+    key.mac = 0;
+
+    for (size_t idx = 0; idx < sizeof(sai_mac_t); idx++)
+    {
+        key.mac = (key.mac << 8) | fdbEntry.mac_address[idx];
+    }
+
+    return key;
+}
+
+void FdbEventCoalescer::add(
+        _In_ const sai_fdb_event_notification_data_t& data)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_entries.empty())
+    {
+        m_windowStart = std::chrono::steady_clock::now();
+    }
+
+    auto key = getKey(data.fdb_entry);
+
+    auto it = m_index.find(key);
+
+    if (it == m_index.end())
+    {
+        m_index[key] = m_entries.size();
+
+        m_entries.emplace_back();
+
+        auto& entry = m_entries.back();
+
+        entry.event.data = data;
+        entry.event.attrs.assign(data.attr, data.attr + data.attr_count);
+        entry.firstEventType = data.event_type;
+        entry.cancelled = false;
+
+        return;
+    }
+
+    auto& entry = m_entries[it->second];
+
+    m_suppressedCount++;
+
+    if (entry.firstEventType == SAI_FDB_EVENT_LEARNED && data.event_type == SAI_FDB_EVENT_AGED)
+    {
+        // listeners never got learned event, so there is nothing to age,
+        // next event for this entry starts from scratch
+
+        m_suppressedCount++;
+
+        entry.cancelled = true;
+
+        m_index.erase(it);
+
+        return;
+    }
+
+    // entry learned in this window and then moved is still new entry for
+    // listeners, so it's reported as learned on final port
+
+    auto eventType = data.event_type;
+
+    if (entry.event.data.event_type == SAI_FDB_EVENT_LEARNED && eventType == SAI_FDB_EVENT_MOVE)
+    {
+        eventType = SAI_FDB_EVENT_LEARNED;
+    }
+
+    entry.event.data = data;
+    entry.event.data.event_type = eventType;
+
+    // all FDB entry attributes are primitive, so shallow copy is enough
+
+    entry.event.attrs.assign(data.attr, data.attr + data.attr_count);
+}
+
+bool FdbEventCoalescer::empty() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_entries.empty();
+}
+
+std::chrono::milliseconds FdbEventCoalescer::getTimeToExpire() const
+{
+    SWSS_LOG_ENTER();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_windowStart);
+
+    auto window = std::chrono::milliseconds(m_windowMs);
+
+    return elapsed >= window ? std::chrono::milliseconds(0) : window - elapsed;
+}
+
+std::vector<FdbEventCoalescer::Event> FdbEventCoalescer::take()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<Event> events;
+
+    events.reserve(m_entries.size());
+
+    for (auto& entry: m_entries)
+    {
+        if (!entry.cancelled)
+        {
+            events.push_back(std::move(entry.event));
+        }
+    }
+
+    m_entries.clear();
+
+    m_index.clear();
+
+    for (auto& event: events)
+    {
+        event.data.attr_count = (uint32_t)event.attrs.size();
+        event.data.attr = event.attrs.data();
+    }
+
+    return events;
+}
+
+uint64_t FdbEventCoalescer::getSuppressedCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_suppressedCount;
+}
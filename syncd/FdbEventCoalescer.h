@@ -0,0 +1,126 @@
+#pragma once
+
+extern "C" {
+#include "saimetadata.h"
+}
+
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+
+namespace syncd
+{
+    /**
+     * @brief FDB event coalescer.
+     *
+     * Collects FDB events during coalescing window, multiple events for the
+     * same FDB entry (switch, bv_id, mac) are collapsed into single event
+     * with entry final state. Events are kept in order of their first
+     * occurrence in window. Entry learned and aged in the same window was
+     * never announced, so both events are dropped.
+     *
+     * Flush events must not be added, caller is expected to take all pending
+     * events before processing flush event, to keep order between them.
+     */
+    class FdbEventCoalescer
+    {
+        public:
+
+            struct Event
+            {
+                sai_fdb_event_notification_data_t data;
+
+                std::vector<sai_attribute_t> attrs;
+            };
+
+        public:
+
+            FdbEventCoalescer();
+
+            virtual ~FdbEventCoalescer() = default;
+
+        public:
+
+            void setWindow(
+                    _In_ uint32_t windowMs);
+
+            uint32_t getWindow() const;
+
+            bool isEnabled() const;
+
+            /**
+             * @brief Add single FDB event (not flush) to pending events.
+             */
+            void add(
+                    _In_ const sai_fdb_event_notification_data_t& data);
+
+            bool empty() const;
+
+            /**
+             * @brief Get time left until coalescing window of pending events
+             * expires, zero when expired.
+             */
+            std::chrono::milliseconds getTimeToExpire() const;
+
+            /**
+             * @brief Take all pending events, attribute pointers in returned
+             * events point to events attrs vectors.
+             *
+             * Can return no events, when all pending events cancelled each
+             * other.
+             */
+            std::vector<Event> take();
+
+            /**
+             * @brief Number of events which were collapsed into other events.
+             */
+            uint64_t getSuppressedCount() const;
+
+        private:
+
+            struct Key
+            {
+                sai_object_id_t switchId;
+
+                sai_object_id_t bvId;
+
+                uint64_t mac;
+
+                bool operator==(
+                        _In_ const Key& other) const;
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(
+                        _In_ const Key& key) const;
+            };
+
+            static Key getKey(
+                    _In_ const sai_fdb_entry_t& fdbEntry);
+
+            struct Entry
+            {
+                Event event;
+
+                /**
+                 * @brief Type of first event of this entry in window.
+                 */
+                sai_fdb_event_t firstEventType;
+
+                bool cancelled;
+            };
+
+        private:
+
+            uint32_t m_windowMs;
+
+            std::vector<Entry> m_entries;
+
+            std::unordered_map<Key, size_t, KeyHash> m_index;
+
+            std::chrono::steady_clock::time_point m_windowStart;
+
+            uint64_t m_suppressedCount;
+    };
+}
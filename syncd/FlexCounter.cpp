@@ -8,6 +8,9 @@
 #include "swss/tokenize.h"
 
 #include <inttypes.h>
+#include <string.h>
+
+#include <algorithm>
 
 using namespace syncd;
 
@@ -17,16 +20,39 @@ using namespace syncd;
 FlexCounter::FlexCounter(
         _In_ const std::string& instanceId,
         _In_ std::shared_ptr<sairedis::SaiInterface> vendorSai,
-        _In_ const std::string& dbCounters):
+        _In_ const std::string& dbCounters,
+        _In_ std::shared_ptr<FlexCounterWorkerPool> workerPool,
+        _In_ std::shared_ptr<FlexCounterScheduler> scheduler):
+    m_runFlexCounterThread(false),
     m_pollInterval(0),
     m_instanceId(instanceId),
     m_vendorSai(vendorSai),
-    m_dbCounters(dbCounters)
+    m_dbCounters(dbCounters),
+    m_workerPool(workerPool),
+    m_scheduler(scheduler),
+    m_deltaWrite(false),
+    m_fullRefreshCycles(DEFAULT_FULL_REFRESH_CYCLES),
+    m_cycleCount(0),
+    m_fullRefresh(true),
+    m_fullRefreshRequested(false),
+    m_registryGeneration(0),
+    m_registryDirty(false),
+    m_pollActive(false),
+    m_pollGeneration(0)
 {
     SWSS_LOG_ENTER();
 
     m_enable = false;
     m_isDiscarded = false;
+    m_statsMode = SAI_STATS_MODE_READ;
+
+    publishRegistry();
+
+    if (m_scheduler)
+    {
+        m_scheduler->addGroup(this, m_instanceId);
+        return;
+    }
 
     startFlexCounterThread();
 }
@@ -35,9 +61,140 @@ FlexCounter::~FlexCounter(void)
 {
     SWSS_LOG_ENTER();
 
+    if (m_scheduler)
+    {
+        m_scheduler->removeGroup(this);
+        return;
+    }
+
     endFlexCounterThread();
 }
 
+void FlexCounter::CounterValues::init(
+        _In_ sai_object_type_t objectType,
+        _In_ sai_object_id_t vid,
+        _In_ uint32_t counterCount,
+        _In_ const sai_stat_id_t *counterIds)
+{
+    SWSS_LOG_ENTER();
+
+    auto info = sai_metadata_get_object_type_info(objectType);
+
+    key = sai_serialize_object_id(vid);
+
+    values.clear();
+
+    for (uint32_t idx = 0; idx < counterCount; idx++)
+    {
+        values.emplace_back(sai_serialize_enum(counterIds[idx], info->statenum), "");
+    }
+
+    stats.assign(counterCount, 0);
+
+    lastStats.assign(counterCount, 0);
+
+    lastStatsValid = false;
+    updated = false;
+
+    changes.clear();
+    changeIndexes.clear();
+}
+
+const std::vector<swss::FieldValueTuple>& FlexCounter::CounterValues::update(
+        _In_ bool fullRefresh)
+{
+    SWSS_LOG_ENTER();
+
+    // value strings keep their capacity between polls, so formatting in
+    // place don't allocate
+
+    char buffer[24];
+
+    char *end = buffer + sizeof(buffer);
+
+    bool delta = !fullRefresh && lastStatsValid;
+
+    size_t count = 0;
+
+    for (size_t idx = 0; idx < stats.size(); idx++)
+    {
+        uint64_t value = stats[idx];
+
+        if (delta && value == lastStats[idx])
+        {
+            continue;
+        }
+
+        char *ptr = end;
+
+        do
+        {
+            *--ptr = (char)('0' + value % 10);
+
+            value /= 10;
+        }
+        while (value);
+
+        if (!delta)
+        {
+            fvValue(values[idx]).assign(ptr, end - ptr);
+            continue;
+        }
+
+        // changed value is formatted straight into change slot, counter
+        // name is copied only when slot was used by other counter last time,
+        // usually the same counters change on every poll
+
+        if (count == changes.size())
+        {
+            changes.emplace_back();
+            changeIndexes.push_back(stats.size());
+        }
+
+        auto& change = changes[count];
+
+        if (changeIndexes[count] != idx)
+        {
+            fvField(change) = fvField(values[idx]);
+
+            changeIndexes[count] = idx;
+        }
+
+        fvValue(change).assign(ptr, end - ptr);
+
+        count++;
+    }
+
+    if (delta)
+    {
+        changes.resize(count);
+        changeIndexes.resize(count);
+    }
+
+    lastStats = stats;
+    lastStatsValid = true;
+
+    updated = true;
+
+    return delta ? changes : values;
+}
+
+FlexCounter::ObjectStats::ObjectStats(
+        _In_ sai_object_id_t objectVid,
+        _In_ sai_object_id_t objectRid,
+        _In_ uint32_t count,
+        _In_ const sai_stat_id_t *ids,
+        _Inout_ CounterValues& values):
+    vid(objectVid),
+    rid(objectRid),
+    counterCount(count),
+    counterIds(ids),
+    status(SAI_STATUS_FAILURE),
+    counterValues(&values)
+{
+    SWSS_LOG_ENTER();
+}
+
 FlexCounter::PortCounterIds::PortCounterIds(
         _In_ sai_object_id_t port,
         _In_ const std::vector<sai_port_stat_t> &portIds):
@@ -164,6 +321,45 @@ void FlexCounter::setStatsMode(
     }
 }
 
+void FlexCounter::setDeltaWrite(
+        _In_ const std::string& status)
+{
+    SWSS_LOG_ENTER();
+
+    if (status == "enable")
+    {
+        m_deltaWrite = true;
+    }
+    else if (status == "disable")
+    {
+        m_deltaWrite = false;
+    }
+    else
+    {
+        SWSS_LOG_WARN("Input value %s is not supported for Flex counter delta write, enter enable or disable", status.c_str());
+        return;
+    }
+
+    // next cycle writes all values, so DB is consistent with snapshots
+
+    m_fullRefreshRequested = true;
+}
+
+void FlexCounter::setFullRefreshCycles(
+        _In_ uint32_t cycles)
+{
+    SWSS_LOG_ENTER();
+
+    if (cycles == 0)
+    {
+        SWSS_LOG_WARN("Flex counter full refresh cycles must be positive, using %d", DEFAULT_FULL_REFRESH_CYCLES);
+
+        cycles = DEFAULT_FULL_REFRESH_CYCLES;
+    }
+
+    m_fullRefreshCycles = cycles;
+}
+
 void FlexCounter::addCollectCountersHandler(const std::string &key, const collect_counters_handler_t &handler)
 {
     SWSS_LOG_ENTER();
@@ -209,17 +405,18 @@ void FlexCounter::setPortCounterList(
         return;
     }
 
-    auto it = m_portCounterIdsMap.find(portVid);
+    auto portCounterIds = std::make_shared<PortCounterIds>(portId, supportedIds);
 
-    if (it != m_portCounterIdsMap.end())
-    {
-        it->second->portCounterIds = supportedIds;
-        return;
-    }
+    portCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_PORT,
+            portVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
 
-    auto portCounterIds = std::make_shared<PortCounterIds>(portId, supportedIds);
+    // existing object may be used by poll cycle, so it's replaced, not
+    // updated in place
 
-    m_portCounterIdsMap.emplace(portVid, portCounterIds);
+    m_portCounterIdsMap[portVid] = portCounterIds;
 
     addCollectCountersHandler(PORT_COUNTER_ID_LIST, &FlexCounter::collectPortCounters);
 }
@@ -241,17 +438,15 @@ void FlexCounter::setPortDebugCounterList(
         return;
     }
 
-    auto it = m_portDebugCounterIdsMap.find(portVid);
-
-    if (it != m_portDebugCounterIdsMap.end())
-    {
-        it->second->portCounterIds = supportedIds;
-        return;
-    }
-
     auto portDebugCounterIds = std::make_shared<PortCounterIds>(portId, supportedIds);
 
-    m_portDebugCounterIdsMap.emplace(portVid, portDebugCounterIds);
+    portDebugCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_PORT,
+            portVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_portDebugCounterIdsMap[portVid] = portDebugCounterIds;
 
     addCollectCountersHandler(PORT_DEBUG_COUNTER_ID_LIST, &FlexCounter::collectPortDebugCounters);
 }
@@ -297,17 +492,15 @@ void FlexCounter::setQueueCounterList(
         return;
     }
 
-    auto it = m_queueCounterIdsMap.find(queueVid);
-
-    if (it != m_queueCounterIdsMap.end())
-    {
-        it->second->queueCounterIds = supportedIds;
-        return;
-    }
-
     auto queueCounterIds = std::make_shared<QueueCounterIds>(queueRid, supportedIds);
 
-    m_queueCounterIdsMap.emplace(queueVid, queueCounterIds);
+    queueCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_QUEUE,
+            queueVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_queueCounterIdsMap[queueVid] = queueCounterIds;
 
     addCollectCountersHandler(QUEUE_COUNTER_ID_LIST, &FlexCounter::collectQueueCounters);
 }
@@ -319,17 +512,9 @@ void FlexCounter::setQueueAttrList(
 {
     SWSS_LOG_ENTER();
 
-    auto it = m_queueAttrIdsMap.find(queueVid);
-
-    if (it != m_queueAttrIdsMap.end())
-    {
-        it->second->queueAttrIds = attrIds;
-        return;
-    }
-
     auto queueAttrIds = std::make_shared<QueueAttrIds>(queueRid, attrIds);
 
-    m_queueAttrIdsMap.emplace(queueVid, queueAttrIds);
+    m_queueAttrIdsMap[queueVid] = queueAttrIds;
 
     addCollectCountersHandler(QUEUE_ATTR_ID_LIST, &FlexCounter::collectQueueAttrs);
 }
@@ -378,17 +563,15 @@ void FlexCounter::setPriorityGroupCounterList(
         return;
     }
 
-    auto it = m_priorityGroupCounterIdsMap.find(priorityGroupVid);
-
-    if (it != m_priorityGroupCounterIdsMap.end())
-    {
-        it->second->priorityGroupCounterIds = supportedIds;
-        return;
-    }
-
     auto priorityGroupCounterIds = std::make_shared<IngressPriorityGroupCounterIds>(priorityGroupRid, supportedIds);
 
-    m_priorityGroupCounterIdsMap.emplace(priorityGroupVid, priorityGroupCounterIds);
+    priorityGroupCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+            priorityGroupVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_priorityGroupCounterIdsMap[priorityGroupVid] = priorityGroupCounterIds;
 
     addCollectCountersHandler(PG_COUNTER_ID_LIST, &FlexCounter::collectPriorityGroupCounters);
 }
@@ -410,17 +593,15 @@ void FlexCounter::setSwitchDebugCounterList(
         return;
     }
 
-    auto it = m_switchDebugCounterIdsMap.find(switchVid);
-
-    if (it != m_switchDebugCounterIdsMap.end())
-    {
-        it->second->switchCounterIds = supportedIds;
-        return;
-    }
-
     auto switchDebugCounterIds = std::make_shared<SwitchCounterIds>(switchRid, supportedIds);
 
-    m_switchDebugCounterIdsMap.emplace(switchVid, switchDebugCounterIds);
+    switchDebugCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_SWITCH,
+            switchVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_switchDebugCounterIdsMap[switchVid] = switchDebugCounterIds;
 
     addCollectCountersHandler(SWITCH_DEBUG_COUNTER_ID_LIST, &FlexCounter::collectSwitchDebugCounters);
 }
@@ -432,17 +613,9 @@ void FlexCounter::setPriorityGroupAttrList(
 {
     SWSS_LOG_ENTER();
 
-    auto it = m_priorityGroupAttrIdsMap.find(priorityGroupVid);
-
-    if (it != m_priorityGroupAttrIdsMap.end())
-    {
-        it->second->priorityGroupAttrIds = attrIds;
-        return;
-    }
-
     auto priorityGroupAttrIds = std::make_shared<IngressPriorityGroupAttrIds>(priorityGroupRid, attrIds);
 
-    m_priorityGroupAttrIdsMap.emplace(priorityGroupVid, priorityGroupAttrIds);
+    m_priorityGroupAttrIdsMap[priorityGroupVid] = priorityGroupAttrIds;
 
     addCollectCountersHandler(PG_ATTR_ID_LIST, &FlexCounter::collectPriorityGroupAttrs);
 }
@@ -454,17 +627,9 @@ void FlexCounter::setMACsecSAAttrList(
 {
     SWSS_LOG_ENTER();
 
-    auto it = m_macsecSAAttrIdsMap.find(macsecSAVid);
-
-    if (it != m_macsecSAAttrIdsMap.end())
-    {
-        it->second->m_macsecSAAttrIds = attrIds;
-        return;
-    }
-
     auto macsecSAAttrIds = std::make_shared<MACsecSAAttrIds>(macsecSARid, attrIds);
 
-    m_macsecSAAttrIdsMap.emplace(macsecSAVid, macsecSAAttrIds);
+    m_macsecSAAttrIdsMap[macsecSAVid] = macsecSAAttrIds;
 
     addCollectCountersHandler(MACSEC_SA_ATTR_ID_LIST, &FlexCounter::collectMACsecSAAttrs);
 }
@@ -495,17 +660,15 @@ void FlexCounter::setRifCounterList(
         return;
     }
 
-    auto it = m_rifCounterIdsMap.find(rifVid);
-
-    if (it != m_rifCounterIdsMap.end())
-    {
-        it->second->rifCounterIds = supportedIds;
-        return;
-    }
-
     auto rifCounterIds = std::make_shared<RifCounterIds>(rifRid, supportedIds);
 
-    m_rifCounterIdsMap.emplace(rifVid, rifCounterIds);
+    rifCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+            rifVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_rifCounterIdsMap[rifVid] = rifCounterIds;
 
     addCollectCountersHandler(RIF_COUNTER_ID_LIST, &FlexCounter::collectRifCounters);
 }
@@ -552,17 +715,15 @@ void FlexCounter::setBufferPoolCounterList(
         return;
     }
 
-    auto it = m_bufferPoolCounterIdsMap.find(bufferPoolVid);
-
-    if (it != m_bufferPoolCounterIdsMap.end())
-    {
-        it->second->bufferPoolCounterIds = supportedIds;
-        return;
-    }
-
     auto bufferPoolCounterIds = std::make_shared<BufferPoolCounterIds>(bufferPoolId, supportedIds, bufferPoolStatsMode);
 
-    m_bufferPoolCounterIdsMap.emplace(bufferPoolVid, bufferPoolCounterIds);
+    bufferPoolCounterIds->counterValues.init(
+            SAI_OBJECT_TYPE_BUFFER_POOL,
+            bufferPoolVid,
+            static_cast<uint32_t>(supportedIds.size()),
+            (const sai_stat_id_t *)supportedIds.data());
+
+    m_bufferPoolCounterIdsMap[bufferPoolVid] = bufferPoolCounterIds;
 
     addCollectCountersHandler(BUFFER_POOL_COUNTER_ID_LIST, &FlexCounter::collectBufferPoolCounters);
 }
@@ -804,11 +965,52 @@ void FlexCounter::checkPluginRegistered(
     }
 }
 
+bool FlexCounter::addNativeCounterPlugin(
+        _In_ const std::string& name,
+        _Inout_ native_counter_plugin_map_t& plugins)
+{
+    SWSS_LOG_ENTER();
+
+    const size_t prefixLength = strlen(NATIVE_COUNTER_PLUGIN_PREFIX);
+
+    if (name.compare(0, prefixLength, NATIVE_COUNTER_PLUGIN_PREFIX) != 0)
+    {
+        return false;
+    }
+
+    auto pluginName = name.substr(prefixLength);
+
+    if (plugins.find(pluginName) != plugins.end())
+    {
+        SWSS_LOG_ERROR("Plugin %s already registered", name.c_str());
+        return true;
+    }
+
+    auto plugin = CounterPlugin::create(pluginName);
+
+    if (plugin == nullptr)
+    {
+        SWSS_LOG_ERROR("Native counter plugin %s is not supported", pluginName.c_str());
+        return true;
+    }
+
+    plugins[pluginName] = plugin;
+
+    SWSS_LOG_NOTICE("Native counter plugin %s registered", pluginName.c_str());
+
+    return true;
+}
+
 void FlexCounter::addPortCounterPlugin(
         _In_ const std::string& sha)
 {
     SWSS_LOG_ENTER();
 
+    if (addNativeCounterPlugin(sha, m_portNativePlugins))
+    {
+        return;
+    }
+
     checkPluginRegistered(sha);
 
     m_portPlugins.insert(sha);
@@ -821,6 +1023,11 @@ void FlexCounter::addRifCounterPlugin(
 {
     SWSS_LOG_ENTER();
 
+    if (addNativeCounterPlugin(sha, m_rifNativePlugins))
+    {
+        return;
+    }
+
     checkPluginRegistered(sha);
 
     m_rifPlugins.insert(sha);
@@ -833,6 +1040,11 @@ void FlexCounter::addQueueCounterPlugin(
 {
     SWSS_LOG_ENTER();
 
+    if (addNativeCounterPlugin(sha, m_queueNativePlugins))
+    {
+        return;
+    }
+
     checkPluginRegistered(sha);
 
     m_queuePlugins.insert(sha);
@@ -845,6 +1057,11 @@ void FlexCounter::addPriorityGroupCounterPlugin(
 {
     SWSS_LOG_ENTER();
 
+    if (addNativeCounterPlugin(sha, m_priorityGroupNativePlugins))
+    {
+        return;
+    }
+
     checkPluginRegistered(sha);
 
     m_priorityGroupPlugins.insert(sha);
@@ -857,6 +1074,11 @@ void FlexCounter::addBufferPoolCounterPlugin(
 {
     SWSS_LOG_ENTER();
 
+    if (addNativeCounterPlugin(sha, m_bufferPoolNativePlugins))
+    {
+        return;
+    }
+
     checkPluginRegistered(sha);
 
     m_bufferPoolPlugins.insert(sha);
@@ -876,7 +1098,15 @@ void FlexCounter::removeCounterPlugins()
     m_priorityGroupPlugins.clear();
     m_bufferPoolPlugins.clear();
 
+    m_queueNativePlugins.clear();
+    m_portNativePlugins.clear();
+    m_rifNativePlugins.clear();
+    m_priorityGroupNativePlugins.clear();
+    m_bufferPoolNativePlugins.clear();
+
     m_isDiscarded = true;
+
+    registryChanged();
 }
 
 void FlexCounter::addCounterPlugin(
@@ -907,6 +1137,14 @@ void FlexCounter::addCounterPlugin(
         {
             setStatsMode(value);
         }
+        else if (field == DELTA_WRITE_FIELD)
+        {
+            setDeltaWrite(value);
+        }
+        else if (field == FULL_REFRESH_CYCLES_FIELD)
+        {
+            setFullRefreshCycles((uint32_t)std::stoul(value));
+        }
         else if (field == QUEUE_PLUGIN_FIELD)
         {
             for (auto& sha: shaStrings)
@@ -948,8 +1186,10 @@ void FlexCounter::addCounterPlugin(
         }
     }
 
+    registryChanged();
+
     // notify thread to start polling
-    m_pollCond.notify_all();
+    notifyPoll();
 }
 
 bool FlexCounter::isEmpty()
@@ -992,7 +1232,12 @@ bool FlexCounter::allPluginsEmpty() const
            m_queuePlugins.empty() &&
            m_portPlugins.empty() &&
            m_rifPlugins.empty() &&
-           m_bufferPoolPlugins.empty();
+           m_bufferPoolPlugins.empty() &&
+           m_priorityGroupNativePlugins.empty() &&
+           m_queueNativePlugins.empty() &&
+           m_portNativePlugins.empty() &&
+           m_rifNativePlugins.empty() &&
+           m_bufferPoolNativePlugins.empty();
 }
 
 bool FlexCounter::isPortCounterSupported(sai_port_stat_t counter) const
@@ -1035,76 +1280,259 @@ bool FlexCounter::isBufferPoolCounterSupported(
 }
 
 void FlexCounter::collectCounters(
+        _In_ const CounterRegistry& registry,
         _In_ swss::Table &countersTable)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto &it : m_collectCountersHandlers)
+    if (m_fullRefreshRequested.exchange(false))
     {
-        (this->*(it.second))(countersTable);
+        m_cycleCount = 0;
+    }
+
+    m_fullRefresh = !registry.deltaWrite || (m_cycleCount % registry.fullRefreshCycles) == 0;
+
+    m_cycleCount++;
+
+    if (m_workerPool)
+    {
+        // workers read registry snapshot, which is not modified while it is
+        // held by this cycle
+
+        m_workerPool->run([this, &registry](size_t shardIndex, size_t shardCount, swss::Table& table) {
+                for (const auto &it : registry.collectCountersHandlers)
+                {
+                    (this->*(it.second))(registry, table, shardIndex, shardCount);
+                }
+        });
+
+        return;
+    }
+
+    for (const auto &it : registry.collectCountersHandlers)
+    {
+        (this->*(it.second))(registry, countersTable, 0, 1);
     }
 
     countersTable.flush();
 }
 
+bool FlexCounter::isBulkStatsSupported(
+        _In_ sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_bulkStatsMutex);
+
+    return m_bulkStatsUnsupportedObjectTypes.find(objectType) == m_bulkStatsUnsupportedObjectTypes.end();
+}
+
+void FlexCounter::getStatsPerObject(
+        _In_ sai_object_type_t objectType,
+        _Inout_ std::vector<ObjectStats>& objects)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &object: objects)
+    {
+        object.status = m_vendorSai->getStats(
+                objectType,
+                object.rid,
+                object.counterCount,
+                object.counterIds,
+                object.counterValues->stats.data());
+    }
+}
+
+void FlexCounter::getStatsBulk(
+        _In_ sai_object_type_t objectType,
+        _Inout_ std::vector<ObjectStats>& objects)
+{
+    SWSS_LOG_ENTER();
+
+    if (objects.empty())
+    {
+        return;
+    }
+
+    if (!isBulkStatsSupported(objectType))
+    {
+        getStatsPerObject(objectType, objects);
+        return;
+    }
+
+    // bulk call requires the same switch and counter list for all objects,
+    // usually there is only a few distinct groups
+
+    struct Group
+    {
+        sai_object_id_t switchVid;
+
+        const ObjectStats* first;
+
+        std::vector<size_t> indexes;
+    };
+
+    std::vector<Group> groups;
+
+    for (size_t idx = 0; idx < objects.size(); idx++)
+    {
+        const auto &object = objects[idx];
+
+        sai_object_id_t switchVid = VidManager::switchIdQuery(object.vid);
+
+        auto it = std::find_if(groups.begin(), groups.end(), [&](const Group& group) {
+                return group.switchVid == switchVid &&
+                    group.first->counterCount == object.counterCount &&
+                    std::equal(object.counterIds, object.counterIds + object.counterCount, group.first->counterIds);
+        });
+
+        if (it == groups.end())
+        {
+            groups.push_back(Group{switchVid, &object, {}});
+
+            it = groups.end() - 1;
+        }
+
+        it->indexes.push_back(idx);
+    }
+
+    for (const auto &group: groups)
+    {
+        uint32_t objectCount = static_cast<uint32_t>(group.indexes.size());
+        uint32_t counterCount = group.first->counterCount;
+
+        std::vector<sai_object_key_t> objectKeys(objectCount);
+        std::vector<sai_status_t> objectStatuses(objectCount, SAI_STATUS_FAILURE);
+        std::vector<uint64_t> counters((size_t)objectCount * counterCount);
+
+        for (uint32_t idx = 0; idx < objectCount; idx++)
+        {
+            objectKeys[idx].key.object_id = objects[group.indexes[idx]].rid;
+        }
+
+        sai_object_id_t switchRid = m_vendorSai->switchIdQuery(group.first->rid);
+
+        sai_status_t status = m_vendorSai->bulkGetStats(
+                switchRid,
+                objectType,
+                objectCount,
+                objectKeys.data(),
+                counterCount,
+                group.first->counterIds,
+                SAI_STATS_MODE_READ,
+                objectStatuses.data(),
+                counters.data());
+
+        if (status == SAI_STATUS_NOT_SUPPORTED || status == SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            SWSS_LOG_NOTICE("%s: bulk stats not supported on %s, falling back to per object stats",
+                    m_instanceId.c_str(),
+                    sai_serialize_object_type(objectType).c_str());
+
+            {
+                std::lock_guard<std::mutex> lock(m_bulkStatsMutex);
+
+                m_bulkStatsUnsupportedObjectTypes.insert(objectType);
+            }
+
+            getStatsPerObject(objectType, objects);
+            return;
+        }
+
+        for (uint32_t idx = 0; idx < objectCount; idx++)
+        {
+            auto &object = objects[group.indexes[idx]];
+
+            object.status = objectStatuses[idx];
+
+            std::copy(
+                    counters.begin() + (size_t)idx * counterCount,
+                    counters.begin() + (size_t)(idx + 1) * counterCount,
+                    object.counterValues->stats.begin());
+        }
+    }
+}
+
 void FlexCounter::collectPortCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
+    std::vector<ObjectStats> objects;
+
+    objects.reserve(registry.portCounterIdsMap.size() / shardCount + 1);
+
     // Collect stats for every registered port
-    for (const auto &kv: m_portCounterIdsMap)
+    for (const auto &kv: registry.portCounterIdsMap)
     {
-        const auto &portVid = kv.first;
-        const auto &portId = kv.second->portId;
-        const auto &portCounterIds = kv.second->portCounterIds;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
 
-        std::vector<uint64_t> portStats(portCounterIds.size());
+        const auto &portCounterIds = kv.second->portCounterIds;
 
-        // Get port stats
-        sai_status_t status = m_vendorSai->getStats(
-                SAI_OBJECT_TYPE_PORT,
-                portId,
+        objects.emplace_back(
+                kv.first,
+                kv.second->portId,
                 static_cast<uint32_t>(portCounterIds.size()),
                 (const sai_stat_id_t *)portCounterIds.data(),
-                portStats.data());
+                kv.second->counterValues);
+    }
 
-        if (status != SAI_STATUS_SUCCESS)
+    // Get port stats
+    getStatsBulk(SAI_OBJECT_TYPE_PORT, objects);
+
+    for (const auto &object: objects)
+    {
+        if (object.status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to get stats of port 0x%" PRIx64 ": %d", portId, status);
+            SWSS_LOG_ERROR("Failed to get stats of port 0x%" PRIx64 ": %d", object.rid, object.status);
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        auto &counterValues = *object.counterValues;
 
-        for (size_t i = 0; i != portCounterIds.size(); i++)
-        {
-            const std::string &counterName = sai_serialize_port_stat(portCounterIds[i]);
+        const auto &values = counterValues.update(m_fullRefresh);
 
-            values.emplace_back(counterName, std::to_string(portStats[i]));
+        if (values.empty())
+        {
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string portVidStr = sai_serialize_object_id(portVid);
-
-        countersTable.set(portVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectPortDebugCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect stats for every registered port
-    for (const auto &kv: m_portDebugCounterIdsMap)
+    for (const auto &kv: registry.portDebugCounterIdsMap)
     {
-        const auto &portVid = kv.first;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &portId = kv.second->portId;
         const auto &portCounterIds = kv.second->portCounterIds;
 
-        std::vector<uint64_t> portStats(portCounterIds.size());
+        auto &counterValues = kv.second->counterValues;
 
         // Get port stats
         sai_status_t status = m_vendorSai->getStatsExt(
@@ -1113,7 +1541,7 @@ void FlexCounter::collectPortDebugCounters(
                 static_cast<uint32_t>(portCounterIds.size()),
                 (const sai_stat_id_t *)portCounterIds.data(),
                 SAI_STATS_MODE_READ,
-                portStats.data());
+                counterValues.stats.data());
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1121,67 +1549,71 @@ void FlexCounter::collectPortDebugCounters(
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        const auto &values = counterValues.update(m_fullRefresh);
 
-        for (size_t i = 0; i != portCounterIds.size(); i++)
+        if (values.empty())
         {
-            const std::string &counterName = sai_serialize_port_stat(portCounterIds[i]);
-
-            values.emplace_back(counterName, std::to_string(portStats[i]));
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string portVidStr = sai_serialize_object_id(portVid);
-
-        countersTable.set(portVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectQueueCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
+    std::vector<ObjectStats> objects;
+
+    objects.reserve(registry.queueCounterIdsMap.size() / shardCount + 1);
+
     // Collect stats for every registered queue
-    for (const auto &kv: m_queueCounterIdsMap)
+    for (const auto &kv: registry.queueCounterIdsMap)
     {
-        const auto &queueVid = kv.first;
-        const auto &queueId = kv.second->queueId;
-        const auto &queueCounterIds = kv.second->queueCounterIds;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
 
-        std::vector<uint64_t> queueStats(queueCounterIds.size());
+        const auto &queueCounterIds = kv.second->queueCounterIds;
 
-        // Get queue stats
-        sai_status_t status = -1;
-        // TODO: replace if with get_queue_stats_ext() call when it is fully supported
-        // Example:
-        // sai_status_t status = m_vendorSai->getStatsExt(
-        //         queueId,
-        //         static_cast<uint32_t>(queueCounterIds.size()),
-        //         queueCounterIds.data(),
-        //         m_statsMode,
-        //         queueStats.data());
-        status = m_vendorSai->getStats(
-                SAI_OBJECT_TYPE_QUEUE,
-                queueId,
+        objects.emplace_back(
+                kv.first,
+                kv.second->queueId,
                 static_cast<uint32_t>(queueCounterIds.size()),
                 (const sai_stat_id_t *)queueCounterIds.data(),
-                queueStats.data());
+                kv.second->counterValues);
+    }
 
-        if (status != SAI_STATUS_SUCCESS)
+    // Get queue stats
+    // TODO: use registry stats mode in bulk call when get_queue_stats_ext() is fully supported
+    getStatsBulk(SAI_OBJECT_TYPE_QUEUE, objects);
+
+    for (const auto &object: objects)
+    {
+        const auto &queueVid = object.vid;
+
+        if (object.status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("%s: failed to get stats of queue 0x%" PRIx64 ": %d", m_instanceId.c_str(), queueVid, status);
+            SWSS_LOG_ERROR("%s: failed to get stats of queue 0x%" PRIx64 ": %d", m_instanceId.c_str(), queueVid, object.status);
             continue;
         }
 
-        if (m_statsMode == SAI_STATS_MODE_READ_AND_CLEAR)
+        if (registry.statsMode == SAI_STATS_MODE_READ_AND_CLEAR)
         {
-            status = m_vendorSai->clearStats(
+            sai_status_t status = m_vendorSai->clearStats(
                     SAI_OBJECT_TYPE_QUEUE,
-                    queueId,
-                    static_cast<uint32_t>(queueCounterIds.size()),
-                    (const sai_stat_id_t *)queueCounterIds.data());
+                    object.rid,
+                    object.counterCount,
+                    object.counterIds);
 
             if (status != SAI_STATUS_SUCCESS)
             {
@@ -1190,31 +1622,38 @@ void FlexCounter::collectQueueCounters(
             }
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        auto &counterValues = *object.counterValues;
 
-        for (size_t i = 0; i != queueCounterIds.size(); i++)
-        {
-            const std::string &counterName = sai_serialize_queue_stat(queueCounterIds[i]);
+        const auto &values = counterValues.update(m_fullRefresh);
 
-            values.emplace_back(counterName, std::to_string(queueStats[i]));
+        if (values.empty())
+        {
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string queueVidStr = sai_serialize_object_id(queueVid);
-
-        countersTable.set(queueVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectQueueAttrs(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect attrs for every registered queue
-    for (const auto &kv: m_queueAttrIdsMap)
+    for (const auto &kv: registry.queueAttrIdsMap)
     {
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &queueVid = kv.first;
         const auto &queueId = kv.second->queueId;
         const auto &queueAttrIds = kv.second->queueAttrIds;
@@ -1258,90 +1697,110 @@ void FlexCounter::collectQueueAttrs(
 }
 
 void FlexCounter::collectPriorityGroupCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
+    std::vector<ObjectStats> objects;
+
+    objects.reserve(registry.priorityGroupCounterIdsMap.size() / shardCount + 1);
+
     // Collect stats for every registered ingress priority group
-    for (const auto &kv: m_priorityGroupCounterIdsMap)
+    for (const auto &kv: registry.priorityGroupCounterIdsMap)
     {
-        const auto &priorityGroupVid = kv.first;
-        const auto &priorityGroupId = kv.second->priorityGroupId;
-        const auto &priorityGroupCounterIds = kv.second->priorityGroupCounterIds;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
 
-        std::vector<uint64_t> priorityGroupStats(priorityGroupCounterIds.size());
+        const auto &priorityGroupCounterIds = kv.second->priorityGroupCounterIds;
 
-        // Get PG stats
-        sai_status_t status = -1;
-        // TODO: replace if with get_ingress_priority_group_stats_ext() call when it is fully supported
-        status = m_vendorSai->getStats(
-                SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
-                priorityGroupId,
+        objects.emplace_back(
+                kv.first,
+                kv.second->priorityGroupId,
                 static_cast<uint32_t>(priorityGroupCounterIds.size()),
                 (const sai_stat_id_t *)priorityGroupCounterIds.data(),
-                priorityGroupStats.data());
+                kv.second->counterValues);
+    }
 
-        if (status != SAI_STATUS_SUCCESS)
+    // Get PG stats
+    // TODO: use registry stats mode in bulk call when get_ingress_priority_group_stats_ext() is fully supported
+    getStatsBulk(SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP, objects);
+
+    for (const auto &object: objects)
+    {
+        const auto &priorityGroupVid = object.vid;
+
+        if (object.status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("%s: failed to get %ld/%ld stats of PG 0x%" PRIx64 ": %d",
+            SWSS_LOG_ERROR("%s: failed to get %u stats of PG 0x%" PRIx64 ": %d",
                     m_instanceId.c_str(),
-                    priorityGroupCounterIds.size(),
-                    priorityGroupStats.size(),
+                    object.counterCount,
                     priorityGroupVid,
-                    status);
+                    object.status);
             continue;
         }
 
-        if (m_statsMode == SAI_STATS_MODE_READ_AND_CLEAR)
+        if (registry.statsMode == SAI_STATS_MODE_READ_AND_CLEAR)
         {
-            status = m_vendorSai->clearStats(
+            sai_status_t status = m_vendorSai->clearStats(
                     SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
-                    priorityGroupId,
-                    static_cast<uint32_t>(priorityGroupCounterIds.size()),
-                    (const sai_stat_id_t *)priorityGroupCounterIds.data());
+                    object.rid,
+                    object.counterCount,
+                    object.counterIds);
 
             if (status != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("%s: failed to clear %ld/%ld stats of PG 0x%" PRIx64 ": %d",
+                SWSS_LOG_ERROR("%s: failed to clear %u stats of PG 0x%" PRIx64 ": %d",
                         m_instanceId.c_str(),
-                        priorityGroupCounterIds.size(),
-                        priorityGroupStats.size(),
+                        object.counterCount,
                         priorityGroupVid,
                         status);
                 continue;
             }
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        auto &counterValues = *object.counterValues;
 
-        for (size_t i = 0; i != priorityGroupCounterIds.size(); i++)
-        {
-            const std::string &counterName = sai_serialize_ingress_priority_group_stat(priorityGroupCounterIds[i]);
+        const auto &values = counterValues.update(m_fullRefresh);
 
-            values.emplace_back(counterName, std::to_string(priorityGroupStats[i]));
+        if (values.empty())
+        {
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string priorityGroupVidStr = sai_serialize_object_id(priorityGroupVid);
-
-        countersTable.set(priorityGroupVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectSwitchDebugCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect stats for every registered port
-    for (const auto &kv: m_switchDebugCounterIdsMap)
+    for (const auto &kv: registry.switchDebugCounterIdsMap)
     {
-        const auto &switchVid = kv.first;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &switchId = kv.second->switchId;
         const auto &switchCounterIds = kv.second->switchCounterIds;
 
-        std::vector<uint64_t> switchStats(switchCounterIds.size());
+        auto &counterValues = kv.second->counterValues;
 
         // Get port stats
         sai_status_t status = m_vendorSai->getStatsExt(
@@ -1350,7 +1809,7 @@ void FlexCounter::collectSwitchDebugCounters(
                 static_cast<uint32_t>(switchCounterIds.size()),
                 (const sai_stat_id_t *)switchCounterIds.data(),
                 SAI_STATS_MODE_READ,
-                switchStats.data());
+                counterValues.stats.data());
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1358,31 +1817,36 @@ void FlexCounter::collectSwitchDebugCounters(
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        const auto &values = counterValues.update(m_fullRefresh);
 
-        for (size_t i = 0; i != switchCounterIds.size(); i++)
+        if (values.empty())
         {
-            const std::string &counterName = sai_serialize_switch_stat(switchCounterIds[i]);
-
-            values.emplace_back(counterName, std::to_string(switchStats[i]));
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string switchVidStr = sai_serialize_object_id(switchVid);
-
-        countersTable.set(switchVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectPriorityGroupAttrs(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect attrs for every registered priority group
-    for (const auto &kv: m_priorityGroupAttrIdsMap)
+    for (const auto &kv: registry.priorityGroupAttrIdsMap)
     {
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &priorityGroupVid = kv.first;
         const auto &priorityGroupId = kv.second->priorityGroupId;
         const auto &priorityGroupAttrIds = kv.second->priorityGroupAttrIds;
@@ -1426,13 +1890,23 @@ void FlexCounter::collectPriorityGroupAttrs(
 }
 
 void FlexCounter::collectMACsecSAAttrs(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect attrs for every registered MACsec SA
-    for (const auto &kv: m_macsecSAAttrIdsMap)
+    for (const auto &kv: registry.macsecSAAttrIdsMap)
     {
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &macsecSAVid = kv.first;
         const auto &macsecSARid = kv.second->m_macsecSAId;
         const auto &macsecSAAttrIds = kv.second->m_macsecSAAttrIds;
@@ -1477,18 +1951,27 @@ void FlexCounter::collectMACsecSAAttrs(
 }
 
 void FlexCounter::collectRifCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect stats for every registered router interface
-    for (const auto &kv: m_rifCounterIdsMap)
+    for (const auto &kv: registry.rifCounterIdsMap)
     {
-        const auto &rifVid = kv.first;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &rifId = kv.second->rifId;
         const auto &rifCounterIds = kv.second->rifCounterIds;
 
-        std::vector<uint64_t> rifStats(rifCounterIds.size());
+        auto &counterValues = kv.second->counterValues;
 
         // Get rif stats
         sai_status_t status = m_vendorSai->getStats(
@@ -1496,7 +1979,7 @@ void FlexCounter::collectRifCounters(
                 rifId,
                 static_cast<uint32_t>(rifCounterIds.size()),
                 (const sai_stat_id_t *)rifCounterIds.data(),
-                rifStats.data());
+                counterValues.stats.data());
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1504,37 +1987,41 @@ void FlexCounter::collectRifCounters(
             continue;
         }
 
-        // Push all counter values to a single vector
-        std::vector<swss::FieldValueTuple> values;
+        const auto &values = counterValues.update(m_fullRefresh);
 
-        for (size_t i = 0; i != rifCounterIds.size(); i++)
+        if (values.empty())
         {
-            const std::string &counterName = sai_serialize_router_interface_stat(rifCounterIds[i]);
-
-            values.emplace_back(counterName, std::to_string(rifStats[i]));
+            continue; // nothing changed since last write
         }
 
         // Write counters to DB
-        std::string rifVidStr = sai_serialize_object_id(rifVid);
-
-        countersTable.set(rifVidStr, values, "");
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::collectBufferPoolCounters(
-        _In_ swss::Table &countersTable)
+        _In_ const CounterRegistry& registry,
+        _In_ swss::Table &countersTable,
+        _In_ size_t shardIndex,
+        _In_ size_t shardCount)
 {
     SWSS_LOG_ENTER();
 
+    size_t idx = 0;
+
     // Collect stats for every registered buffer pool
-    for (const auto &it : m_bufferPoolCounterIdsMap)
+    for (const auto &it : registry.bufferPoolCounterIdsMap)
     {
-        const auto &bufferPoolVid = it.first;
+        if (idx++ % shardCount != shardIndex)
+        {
+            continue;
+        }
+
         const auto &bufferPoolId = it.second->bufferPoolId;
         const auto &bufferPoolCounterIds = it.second->bufferPoolCounterIds;
         const auto &bufferPoolStatsMode = it.second->bufferPoolStatsMode;
 
-        std::vector<uint64_t> bufferPoolStats(bufferPoolCounterIds.size());
+        auto &counterValues = it.second->counterValues;
 
         // Get buffer pool stats
         sai_status_t status = -1;
@@ -1544,7 +2031,7 @@ void FlexCounter::collectBufferPoolCounters(
                 bufferPoolId,
                 static_cast<uint32_t>(bufferPoolCounterIds.size()),
                 reinterpret_cast<const sai_stat_id_t *>(bufferPoolCounterIds.data()),
-                bufferPoolStats.data());
+                counterValues.stats.data());
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1556,7 +2043,7 @@ void FlexCounter::collectBufferPoolCounters(
                     sai_serialize_status(status).c_str());
             continue;
         }
-        if (m_statsMode == SAI_STATS_MODE_READ_AND_CLEAR || bufferPoolStatsMode == SAI_STATS_MODE_READ_AND_CLEAR)
+        if (registry.statsMode == SAI_STATS_MODE_READ_AND_CLEAR || bufferPoolStatsMode == SAI_STATS_MODE_READ_AND_CLEAR)
         {
             status = m_vendorSai->clearStats(
                     SAI_OBJECT_TYPE_BUFFER_POOL,
@@ -1576,19 +2063,20 @@ void FlexCounter::collectBufferPoolCounters(
             }
         }
 
-        // Write counter values to DB table
-        std::vector<swss::FieldValueTuple> fvTuples;
+        const auto &values = counterValues.update(m_fullRefresh);
 
-        for (size_t i = 0; i < bufferPoolCounterIds.size(); ++i)
+        if (values.empty())
         {
-            fvTuples.emplace_back(sai_serialize_buffer_pool_stat(bufferPoolCounterIds[i]), std::to_string(bufferPoolStats[i]));
+            continue; // nothing changed since last write
         }
 
-        countersTable.set(sai_serialize_object_id(bufferPoolVid), fvTuples);
+        // Write counters to DB
+        countersTable.set(counterValues.key, values, "");
     }
 }
 
 void FlexCounter::runPlugins(
+        _In_ const CounterRegistry& registry,
         _In_ swss::DBConnector& counters_db)
 {
     SWSS_LOG_ENTER();
@@ -1597,105 +2085,236 @@ void FlexCounter::runPlugins(
     {
         std::to_string(counters_db.getDbId()),
         COUNTERS_TABLE,
-        std::to_string(m_pollInterval * 1000)
+        std::to_string(registry.pollInterval * 1000)
     };
 
     std::vector<std::string> portList;
 
-    portList.reserve(m_portCounterIdsMap.size());
+    portList.reserve(registry.portCounterIdsMap.size());
 
-    for (const auto& kv : m_portCounterIdsMap)
+    for (const auto& kv : registry.portCounterIdsMap)
     {
         portList.push_back(sai_serialize_object_id(kv.first));
     }
 
-    for (const auto& sha : m_portPlugins)
+    for (const auto& sha : registry.portPlugins)
     {
         runRedisScript(counters_db, sha, portList, argv);
     }
 
     std::vector<std::string> rifList;
-    rifList.reserve(m_rifCounterIdsMap.size());
-    for (const auto& kv : m_rifCounterIdsMap)
+    rifList.reserve(registry.rifCounterIdsMap.size());
+    for (const auto& kv : registry.rifCounterIdsMap)
     {
         rifList.push_back(sai_serialize_object_id(kv.first));
     }
-    for (const auto& sha : m_rifPlugins)
+    for (const auto& sha : registry.rifPlugins)
     {
         runRedisScript(counters_db, sha, rifList, argv);
     }
 
     std::vector<std::string> queueList;
 
-    queueList.reserve(m_queueCounterIdsMap.size());
+    queueList.reserve(registry.queueCounterIdsMap.size());
 
-    for (const auto& kv : m_queueCounterIdsMap)
+    for (const auto& kv : registry.queueCounterIdsMap)
     {
         queueList.push_back(sai_serialize_object_id(kv.first));
     }
 
-    for (const auto& sha : m_queuePlugins)
+    for (const auto& sha : registry.queuePlugins)
     {
         runRedisScript(counters_db, sha, queueList, argv);
     }
 
     std::vector<std::string> priorityGroupList;
 
-    priorityGroupList.reserve(m_priorityGroupCounterIdsMap.size());
+    priorityGroupList.reserve(registry.priorityGroupCounterIdsMap.size());
 
-    for (const auto& kv : m_priorityGroupCounterIdsMap)
+    for (const auto& kv : registry.priorityGroupCounterIdsMap)
     {
         priorityGroupList.push_back(sai_serialize_object_id(kv.first));
     }
 
-    for (const auto& sha : m_priorityGroupPlugins)
+    for (const auto& sha : registry.priorityGroupPlugins)
     {
         runRedisScript(counters_db, sha, priorityGroupList, argv);
     }
 
     std::vector<std::string> bufferPoolVids;
 
-    bufferPoolVids.reserve(m_bufferPoolCounterIdsMap.size());
+    bufferPoolVids.reserve(registry.bufferPoolCounterIdsMap.size());
 
-    for (const auto& it : m_bufferPoolCounterIdsMap)
+    for (const auto& it : registry.bufferPoolCounterIdsMap)
     {
         bufferPoolVids.push_back(sai_serialize_object_id(it.first));
     }
 
-    for (const auto& sha : m_bufferPoolPlugins)
+    for (const auto& sha : registry.bufferPoolPlugins)
     {
         runRedisScript(counters_db, sha, bufferPoolVids, argv);
     }
 }
 
+template <typename T>
+static void getPluginObjects(
+        _In_ const std::map<sai_object_id_t, std::shared_ptr<T>>& counterIdsMap,
+        _Out_ std::vector<CounterPlugin::Object>& objects)
+{
+    SWSS_LOG_ENTER();
+
+    objects.clear();
+
+    objects.reserve(counterIdsMap.size());
+
+    for (const auto& kv: counterIdsMap)
+    {
+        auto& counterValues = kv.second->counterValues;
+
+        objects.push_back({ kv.first, &counterValues.key, &counterValues.values, &counterValues.stats, counterValues.updated });
+
+        counterValues.updated = false;
+    }
+}
+
+void FlexCounter::runNativePlugins(
+        _In_ const CounterRegistry& registry,
+        _In_ std::chrono::steady_clock::time_point now)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<CounterPlugin::Object> objects;
+
+    if (registry.portNativePlugins.size())
+    {
+        getPluginObjects(registry.portCounterIdsMap, objects);
+
+        processNativePlugins(registry.portNativePlugins, objects, now);
+    }
+
+    if (registry.rifNativePlugins.size())
+    {
+        getPluginObjects(registry.rifCounterIdsMap, objects);
+
+        processNativePlugins(registry.rifNativePlugins, objects, now);
+    }
+
+    if (registry.queueNativePlugins.size())
+    {
+        getPluginObjects(registry.queueCounterIdsMap, objects);
+
+        processNativePlugins(registry.queueNativePlugins, objects, now);
+    }
+
+    if (registry.priorityGroupNativePlugins.size())
+    {
+        getPluginObjects(registry.priorityGroupCounterIdsMap, objects);
+
+        processNativePlugins(registry.priorityGroupNativePlugins, objects, now);
+    }
+
+    if (registry.bufferPoolNativePlugins.size())
+    {
+        getPluginObjects(registry.bufferPoolCounterIdsMap, objects);
+
+        processNativePlugins(registry.bufferPoolNativePlugins, objects, now);
+    }
+
+    m_pipeline->flush();
+}
+
+void FlexCounter::processNativePlugins(
+        _In_ const native_counter_plugin_map_t& plugins,
+        _In_ const std::vector<CounterPlugin::Object>& objects,
+        _In_ std::chrono::steady_clock::time_point now)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<swss::KeyOpFieldsValuesTuple> results;
+
+    for (const auto& kv: plugins)
+    {
+        results.clear();
+
+        kv.second->process(objects, now, results);
+
+        auto& table = getPluginTable(kv.second->getTableName());
+
+        for (const auto& entry: results)
+        {
+            if (kfvOp(entry) == DEL_COMMAND)
+            {
+                table.del(kfvKey(entry));
+                continue;
+            }
+
+            table.set(kfvKey(entry), kfvFieldsValues(entry), "");
+        }
+    }
+}
+
+swss::Table& FlexCounter::getPluginTable(
+        _In_ const std::string& tableName)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_pluginTables.find(tableName);
+
+    if (it != m_pluginTables.end())
+    {
+        return *it->second;
+    }
+
+    auto table = std::make_shared<swss::Table>(m_pipeline.get(), tableName, true);
+
+    m_pluginTables[tableName] = table;
+
+    return *table;
+}
+
+void FlexCounter::initCountersTable()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_countersTable == nullptr)
+    {
+        m_db = std::make_shared<swss::DBConnector>(m_dbCounters, 0);
+        m_pipeline = std::make_shared<swss::RedisPipeline>(m_db.get());
+        m_countersTable = std::make_shared<swss::Table>(m_pipeline.get(), COUNTERS_TABLE, true);
+    }
+}
+
 void FlexCounter::flexCounterThreadRunFunction()
 {
     SWSS_LOG_ENTER();
 
-    swss::DBConnector db(m_dbCounters, 0);
-    swss::RedisPipeline pipeline(&db);
-    swss::Table countersTable(&pipeline, COUNTERS_TABLE, true);
+    initCountersTable();
 
     while (m_runFlexCounterThread)
     {
-        MUTEX;
+        auto registry = acquireRegistry();
+
+        // collect handler is registered only while its map is not empty
 
-        if (m_enable && !allIdsEmpty() && (m_pollInterval > 0))
+        if (registry->enable && !registry->collectCountersHandlers.empty() && (registry->pollInterval > 0))
         {
             auto start = std::chrono::steady_clock::now();
 
-            collectCounters(countersTable);
+            collectCounters(*registry, *m_countersTable);
+
+            runNativePlugins(*registry, start);
+
+            runPlugins(*registry, *m_db);
 
-            runPlugins(db);
+            releaseRegistry();
 
             auto finish = std::chrono::steady_clock::now();
 
             uint32_t delay = static_cast<uint32_t>(
                     std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count());
 
-            uint32_t correction = delay % m_pollInterval;
-            correction = m_pollInterval - correction;
-            MUTEX_UNLOCK; // explicit unlock
+            uint32_t correction = delay % registry->pollInterval;
+            correction = registry->pollInterval - correction;
 
             SWSS_LOG_DEBUG("End of flex counter thread FC %s, took %d ms", m_instanceId.c_str(), delay);
 
@@ -1706,14 +2325,165 @@ void FlexCounter::flexCounterThreadRunFunction()
             continue;
         }
 
-        MUTEX_UNLOCK; // explicit unlock
+        releaseRegistry();
 
-        // nothing to collect, wait until notified
+        // nothing to collect, wait until registry changes
 
         std::unique_lock<std::mutex> lk(m_mtxSleep);
 
-        m_pollCond.wait(lk); // wait on mutex
+        m_pollCond.wait(lk, [this] { return !m_runFlexCounterThread || m_registryDirty; });
+    }
+}
+
+uint32_t FlexCounter::poll()
+{
+    SWSS_LOG_ENTER();
+
+    auto registry = acquireRegistry();
+
+    if (!registry->enable || registry->collectCountersHandlers.empty() || (registry->pollInterval == 0))
+    {
+        releaseRegistry();
+
+        return 0;
+    }
+
+    initCountersTable();
+
+    auto start = std::chrono::steady_clock::now();
+
+    collectCounters(*registry, *m_countersTable);
+
+    runNativePlugins(*registry, start);
+
+    runPlugins(*registry, *m_db);
+
+    releaseRegistry();
+
+    auto finish = std::chrono::steady_clock::now();
+
+    uint32_t delay = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(finish - start).count());
+
+    SWSS_LOG_DEBUG("End of flex counter poll FC %s, took %d ms", m_instanceId.c_str(), delay);
+
+    return registry->pollInterval;
+}
+
+void FlexCounter::notifyPoll()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_scheduler)
+    {
+        m_scheduler->wakeUp(this);
+        return;
+    }
+
+    {
+        // poll thread checks registry state under sleep mutex
+        std::lock_guard<std::mutex> lk(m_mtxSleep);
+    }
+
+    m_pollCond.notify_all();
+}
+
+uint64_t FlexCounter::registryChanged()
+{
+    SWSS_LOG_ENTER();
+
+    m_registryDirty = true;
+
+    return ++m_registryGeneration;
+}
+
+void FlexCounter::publishRegistry()
+{
+    SWSS_LOG_ENTER();
+
+    auto registry = std::make_shared<CounterRegistry>();
+
+    registry->generation = m_registryGeneration;
+
+    registry->enable = m_enable;
+    registry->pollInterval = m_pollInterval;
+    registry->statsMode = m_statsMode;
+    registry->deltaWrite = m_deltaWrite;
+    registry->fullRefreshCycles = m_fullRefreshCycles;
+
+    registry->queuePlugins = m_queuePlugins;
+    registry->portPlugins = m_portPlugins;
+    registry->rifPlugins = m_rifPlugins;
+    registry->priorityGroupPlugins = m_priorityGroupPlugins;
+    registry->bufferPoolPlugins = m_bufferPoolPlugins;
+
+    registry->queueNativePlugins = m_queueNativePlugins;
+    registry->portNativePlugins = m_portNativePlugins;
+    registry->rifNativePlugins = m_rifNativePlugins;
+    registry->priorityGroupNativePlugins = m_priorityGroupNativePlugins;
+    registry->bufferPoolNativePlugins = m_bufferPoolNativePlugins;
+
+    registry->collectCountersHandlers = m_collectCountersHandlers;
+
+    registry->portCounterIdsMap = m_portCounterIdsMap;
+    registry->portDebugCounterIdsMap = m_portDebugCounterIdsMap;
+    registry->queueCounterIdsMap = m_queueCounterIdsMap;
+    registry->priorityGroupCounterIdsMap = m_priorityGroupCounterIdsMap;
+    registry->rifCounterIdsMap = m_rifCounterIdsMap;
+    registry->bufferPoolCounterIdsMap = m_bufferPoolCounterIdsMap;
+    registry->switchDebugCounterIdsMap = m_switchDebugCounterIdsMap;
+    registry->queueAttrIdsMap = m_queueAttrIdsMap;
+    registry->priorityGroupAttrIdsMap = m_priorityGroupAttrIdsMap;
+    registry->macsecSAAttrIdsMap = m_macsecSAAttrIdsMap;
+
+    m_registry = registry;
+
+    m_registryDirty = false;
+}
+
+std::shared_ptr<const FlexCounter::CounterRegistry> FlexCounter::acquireRegistry()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mtxPoll);
+
+    if (m_registryDirty)
+    {
+        // group mutex is held only to copy registered maps, never for
+        // whole poll cycle
+
+        MUTEX;
+
+        publishRegistry();
+    }
+
+    m_pollActive = true;
+    m_pollGeneration = m_registry->generation;
+
+    return m_registry;
+}
+
+void FlexCounter::releaseRegistry()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtxPoll);
+
+        m_pollActive = false;
     }
+
+    m_cvPoll.notify_all();
+}
+
+void FlexCounter::waitForRegistry(
+        _In_ uint64_t generation)
+{
+    SWSS_LOG_ENTER();
+
+    std::unique_lock<std::mutex> lock(m_mtxPoll);
+
+    m_cvPoll.wait(lock, [&] { return !m_pollActive || m_pollGeneration >= generation; });
 }
 
 void FlexCounter::startFlexCounterThread()
@@ -1738,7 +2508,11 @@ void FlexCounter::endFlexCounterThread(void)
         return;
     }
 
-    m_runFlexCounterThread = false;
+    {
+        std::lock_guard<std::mutex> lk(m_mtxSleep);
+
+        m_runFlexCounterThread = false;
+    }
 
     m_pollCond.notify_all();
 
@@ -2106,6 +2880,16 @@ void FlexCounter::removeCounter(
         SWSS_LOG_ERROR("Object type for removal not supported, %s",
                 sai_serialize_object_type(objectType).c_str());
     }
+
+    auto generation = registryChanged();
+
+    MUTEX_UNLOCK; // explicit unlock
+
+    // object may be removed from SAI right after this call, so wait until
+    // poll cycle using previous snapshot is finished, this don't wait for
+    // cycles which already use new snapshot
+
+    waitForRegistry(generation);
 }
 
 void FlexCounter::addCounter(
@@ -2280,6 +3064,8 @@ void FlexCounter::addCounter(
         setBufferPoolCounterList(vid, rid, bufferPoolCounterIds, statsMode);
     }
 
+    registryChanged();
+
     // notify thread to start polling
-    m_pollCond.notify_all();
+    notifyPoll();
 }
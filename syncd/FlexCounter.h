@@ -5,6 +5,9 @@ extern "C" {
 }
 
 #include "SaiInterface.h"
+#include "FlexCounterWorkerPool.h"
+#include "FlexCounterScheduler.h"
+#include "CounterPlugin.h"
 
 #include "swss/table.h"
 
@@ -13,6 +16,22 @@ extern "C" {
 #include <condition_variable>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Flex counter group field, when enabled only counter values which
+ * changed since last write are written to COUNTERS_DB (enable|disable).
+ */
+#define DELTA_WRITE_FIELD "DELTA_WRITE"
+
+/**
+ * @brief Flex counter group field, number of poll cycles after which all
+ * counter values are written again when delta write is enabled.
+ */
+#define FULL_REFRESH_CYCLES_FIELD "FULL_REFRESH_CYCLES"
+
+#define DEFAULT_FULL_REFRESH_CYCLES (60)
 
 namespace syncd
 {
@@ -27,7 +46,9 @@ namespace syncd
             FlexCounter(
                     _In_ const std::string& instanceId,
                     _In_ std::shared_ptr<sairedis::SaiInterface> vendorSai,
-                    _In_ const std::string& dbCounters);
+                    _In_ const std::string& dbCounters,
+                    _In_ std::shared_ptr<FlexCounterWorkerPool> workerPool,
+                    _In_ std::shared_ptr<FlexCounterScheduler> scheduler);
 
             virtual ~FlexCounter();
 
@@ -50,6 +71,15 @@ namespace syncd
 
             bool isDiscarded();
 
+            /**
+             * @brief Collect counters and run plugins once, used by
+             * scheduler.
+             *
+             * @return Poll interval in milliseconds, or zero if group has
+             * nothing to poll.
+             */
+            uint32_t poll();
+
         private:
 
             void setPollInterval(
@@ -61,6 +91,12 @@ namespace syncd
             void setStatsMode(
                     _In_ const std::string& mode);
 
+            void setDeltaWrite(
+                    _In_ const std::string& status);
+
+            void setFullRefreshCycles(
+                    _In_ uint32_t cycles);
+
         private: // plugins
 
             void addPortCounterPlugin(
@@ -83,6 +119,23 @@ namespace syncd
             void checkPluginRegistered(
                     _In_ const std::string& sha) const;
 
+            /**
+             * @brief Add native plugin if name has native plugin prefix.
+             *
+             * @return False if name is Lua script SHA.
+             */
+            bool addNativeCounterPlugin(
+                    _In_ const std::string& name,
+                    _Inout_ native_counter_plugin_map_t& plugins);
+
+            void processNativePlugins(
+                    _In_ const native_counter_plugin_map_t& plugins,
+                    _In_ const std::vector<CounterPlugin::Object>& objects,
+                    _In_ std::chrono::steady_clock::time_point now);
+
+            swss::Table& getPluginTable(
+                    _In_ const std::string& tableName);
+
             bool allIdsEmpty() const;
 
             bool allPluginsEmpty() const;
@@ -216,6 +269,52 @@ namespace syncd
 
         private:
 
+            /**
+             * @brief Serialized counters of single object.
+             *
+             * Key and counter names are serialized when counter list is set,
+             * and values are formatted in place on each poll.
+             */
+            struct CounterValues
+            {
+                void init(
+                        _In_ sai_object_type_t objectType,
+                        _In_ sai_object_id_t vid,
+                        _In_ uint32_t counterCount,
+                        _In_ const sai_stat_id_t *counterIds);
+
+                /**
+                 * @brief Format stats into values.
+                 *
+                 * @return All values on full refresh, otherwise only values
+                 * changed since last write, can be empty.
+                 */
+                const std::vector<swss::FieldValueTuple>& update(
+                        _In_ bool fullRefresh);
+
+                std::string key;
+                std::vector<swss::FieldValueTuple> values;
+                std::vector<uint64_t> stats;
+
+                std::vector<uint64_t> lastStats;
+                bool lastStatsValid;
+
+                /**
+                 * @brief Values changed since last write, changeIndexes holds
+                 * index in values of each change, so slots are reused while
+                 * the same counters keep changing.
+                 */
+                std::vector<swss::FieldValueTuple> changes;
+                std::vector<size_t> changeIndexes;
+
+                /**
+                 * @brief Set by update, cleared when values were passed to
+                 * native plugins, so plugins can skip objects which poll
+                 * failed in current cycle.
+                 */
+                bool updated;
+            };
+
             struct QueueCounterIds
             {
                 QueueCounterIds(
@@ -224,6 +323,7 @@ namespace syncd
 
                 sai_object_id_t queueId;
                 std::vector<sai_queue_stat_t> queueCounterIds;
+                CounterValues counterValues;
             };
 
             struct QueueAttrIds
@@ -244,6 +344,7 @@ namespace syncd
 
                 sai_object_id_t priorityGroupId;
                 std::vector<sai_ingress_priority_group_stat_t> priorityGroupCounterIds;
+                CounterValues counterValues;
             };
 
             struct IngressPriorityGroupAttrIds
@@ -266,6 +367,7 @@ namespace syncd
                 sai_object_id_t bufferPoolId;
                 sai_stats_mode_t bufferPoolStatsMode;
                 std::vector<sai_buffer_pool_stat_t> bufferPoolCounterIds;
+                CounterValues counterValues;
             };
 
             struct PortCounterIds
@@ -276,6 +378,7 @@ namespace syncd
 
                 sai_object_id_t portId;
                 std::vector<sai_port_stat_t> portCounterIds;
+                CounterValues counterValues;
             };
 
             struct SwitchCounterIds
@@ -286,6 +389,7 @@ namespace syncd
 
                 sai_object_id_t switchId;
                 std::vector<sai_switch_stat_t> switchCounterIds;
+                CounterValues counterValues;
             };
 
             struct RifCounterIds
@@ -296,6 +400,29 @@ namespace syncd
 
                 sai_object_id_t rifId;
                 std::vector<sai_router_interface_stat_t> rifCounterIds;
+                CounterValues counterValues;
+            };
+
+            /**
+             * @brief Stats of single object, counter ids and values point to
+             * registered object, which are valid while registry snapshot is
+             * held.
+             */
+            struct ObjectStats
+            {
+                ObjectStats(
+                        _In_ sai_object_id_t objectVid,
+                        _In_ sai_object_id_t objectRid,
+                        _In_ uint32_t count,
+                        _In_ const sai_stat_id_t *ids,
+                        _Inout_ CounterValues& values);
+
+                sai_object_id_t vid;
+                sai_object_id_t rid;
+                uint32_t counterCount;
+                const sai_stat_id_t *counterIds;
+                sai_status_t status;
+                CounterValues *counterValues;
             };
 
             struct MACsecSAAttrIds
@@ -310,58 +437,212 @@ namespace syncd
 
         private:
 
+            struct CounterRegistry;
+
             void collectCounters(
+                    _In_ const CounterRegistry& registry,
                     _In_ swss::Table &countersTable);
 
             void runPlugins(
+                    _In_ const CounterRegistry& registry,
                     _In_ swss::DBConnector& db);
 
+            /**
+             * @brief Run native plugins on counters collected in current
+             * cycle, results are written by group pipeline.
+             */
+            void runNativePlugins(
+                    _In_ const CounterRegistry& registry,
+                    _In_ std::chrono::steady_clock::time_point now);
+
+            void initCountersTable();
+
             void startFlexCounterThread();
 
             void endFlexCounterThread();
 
             void flexCounterThreadRunFunction();
 
+            void notifyPoll();
+
         private:
 
+            /**
+             * @brief Collect counters handler, handler collects only objects
+             * which belong to given shard, each shard writes to own table.
+             */
             typedef void (FlexCounter::*collect_counters_handler_t)(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             typedef std::unordered_map<std::string, collect_counters_handler_t> collect_counters_handler_unordered_map_t;
 
+            typedef std::map<std::string, std::shared_ptr<CounterPlugin>> native_counter_plugin_map_t;
+
+            /**
+             * @brief Immutable snapshot of registered objects, plugins and
+             * group configuration.
+             *
+             * Add/remove counter modify group members under group mutex, and
+             * poller publishes new snapshot from them at the beginning of
+             * cycle, so whole cycle runs without group mutex. Counter id
+             * objects are shared between snapshots and never modified after
+             * they are registered, only counter values are updated by
+             * poller.
+             */
+            struct CounterRegistry
+            {
+                uint64_t generation;
+
+                bool enable;
+                uint32_t pollInterval;
+                sai_stats_mode_t statsMode;
+                bool deltaWrite;
+                uint32_t fullRefreshCycles;
+
+                std::set<std::string> queuePlugins;
+                std::set<std::string> portPlugins;
+                std::set<std::string> rifPlugins;
+                std::set<std::string> priorityGroupPlugins;
+                std::set<std::string> bufferPoolPlugins;
+
+                native_counter_plugin_map_t queueNativePlugins;
+                native_counter_plugin_map_t portNativePlugins;
+                native_counter_plugin_map_t rifNativePlugins;
+                native_counter_plugin_map_t priorityGroupNativePlugins;
+                native_counter_plugin_map_t bufferPoolNativePlugins;
+
+                collect_counters_handler_unordered_map_t collectCountersHandlers;
+
+                std::map<sai_object_id_t, std::shared_ptr<PortCounterIds>> portCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<PortCounterIds>> portDebugCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<QueueCounterIds>> queueCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<IngressPriorityGroupCounterIds>> priorityGroupCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<RifCounterIds>> rifCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<BufferPoolCounterIds>> bufferPoolCounterIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<SwitchCounterIds>> switchDebugCounterIdsMap;
+
+                std::map<sai_object_id_t, std::shared_ptr<QueueAttrIds>> queueAttrIdsMap;
+                std::map<sai_object_id_t, std::shared_ptr<IngressPriorityGroupAttrIds>> priorityGroupAttrIdsMap;
+
+                std::map<sai_object_id_t, std::shared_ptr<MACsecSAAttrIds>> macsecSAAttrIdsMap;
+            };
+
+        private: // registry
+
+            /**
+             * @brief Mark registry as changed, group mutex must be held.
+             *
+             * @return Generation of the change.
+             */
+            uint64_t registryChanged();
+
+            /**
+             * @brief Build new registry snapshot from group members, group
+             * mutex must be held.
+             */
+            void publishRegistry();
+
+            /**
+             * @brief Get current registry snapshot for poll cycle, snapshot
+             * is republished first if registry changed.
+             */
+            std::shared_ptr<const CounterRegistry> acquireRegistry();
+
+            void releaseRegistry();
+
+            /**
+             * @brief Wait until no poll cycle uses snapshot older than given
+             * generation, so removed objects are no longer polled.
+             */
+            void waitForRegistry(
+                    _In_ uint64_t generation);
+
         private: // collect counters:
 
             void collectPortCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectPortDebugCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectQueueCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectPriorityGroupCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectRifCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectBufferPoolCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectSwitchDebugCounters(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
         private: // collect attributes
 
             void collectQueueAttrs(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectPriorityGroupAttrs(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
 
             void collectMACsecSAAttrs(
-                    _In_ swss::Table &countersTable);
+                    _In_ const CounterRegistry& registry,
+                    _In_ swss::Table &countersTable,
+                    _In_ size_t shardIndex,
+                    _In_ size_t shardCount);
+
+        private: // get stats
+
+            bool isBulkStatsSupported(
+                    _In_ sai_object_type_t objectType);
+
+            /**
+             * @brief Get stats of all objects using bulk API.
+             *
+             * Objects are grouped by switch and counter list. If bulk stats
+             * are not supported for object type, stats are queried per
+             * object and bulk API is not tried again for that type.
+             */
+            void getStatsBulk(
+                    _In_ sai_object_type_t objectType,
+                    _Inout_ std::vector<ObjectStats>& objects);
+
+            void getStatsPerObject(
+                    _In_ sai_object_type_t objectType,
+                    _Inout_ std::vector<ObjectStats>& objects);
 
         private:
 
@@ -380,6 +661,12 @@ namespace syncd
             std::set<std::string> m_priorityGroupPlugins;
             std::set<std::string> m_bufferPoolPlugins;
 
+            native_counter_plugin_map_t m_queueNativePlugins;
+            native_counter_plugin_map_t m_portNativePlugins;
+            native_counter_plugin_map_t m_rifNativePlugins;
+            native_counter_plugin_map_t m_priorityGroupNativePlugins;
+            native_counter_plugin_map_t m_bufferPoolNativePlugins;
+
         private: // supported counters
 
             std::set<sai_port_stat_t> m_supportedPortCounters;
@@ -405,7 +692,7 @@ namespace syncd
 
         private:
 
-            bool m_runFlexCounterThread;
+            std::atomic<bool> m_runFlexCounterThread;
 
             std::shared_ptr<std::thread> m_flexCounterThread;
 
@@ -431,6 +718,58 @@ namespace syncd
 
             std::string m_dbCounters;
 
+            std::shared_ptr<FlexCounterWorkerPool> m_workerPool;
+
+            std::shared_ptr<FlexCounterScheduler> m_scheduler;
+
+            // used only by poll thread or scheduler
+
+            std::shared_ptr<swss::DBConnector> m_db;
+
+            std::shared_ptr<swss::RedisPipeline> m_pipeline;
+
+            std::shared_ptr<swss::Table> m_countersTable;
+
+            std::map<std::string, std::shared_ptr<swss::Table>> m_pluginTables;
+
+            bool m_deltaWrite;
+
+            uint32_t m_fullRefreshCycles;
+
+            uint64_t m_cycleCount;
+
+            /**
+             * @brief Whether current cycle writes all values, set before
+             * collection starts and read by collectors.
+             */
+            bool m_fullRefresh;
+
+            /**
+             * @brief Set when delta write is toggled, next cycle writes all
+             * values.
+             */
+            std::atomic<bool> m_fullRefreshRequested;
+
+            std::mutex m_bulkStatsMutex;
+
+            std::set<sai_object_type_t> m_bulkStatsUnsupportedObjectTypes;
+
             bool m_isDiscarded;
+
+        private: // registry snapshot
+
+            uint64_t m_registryGeneration;
+
+            std::atomic<bool> m_registryDirty;
+
+            std::mutex m_mtxPoll;
+
+            std::condition_variable m_cvPoll;
+
+            std::shared_ptr<const CounterRegistry> m_registry;
+
+            bool m_pollActive;
+
+            uint64_t m_pollGeneration;
     };
 }
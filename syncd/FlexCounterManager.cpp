@@ -8,13 +8,27 @@ using namespace syncd;
 
 FlexCounterManager::FlexCounterManager(
         _In_ std::shared_ptr<sairedis::SaiInterface> vendorSai,
-        _In_ const std::string& dbCounters):
+        _In_ const std::string& dbCounters,
+        _In_ uint32_t workerCount,
+        _In_ uint32_t schedulerThreadCount):
     m_vendorSai(vendorSai),
     m_dbCounters(dbCounters)
 {
     SWSS_LOG_ENTER();
 
-    // empty
+    // single worker gives nothing over collecting on group thread
+
+    if (workerCount > 1)
+    {
+        m_workerPool = std::make_shared<FlexCounterWorkerPool>(workerCount, dbCounters);
+    }
+
+    // without scheduler each group is polled by its own thread
+
+    if (schedulerThreadCount)
+    {
+        m_scheduler = std::make_shared<FlexCounterScheduler>(schedulerThreadCount);
+    }
 }
 
 std::shared_ptr<FlexCounter> FlexCounterManager::getInstance(
@@ -26,7 +40,7 @@ std::shared_ptr<FlexCounter> FlexCounterManager::getInstance(
 
     if (m_flexCounters.count(instanceId) == 0)
     {
-        auto counter = std::make_shared<FlexCounter>(instanceId, m_vendorSai, m_dbCounters);
+        auto counter = std::make_shared<FlexCounter>(instanceId, m_vendorSai, m_dbCounters, m_workerPool, m_scheduler);
 
         m_flexCounters[instanceId] = counter;
     }
@@ -10,7 +10,9 @@ namespace syncd
 
             FlexCounterManager(
                     _In_ std::shared_ptr<sairedis::SaiInterface> vendorSai,
-                    _In_ const std::string& dbCounters);
+                    _In_ const std::string& dbCounters,
+                    _In_ uint32_t workerCount = 0,
+                    _In_ uint32_t schedulerThreadCount = 0);
 
             virtual ~FlexCounterManager() = default;
 
@@ -50,6 +52,10 @@ namespace syncd
                 std::shared_ptr<sairedis::SaiInterface> m_vendorSai;
 
                 std::string m_dbCounters;
+
+                std::shared_ptr<FlexCounterWorkerPool> m_workerPool;
+
+                std::shared_ptr<FlexCounterScheduler> m_scheduler;
     };
 }
 
@@ -0,0 +1,321 @@
+#include "FlexCounterScheduler.h"
+#include "FlexCounter.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <inttypes.h>
+
+#define FLEX_COUNTER_SCHEDULER_STATS_LOG_INTERVAL_MS (60 * 1000)
+
+using namespace syncd;
+
+FlexCounterScheduler::FlexCounterScheduler(
+        _In_ size_t threadCount):
+    m_start(std::chrono::steady_clock::now()),
+    m_lastStatsLog(0),
+    m_runThreads(true)
+{
+    SWSS_LOG_ENTER();
+
+    if (threadCount == 0)
+    {
+        SWSS_LOG_THROW("thread count must be at least 1");
+    }
+
+    for (size_t idx = 0; idx < threadCount; idx++)
+    {
+        m_threads.push_back(std::make_shared<std::thread>(&FlexCounterScheduler::schedulerThreadFunction, this));
+    }
+
+    SWSS_LOG_NOTICE("flex counter scheduler started with %zu threads", threadCount);
+}
+
+FlexCounterScheduler::~FlexCounterScheduler()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_runThreads = false;
+    }
+
+    m_cv.notify_all();
+
+    for (auto& thread: m_threads)
+    {
+        thread->join();
+    }
+
+    SWSS_LOG_NOTICE("flex counter scheduler ended");
+}
+
+uint64_t FlexCounterScheduler::now() const
+{
+    SWSS_LOG_ENTER();
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void FlexCounterScheduler::addGroup(
+        _In_ FlexCounter* flexCounter,
+        _In_ const std::string& name)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t id = (uint64_t)(uintptr_t)flexCounter;
+
+    Group group;
+
+    group.flexCounter = flexCounter;
+    group.name = name;
+    group.phase = std::hash<std::string>()(name);
+    group.pollInterval = 0;
+    group.deadline = 0;
+    group.running = false;
+    group.wakeUpPending = false;
+    group.pollCount = 0;
+    group.lastLag = 0;
+    group.maxLag = 0;
+    group.totalLag = 0;
+
+    m_groups[id] = group;
+}
+
+void FlexCounterScheduler::removeGroup(
+        _In_ FlexCounter* flexCounter)
+{
+    SWSS_LOG_ENTER();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    uint64_t id = (uint64_t)(uintptr_t)flexCounter;
+
+    auto it = m_groups.find(id);
+
+    if (it == m_groups.end())
+    {
+        return;
+    }
+
+    m_cvGroupIdle.wait(lock, [&]{ return !it->second.running; });
+
+    m_wheel.cancel(id);
+
+    m_ready.erase(std::remove(m_ready.begin(), m_ready.end(), id), m_ready.end());
+
+    m_groups.erase(it);
+}
+
+void FlexCounterScheduler::wakeUp(
+        _In_ FlexCounter* flexCounter)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint64_t id = (uint64_t)(uintptr_t)flexCounter;
+
+    auto it = m_groups.find(id);
+
+    if (it == m_groups.end())
+    {
+        return;
+    }
+
+    auto& group = it->second;
+
+    if (group.running)
+    {
+        // group will be rescheduled when poll ends
+
+        group.wakeUpPending = true;
+        return;
+    }
+
+    if (m_wheel.isScheduled(id) || std::find(m_ready.begin(), m_ready.end(), id) != m_ready.end())
+    {
+        return; // already polling
+    }
+
+    group.deadline = now();
+
+    m_ready.push_back(id);
+
+    m_cv.notify_one();
+}
+
+void FlexCounterScheduler::scheduleNext(
+        _In_ uint64_t id,
+        _In_ uint32_t pollInterval)
+{
+    SWSS_LOG_ENTER();
+
+    auto& group = m_groups.at(id);
+
+    uint64_t current = now();
+
+    // next deadline is on group phase grid, so polls don't drift and group
+    // which overran its interval skips missed polls instead of bursting
+
+    uint64_t phase = group.phase % pollInterval;
+
+    uint64_t next = (current < phase)
+        ? phase
+        : ((current - phase) / pollInterval + 1) * pollInterval + phase;
+
+    group.deadline = next;
+
+    m_wheel.schedule(id, next);
+}
+
+void FlexCounterScheduler::logStats()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& kvp: m_groups)
+    {
+        auto& group = kvp.second;
+
+        if (group.pollCount == 0)
+        {
+            continue;
+        }
+
+        uint64_t avgLag = group.totalLag / group.pollCount;
+
+        // lag longer than poll interval means group missed polls
+
+        if (group.pollInterval && group.maxLag >= group.pollInterval)
+        {
+            SWSS_LOG_NOTICE("flex counter group %s: polls %" PRIu64 ", lag last %" PRIu64 " ms, avg %" PRIu64 " ms, max %" PRIu64 " ms, interval %u ms",
+                    group.name.c_str(), group.pollCount, group.lastLag, avgLag, group.maxLag, group.pollInterval);
+        }
+        else
+        {
+            SWSS_LOG_INFO("flex counter group %s: polls %" PRIu64 ", lag last %" PRIu64 " ms, avg %" PRIu64 " ms, max %" PRIu64 " ms, interval %u ms",
+                    group.name.c_str(), group.pollCount, group.lastLag, avgLag, group.maxLag, group.pollInterval);
+        }
+
+        group.pollCount = 0;
+        group.maxLag = 0;
+        group.totalLag = 0;
+    }
+}
+
+void FlexCounterScheduler::schedulerThreadFunction()
+{
+    SWSS_LOG_ENTER();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    std::vector<uint64_t> expired;
+
+    while (m_runThreads)
+    {
+        uint64_t current = now();
+
+        expired.clear();
+
+        m_wheel.advance(current, expired);
+
+        m_ready.insert(m_ready.end(), expired.begin(), expired.end());
+
+        if (current - m_lastStatsLog >= FLEX_COUNTER_SCHEDULER_STATS_LOG_INTERVAL_MS)
+        {
+            m_lastStatsLog = current;
+
+            logStats();
+        }
+
+        if (m_ready.empty())
+        {
+            uint64_t next;
+
+            if (m_wheel.getNextExpireTick(next))
+            {
+                m_cv.wait_for(lock, std::chrono::milliseconds(next - current));
+            }
+            else
+            {
+                m_cv.wait(lock);
+            }
+
+            continue;
+        }
+
+        uint64_t id = m_ready.front();
+
+        m_ready.pop_front();
+
+        auto it = m_groups.find(id);
+
+        if (it == m_groups.end())
+        {
+            continue;
+        }
+
+        // map references are stable and group can't be removed while it's
+        // running, so reference is valid after unlock
+
+        auto& group = it->second;
+
+        group.running = true;
+        group.wakeUpPending = false;
+
+        uint64_t lag = (current > group.deadline) ? current - group.deadline : 0;
+
+        group.pollCount++;
+        group.lastLag = lag;
+        group.maxLag = std::max(group.maxLag, lag);
+        group.totalLag += lag;
+
+        // when poll fails, group is rescheduled with previous interval, so
+        // transient error don't stop polling
+
+        uint32_t pollInterval = group.pollInterval;
+
+        lock.unlock();
+
+        try
+        {
+            pollInterval = group.flexCounter->poll();
+        }
+        catch (const std::exception& e)
+        {
+            SWSS_LOG_ERROR("flex counter group %s poll failed: %s, retrying in %u ms",
+                    group.name.c_str(),
+                    e.what(),
+                    pollInterval);
+        }
+
+        lock.lock();
+
+        group.running = false;
+        group.pollInterval = pollInterval;
+
+        if (pollInterval)
+        {
+            scheduleNext(id, pollInterval);
+
+            m_cv.notify_one();
+        }
+        else if (group.wakeUpPending)
+        {
+            // configuration changed during poll, poll again
+
+            group.deadline = now();
+
+            m_ready.push_back(id);
+        }
+
+        group.wakeUpPending = false;
+
+        m_cvGroupIdle.notify_all();
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "TimerWheel.h"
+
+#include <string>
+#include <map>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace syncd
+{
+    class FlexCounter;
+
+    /**
+     * @brief Flex counter scheduler.
+     *
+     * Polls all flex counter groups from bounded number of threads instead
+     * of thread per group. Poll deadlines are kept in timer wheel, each
+     * group polls on its own phase within poll interval derived from group
+     * name, so groups with the same interval don't poll in bursts.
+     * Scheduling lag (poll start - deadline) is tracked per group and
+     * logged periodically.
+     */
+    class FlexCounterScheduler
+    {
+        private:
+
+            FlexCounterScheduler(const FlexCounterScheduler&) = delete;
+
+        public:
+
+            FlexCounterScheduler(
+                    _In_ size_t threadCount);
+
+            virtual ~FlexCounterScheduler();
+
+        public:
+
+            /**
+             * @brief Add group to scheduler, group is not polled until woken
+             * up.
+             */
+            void addGroup(
+                    _In_ FlexCounter* group,
+                    _In_ const std::string& name);
+
+            /**
+             * @brief Remove group from scheduler, waits if group is being
+             * polled.
+             */
+            void removeGroup(
+                    _In_ FlexCounter* group);
+
+            /**
+             * @brief Notify scheduler that group configuration changed, idle
+             * group is polled immediately.
+             */
+            void wakeUp(
+                    _In_ FlexCounter* group);
+
+        private:
+
+            void schedulerThreadFunction();
+
+            uint64_t now() const;
+
+            void scheduleNext(
+                    _In_ uint64_t id,
+                    _In_ uint32_t pollInterval);
+
+            void logStats();
+
+        private:
+
+            struct Group
+            {
+                FlexCounter* flexCounter;
+
+                std::string name;
+
+                uint64_t phase;
+
+                uint32_t pollInterval;
+
+                uint64_t deadline;
+
+                bool running;
+
+                bool wakeUpPending;
+
+                uint64_t pollCount;
+
+                uint64_t lastLag;
+
+                uint64_t maxLag;
+
+                uint64_t totalLag;
+            };
+
+            std::map<uint64_t, Group> m_groups;
+
+            std::deque<uint64_t> m_ready;
+
+            TimerWheel m_wheel;
+
+            std::chrono::steady_clock::time_point m_start;
+
+            uint64_t m_lastStatsLog;
+
+            bool m_runThreads;
+
+            std::mutex m_mutex;
+
+            std::condition_variable m_cv;
+
+            std::condition_variable m_cvGroupIdle;
+
+            std::vector<std::shared_ptr<std::thread>> m_threads;
+    };
+}
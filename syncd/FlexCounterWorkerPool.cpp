@@ -0,0 +1,137 @@
+#include "FlexCounterWorkerPool.h"
+
+#include "swss/logger.h"
+#include "swss/schema.h"
+
+using namespace syncd;
+
+FlexCounterWorkerPool::FlexCounterWorkerPool(
+        _In_ size_t workerCount,
+        _In_ const std::string& dbCounters):
+    m_generation(0),
+    m_pending(0),
+    m_runThreads(true)
+{
+    SWSS_LOG_ENTER();
+
+    if (workerCount == 0)
+    {
+        SWSS_LOG_THROW("worker count must be at least 1");
+    }
+
+    // connections are created here, so failure is reported to the caller
+    // and not in worker thread
+
+    m_workers.resize(workerCount);
+
+    for (auto& worker: m_workers)
+    {
+        worker.db = std::make_shared<swss::DBConnector>(dbCounters, 0);
+        worker.pipeline = std::make_shared<swss::RedisPipeline>(worker.db.get());
+        worker.countersTable = std::make_shared<swss::Table>(worker.pipeline.get(), COUNTERS_TABLE, true);
+    }
+
+    for (size_t idx = 0; idx < workerCount; idx++)
+    {
+        m_workers[idx].thread = std::make_shared<std::thread>(&FlexCounterWorkerPool::workerThreadFunction, this, idx);
+    }
+
+    SWSS_LOG_NOTICE("flex counter worker pool started with %zu workers", workerCount);
+}
+
+FlexCounterWorkerPool::~FlexCounterWorkerPool()
+{
+    SWSS_LOG_ENTER();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_runThreads = false;
+    }
+
+    m_cvTask.notify_all();
+
+    for (auto& worker: m_workers)
+    {
+        worker.thread->join();
+    }
+
+    SWSS_LOG_NOTICE("flex counter worker pool ended");
+}
+
+size_t FlexCounterWorkerPool::getWorkerCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_workers.size();
+}
+
+void FlexCounterWorkerPool::run(
+        _In_ const task_t& task)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> runLock(m_runMutex);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_task = task;
+
+    m_pending = m_workers.size();
+
+    m_generation++;
+
+    m_cvTask.notify_all();
+
+    m_cvDone.wait(lock, [&]{ return m_pending == 0; });
+
+    m_task = nullptr;
+}
+
+void FlexCounterWorkerPool::workerThreadFunction(
+        _In_ size_t shardIndex)
+{
+    SWSS_LOG_ENTER();
+
+    auto& countersTable = *m_workers.at(shardIndex).countersTable;
+
+    uint64_t generation = 0;
+
+    while (true)
+    {
+        task_t task;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_cvTask.wait(lock, [&]{ return !m_runThreads || m_generation != generation; });
+
+            if (!m_runThreads)
+            {
+                break;
+            }
+
+            generation = m_generation;
+
+            task = m_task;
+        }
+
+        try
+        {
+            task(shardIndex, m_workers.size(), countersTable);
+
+            countersTable.flush();
+        }
+        catch (const std::exception& e)
+        {
+            SWSS_LOG_ERROR("flex counter worker %zu failed: %s", shardIndex, e.what());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (--m_pending == 0)
+        {
+            m_cvDone.notify_all();
+        }
+    }
+}
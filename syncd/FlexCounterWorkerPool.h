@@ -0,0 +1,90 @@
+#pragma once
+
+#include "swss/table.h"
+#include "swss/dbconnector.h"
+#include "swss/redispipeline.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace syncd
+{
+    /**
+     * @brief Flex counter worker pool.
+     *
+     * Threads shared by all flex counter groups. Collection cycle is split
+     * into shards, one per worker, and each worker writes its shard using
+     * own COUNTERS_DB connection and pipeline. Only one cycle runs on pool at
+     * a time, other groups wait for pool to become available.
+     */
+    class FlexCounterWorkerPool
+    {
+        private:
+
+            FlexCounterWorkerPool(const FlexCounterWorkerPool&) = delete;
+
+        public:
+
+            typedef std::function<void(size_t shardIndex, size_t shardCount, swss::Table& countersTable)> task_t;
+
+            FlexCounterWorkerPool(
+                    _In_ size_t workerCount,
+                    _In_ const std::string& dbCounters);
+
+            virtual ~FlexCounterWorkerPool();
+
+        public:
+
+            size_t getWorkerCount() const;
+
+            /**
+             * @brief Execute task on each worker with worker shard index and
+             * counters table.
+             *
+             * Returns when all workers finished the task and flushed their
+             * pipelines.
+             */
+            void run(
+                    _In_ const task_t& task);
+
+        private:
+
+            void workerThreadFunction(
+                    _In_ size_t shardIndex);
+
+        private:
+
+            struct Worker
+            {
+                std::shared_ptr<swss::DBConnector> db;
+
+                std::shared_ptr<swss::RedisPipeline> pipeline;
+
+                std::shared_ptr<swss::Table> countersTable;
+
+                std::shared_ptr<std::thread> thread;
+            };
+
+            std::vector<Worker> m_workers;
+
+            std::mutex m_runMutex;
+
+            std::mutex m_mutex;
+
+            std::condition_variable m_cvTask;
+
+            std::condition_variable m_cvDone;
+
+            task_t m_task;
+
+            uint64_t m_generation;
+
+            size_t m_pending;
+
+            bool m_runThreads;
+    };
+}
@@ -3,6 +3,8 @@
 #include "SingleReiniter.h"
 #include "RedisClient.h"
 
+#include "sairediscommon.h"
+
 #include "swss/logger.h"
 
 #include "meta/sai_serialize.h"
@@ -56,10 +58,11 @@ void HardReiniter::readAsicState()
         m_switchRidToVid[switchId][r2v.first] = r2v.second;
     }
 
-    auto asicStateKeys = m_client->getAsicStateKeys();
+    // keys and attributes are loaded together, so single reiniter don't
+    // need to query redis for each object
+
+    m_client->scanAsicState(ASIC_STATE_TABLE, [this](const std::string& key, const std::vector<swss::FieldValueTuple>& values) {
 
-    for (const auto &key: asicStateKeys)
-    {
         auto mk = key.substr(key.find_first_of(":") + 1); // skip asic key
 
         sai_object_meta_key_t metaKey;
@@ -69,8 +72,8 @@ void HardReiniter::readAsicState()
 
         auto switchId = VidManager::switchIdQuery(metaKey.objectkey.key.object_id);
 
-        m_switchMap[switchId].push_back(key);
-    }
+        m_switchMap[switchId][key] = values;
+    });
 
     SWSS_LOG_NOTICE("loaded %zu switches", m_switchMap.size());
 
@@ -99,7 +102,7 @@ std::map<sai_object_id_t, std::shared_ptr<syncd::SaiSwitch>> HardReiniter::hardR
                 m_handler,
                 m_switchVidToRid.at(kvp.first),
                 m_switchRidToVid.at(kvp.first),
-                kvp.second);
+                std::move(kvp.second)); // single reiniter takes over switch state
 
         sr->hardReinit();
 
@@ -142,7 +145,7 @@ std::map<sai_object_id_t, std::shared_ptr<syncd::SaiSwitch>> HardReiniter::hardR
      * This needs to be addressed when we want to support multiple switches.
      */
 
-    m_client->setVidAndRidMap(vid2rid);
+    m_translator->setVidAndRidMap(vid2rid);
 
     std::map<sai_object_id_t, std::shared_ptr<syncd::SaiSwitch>> switches;
 
@@ -5,6 +5,7 @@
 #include "VirtualOidTranslator.h"
 #include "RedisClient.h"
 #include "NotificationHandler.h"
+#include "SingleReiniter.h"
 
 #include <string>
 #include <unordered_map>
@@ -50,7 +51,7 @@ namespace syncd
             std::map<sai_object_id_t, ObjectIdMap> m_switchVidToRid;
             std::map<sai_object_id_t, ObjectIdMap> m_switchRidToVid;
 
-            std::map<sai_object_id_t, std::vector<std::string>> m_switchMap;
+            std::map<sai_object_id_t, SingleReiniter::AsicState> m_switchMap;
 
             std::shared_ptr<sairedis::SaiInterface> m_vendorSai;
 
@@ -0,0 +1,204 @@
+#include "NotificationLane.h"
+
+#include "swss/logger.h"
+
+using namespace syncd;
+
+NotificationLane::NotificationLane(
+        _In_ size_t limit):
+    m_limit(limit ? limit : 1),
+    m_enqueuePos(0),
+    m_dequeuePos(0),
+    m_enqueueCount(0),
+    m_dequeueCount(0),
+    m_dropCount(0)
+{
+    SWSS_LOG_ENTER();
+
+    // round capacity up to power of 2 so position can be masked
+
+    m_capacity = 2;
+
+    while (m_capacity < m_limit)
+    {
+        m_capacity <<= 1;
+    }
+
+    m_mask = m_capacity - 1;
+
+    m_cells.reset(new Cell[m_capacity]);
+
+    for (size_t idx = 0; idx < m_capacity; idx++)
+    {
+        m_cells[idx].sequence.store(idx, std::memory_order_relaxed);
+        m_cells[idx].item = nullptr;
+    }
+}
+
+NotificationLane::~NotificationLane()
+{
+    SWSS_LOG_ENTER();
+
+    swss::KeyOpFieldsValuesTuple* item;
+
+    while ((item = pop()) != nullptr)
+    {
+        delete item;
+    }
+}
+
+bool NotificationLane::push(
+        _In_ swss::KeyOpFieldsValuesTuple* item)
+{
+    SWSS_LOG_ENTER();
+
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        Cell& cell = m_cells[pos & m_mask];
+
+        size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0)
+        {
+            // cell is free, try to claim it
+
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.item = item;
+
+                cell.sequence.store(pos + 1, std::memory_order_release);
+
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false; // ring is full
+        }
+        else
+        {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+swss::KeyOpFieldsValuesTuple* NotificationLane::pop()
+{
+    SWSS_LOG_ENTER();
+
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+    Cell& cell = m_cells[pos & m_mask];
+
+    size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+    if (seq != pos + 1)
+    {
+        return nullptr; // lane is empty or producer didn't finish write yet
+    }
+
+    auto item = cell.item;
+
+    cell.item = nullptr;
+
+    cell.sequence.store(pos + m_capacity, std::memory_order_release);
+
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+    return item;
+}
+
+bool NotificationLane::enqueue(
+        _In_ const swss::KeyOpFieldsValuesTuple& item)
+{
+    SWSS_LOG_ENTER();
+
+    if (getSize() < m_limit)
+    {
+        auto copy = new swss::KeyOpFieldsValuesTuple(item);
+
+        if (push(copy))
+        {
+            m_enqueueCount.fetch_add(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        delete copy;
+    }
+
+    m_dropCount.fetch_add(1, std::memory_order_relaxed);
+
+    return false;
+}
+
+size_t NotificationLane::dequeue(
+        _Inout_ std::vector<swss::KeyOpFieldsValuesTuple>& items,
+        _In_ size_t maxCount)
+{
+    SWSS_LOG_ENTER();
+
+    size_t count = 0;
+
+    while (count < maxCount)
+    {
+        auto ptr = pop();
+
+        if (ptr == nullptr)
+        {
+            break;
+        }
+
+        items.push_back(std::move(*ptr));
+
+        delete ptr;
+
+        count++;
+    }
+
+    m_dequeueCount.fetch_add(count, std::memory_order_relaxed);
+
+    return count;
+}
+
+size_t NotificationLane::getSize() const
+{
+    SWSS_LOG_ENTER();
+
+    size_t dequeuePos = m_dequeuePos.load(std::memory_order_relaxed);
+    size_t enqueuePos = m_enqueuePos.load(std::memory_order_relaxed);
+
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+}
+
+size_t NotificationLane::getLimit() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_limit;
+}
+
+uint64_t NotificationLane::getEnqueueCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_enqueueCount.load(std::memory_order_relaxed);
+}
+
+uint64_t NotificationLane::getDequeueCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_dequeueCount.load(std::memory_order_relaxed);
+}
+
+uint64_t NotificationLane::getDropCount() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_dropCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "swss/table.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace syncd
+{
+    /**
+     * @brief Notification lane.
+     *
+     * Bounded lock-free multi producer single consumer queue. Producers are
+     * SAI notification callbacks (possibly on multiple vendor threads), and
+     * consumer is notification processing thread. Notifications are dropped
+     * when lane size reaches limit.
+     */
+    class NotificationLane
+    {
+        public:
+
+            NotificationLane(
+                    _In_ size_t limit);
+
+            virtual ~NotificationLane();
+
+        public:
+
+            /**
+             * @brief Enqueue notification, can be called from multiple threads.
+             *
+             * @return False if lane is full and notification was dropped.
+             */
+            bool enqueue(
+                    _In_ const swss::KeyOpFieldsValuesTuple& item);
+
+            /**
+             * @brief Dequeue up to maxCount notifications and append them to
+             * items, only one consumer thread is allowed.
+             *
+             * @return Number of dequeued items.
+             */
+            size_t dequeue(
+                    _Inout_ std::vector<swss::KeyOpFieldsValuesTuple>& items,
+                    _In_ size_t maxCount);
+
+            size_t getSize() const;
+
+            size_t getLimit() const;
+
+            uint64_t getEnqueueCount() const;
+
+            uint64_t getDequeueCount() const;
+
+            uint64_t getDropCount() const;
+
+        private:
+
+            bool push(
+                    _In_ swss::KeyOpFieldsValuesTuple* item);
+
+            swss::KeyOpFieldsValuesTuple* pop();
+
+        private:
+
+            struct Cell
+            {
+                std::atomic<size_t> sequence;
+
+                swss::KeyOpFieldsValuesTuple* item;
+            };
+
+            size_t m_limit;
+
+            size_t m_capacity;
+
+            size_t m_mask;
+
+            std::unique_ptr<Cell[]> m_cells;
+
+            // producers and consumer positions are kept on different cache lines
+
+            char m_pad0[64];
+
+            std::atomic<size_t> m_enqueuePos;
+
+            char m_pad1[64];
+
+            std::atomic<size_t> m_dequeuePos;
+
+            char m_pad2[64];
+
+            std::atomic<uint64_t> m_enqueueCount;
+
+            std::atomic<uint64_t> m_dequeueCount;
+
+            std::atomic<uint64_t> m_dropCount;
+    };
+}
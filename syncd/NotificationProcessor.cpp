@@ -11,22 +11,35 @@
 
 #include <inttypes.h>
 
+#define NOTIFICATION_PROCESSOR_BATCH_SIZE (128)
+
+#define NOTIFICATION_QUEUE_STATS_INTERVAL_SEC (60)
+
 using namespace syncd;
 using namespace saimeta;
 
 NotificationProcessor::NotificationProcessor(
         _In_ std::shared_ptr<NotificationProducerBase> producer,
         _In_ std::shared_ptr<RedisClient> client,
-        _In_ std::function<void(const swss::KeyOpFieldsValuesTuple&)> synchronizer):
+        _In_ std::function<void(const std::vector<swss::KeyOpFieldsValuesTuple>&)> synchronizer,
+        _In_ std::shared_ptr<NotificationQueue> queue):
     m_synchronizer(synchronizer),
     m_client(client),
-    m_notifications(producer)
+    m_notifications(producer),
+    m_lastEnqueueCount(0),
+    m_lastDequeueCount(0),
+    m_lastDropCount(0),
+    m_lastFdbSuppressedCount(0)
 {
     SWSS_LOG_ENTER();
 
     m_runThread = false;
 
-    m_notificationQueue = std::make_shared<NotificationQueue>();
+    m_notificationQueue = queue;
+
+    m_fdbCoalescer = std::make_shared<FdbEventCoalescer>();
+
+    m_lastStatsTime = std::chrono::steady_clock::now();
 }
 
 NotificationProcessor::~NotificationProcessor()
@@ -347,6 +360,78 @@ void NotificationProcessor::process_on_fdb_event(
     }
 }
 
+void NotificationProcessor::coalesce_fdb_event(
+        _In_ uint32_t count,
+        _In_ sai_fdb_event_notification_data_t *data)
+{
+    SWSS_LOG_ENTER();
+
+    bool passThrough = contains_fdb_flush_event(count, data);
+
+    for (uint32_t i = 0; i < count && !passThrough; i++)
+    {
+        passThrough = !check_fdb_event_notification_data(data[i]);
+    }
+
+    if (passThrough)
+    {
+        // flush events and notifications with invalid OIDs are processed
+        // as they are, but after all events coalesced before them
+
+        flush_coalesced_fdb_events();
+
+        process_on_fdb_event(count, data);
+
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        m_fdbCoalescer->add(data[i]);
+    }
+}
+
+void NotificationProcessor::flush_coalesced_fdb_events()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_fdbCoalescer->empty())
+    {
+        return;
+    }
+
+    auto events = m_fdbCoalescer->take();
+
+    std::vector<sai_fdb_event_notification_data_t> data;
+
+    data.reserve(events.size());
+
+    for (auto& event: events)
+    {
+        // objects could be removed during coalescing window, stale entry is
+        // dropped alone, so it will not prevent publishing other entries
+
+        if (!check_fdb_event_notification_data(event.data))
+        {
+            SWSS_LOG_WARN("dropping coalesced fdb event with stale OIDs: %s",
+                    sai_serialize_fdb_entry(event.data.fdb_entry).c_str());
+
+            continue;
+        }
+
+        data.push_back(event.data);
+    }
+
+    if (data.empty())
+    {
+        return;
+    }
+
+    SWSS_LOG_INFO("flushing %zu coalesced fdb events", data.size());
+
+    process_on_fdb_event((uint32_t)data.size(), data.data());
+}
+
 void NotificationProcessor::process_on_queue_deadlock_event(
         _In_ uint32_t count,
         _In_ sai_queue_deadlock_notification_data_t *data)
@@ -460,7 +545,14 @@ void NotificationProcessor::handle_fdb_event(
         SWSS_LOG_NOTICE("got fdb flush event: %s", data.c_str());
     }
 
-    process_on_fdb_event(count, fdbevent);
+    if (m_fdbCoalescer->isEnabled())
+    {
+        coalesce_fdb_event(count, fdbevent);
+    }
+    else
+    {
+        process_on_fdb_event(count, fdbevent);
+    }
 
     sai_deserialize_free_fdb_event_ntf(count, fdbevent);
 }
@@ -507,12 +599,77 @@ void NotificationProcessor::handle_switch_shutdown_request(
     process_on_switch_shutdown_request(switch_id);
 }
 
-void NotificationProcessor::processNotification(
-        _In_ const swss::KeyOpFieldsValuesTuple& item)
+void NotificationProcessor::processNotifications(
+        _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items)
 {
     SWSS_LOG_ENTER();
 
-    m_synchronizer(item);
+    m_synchronizer(items);
+}
+
+void NotificationProcessor::logQueueStats()
+{
+    SWSS_LOG_ENTER();
+
+    auto now = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(now - m_lastStatsTime).count();
+
+    if (seconds < NOTIFICATION_QUEUE_STATS_INTERVAL_SEC)
+    {
+        return;
+    }
+
+    uint64_t enqueueCount = m_notificationQueue->getEnqueueCount();
+    uint64_t dequeueCount = m_notificationQueue->getDequeueCount();
+    uint64_t dropCount = m_notificationQueue->getDropCount();
+
+    uint64_t fdbSuppressedCount = m_fdbCoalescer->getSuppressedCount();
+
+    uint64_t drops = dropCount - m_lastDropCount;
+
+    if (enqueueCount != m_lastEnqueueCount || drops)
+    {
+        char buffer[320];
+
+        snprintf(buffer, sizeof(buffer),
+                "notification queue: enqueue %.1f/s, dequeue %.1f/s, drop %.1f/s, size %zu, total drops %" PRIu64
+                ", fdb events suppressed %.1f/s, total suppressed %" PRIu64,
+                (double)(enqueueCount - m_lastEnqueueCount) / seconds,
+                (double)(dequeueCount - m_lastDequeueCount) / seconds,
+                (double)drops / seconds,
+                m_notificationQueue->getQueueSize(),
+                dropCount,
+                (double)(fdbSuppressedCount - m_lastFdbSuppressedCount) / seconds,
+                fdbSuppressedCount);
+
+        if (drops)
+        {
+            SWSS_LOG_NOTICE("%s", buffer);
+
+            for (int idx = 0; idx < NOTIFICATION_CLASS_MAX; idx++)
+            {
+                auto lane = m_notificationQueue->getLane((NotificationClass)idx);
+
+                SWSS_LOG_NOTICE("notification lane %s: size %zu/%zu, enqueued %" PRIu64 ", dropped %" PRIu64,
+                        NotificationQueue::getNotificationClassName((NotificationClass)idx),
+                        lane->getSize(),
+                        lane->getLimit(),
+                        lane->getEnqueueCount(),
+                        lane->getDropCount());
+            }
+        }
+        else
+        {
+            SWSS_LOG_INFO("%s", buffer);
+        }
+    }
+
+    m_lastStatsTime = now;
+    m_lastEnqueueCount = enqueueCount;
+    m_lastDequeueCount = dequeueCount;
+    m_lastDropCount = dropCount;
+    m_lastFdbSuppressedCount = fdbSuppressedCount;
 }
 
 void NotificationProcessor::syncProcessNotification(
@@ -549,6 +706,22 @@ void NotificationProcessor::syncProcessNotification(
     }
 }
 
+void NotificationProcessor::syncProcessNotifications(
+        _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& item: items)
+    {
+        syncProcessNotification(item);
+    }
+
+    if (!m_fdbCoalescer->empty() && (!m_runThread || m_fdbCoalescer->getTimeToExpire().count() == 0))
+    {
+        flush_coalesced_fdb_events();
+    }
+}
+
 void NotificationProcessor::ntf_process_function()
 {
     SWSS_LOG_ENTER();
@@ -559,19 +732,42 @@ void NotificationProcessor::ntf_process_function()
 
     while (m_runThread)
     {
-        m_cv.wait(ulock);
+        if (m_fdbCoalescer->empty())
+        {
+            m_cv.wait(ulock);
+        }
+        else
+        {
+            // wake up when coalescing window of pending fdb events expires
+
+            m_cv.wait_for(ulock, m_fdbCoalescer->getTimeToExpire());
+        }
 
         // this is notifications processing thread context, which is different
         // from SAI notifications context, we can safe use syncd mutex here,
         // processing each notification is under same mutex as processing main
         // events, counters and reinit
 
-        swss::KeyOpFieldsValuesTuple item;
+        // whole batch is processed under single syncd mutex acquire, which
+        // is released between batches so main events are not starved
 
-        while (m_notificationQueue->tryDequeue(item))
+        std::vector<swss::KeyOpFieldsValuesTuple> items;
+
+        items.reserve(NOTIFICATION_PROCESSOR_BATCH_SIZE);
+
+        while (m_notificationQueue->tryDequeueBatch(items, NOTIFICATION_PROCESSOR_BATCH_SIZE))
         {
-            processNotification(item);
+            processNotifications(items);
         }
+
+        if (!m_fdbCoalescer->empty() && (!m_runThread || m_fdbCoalescer->getTimeToExpire().count() == 0))
+        {
+            items.clear();
+
+            processNotifications(items); // empty batch will flush coalesced fdb events
+        }
+
+        logQueueStats();
     }
 }
 
@@ -600,6 +796,16 @@ void NotificationProcessor::stopNotificationsProcessingThread()
     m_ntf_process_thread = nullptr;
 }
 
+void NotificationProcessor::setFdbCoalesceWindow(
+        _In_ uint32_t windowMs)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("setting fdb events coalescing window to %u ms", windowMs);
+
+    m_fdbCoalescer->setWindow(windowMs);
+}
+
 void NotificationProcessor::signal()
 {
     SWSS_LOG_ENTER();
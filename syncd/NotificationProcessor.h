@@ -1,6 +1,7 @@
 #pragma once
 
 #include "NotificationQueue.h"
+#include "FdbEventCoalescer.h"
 #include "VirtualOidTranslator.h"
 #include "RedisClient.h"
 #include "NotificationProducerBase.h"
@@ -11,6 +12,7 @@
 #include <memory>
 #include <condition_variable>
 #include <functional>
+#include <chrono>
 
 namespace syncd
 {
@@ -21,7 +23,8 @@ namespace syncd
             NotificationProcessor(
                     _In_ std::shared_ptr<NotificationProducerBase> producer,
                     _In_ std::shared_ptr<RedisClient> client,
-                    _In_ std::function<void(const swss::KeyOpFieldsValuesTuple&)> synchronizer);
+                    _In_ std::function<void(const std::vector<swss::KeyOpFieldsValuesTuple>&)> synchronizer,
+                    _In_ std::shared_ptr<NotificationQueue> queue);
 
             virtual ~NotificationProcessor();
 
@@ -35,6 +38,13 @@ namespace syncd
 
             void stopNotificationsProcessingThread();
 
+            /**
+             * @brief Set FDB events coalescing window in milliseconds, zero
+             * disables coalescing.
+             */
+            void setFdbCoalesceWindow(
+                    _In_ uint32_t windowMs);
+
         private:
 
             void ntf_process_function();
@@ -62,6 +72,12 @@ namespace syncd
                     _In_ uint32_t count,
                     _In_ const sai_fdb_event_notification_data_t *data);
 
+            void coalesce_fdb_event(
+                    _In_ uint32_t count,
+                    _In_ sai_fdb_event_notification_data_t *data);
+
+            void flush_coalesced_fdb_events();
+
         private: // processors
 
             void process_on_switch_state_change(
@@ -101,14 +117,23 @@ namespace syncd
             void handle_switch_shutdown_request(
                     _In_ const std::string &data);
 
-            void processNotification(
-                    _In_ const swss::KeyOpFieldsValuesTuple& item);
+            void processNotifications(
+                    _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items);
+
+            void logQueueStats();
 
         public:
 
             void syncProcessNotification(
                     _In_ const swss::KeyOpFieldsValuesTuple& item);
 
+            /**
+             * @brief Process batch of notifications, and coalesced FDB events
+             * which window expired. Batch can be empty.
+             */
+            void syncProcessNotifications(
+                    _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items);
+
         public: // TODO to private
 
             std::shared_ptr<VirtualOidTranslator> m_translator;
@@ -117,6 +142,8 @@ namespace syncd
 
             std::shared_ptr<NotificationQueue> m_notificationQueue;
 
+            std::shared_ptr<FdbEventCoalescer> m_fdbCoalescer;
+
             std::shared_ptr<std::thread> m_ntf_process_thread;
 
             // condition variable will be used to notify processing thread
@@ -128,10 +155,22 @@ namespace syncd
 
             bool m_runThread;
 
-            std::function<void(const swss::KeyOpFieldsValuesTuple&)> m_synchronizer;
+            std::function<void(const std::vector<swss::KeyOpFieldsValuesTuple>&)> m_synchronizer;
 
             std::shared_ptr<RedisClient> m_client;
 
             std::shared_ptr<NotificationProducerBase> m_notifications;
+
+            // queue counters from last stats log, used to compute rates
+
+            std::chrono::steady_clock::time_point m_lastStatsTime;
+
+            uint64_t m_lastEnqueueCount;
+
+            uint64_t m_lastDequeueCount;
+
+            uint64_t m_lastDropCount;
+
+            uint64_t m_lastFdbSuppressedCount;
     };
 }
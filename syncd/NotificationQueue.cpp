@@ -1,20 +1,36 @@
 #include "NotificationQueue.h"
 #include "sairediscommon.h"
 
+#include <inttypes.h>
+#include <algorithm>
+
 #define NOTIFICATION_QUEUE_DROP_COUNT_INDICATOR (1000)
 
 using namespace syncd;
 
-#define MUTEX std::lock_guard<std::mutex> _lock(m_mutex);
-
 NotificationQueue::NotificationQueue(
-        _In_ size_t queueLimit):
-    m_queueSizeLimit(queueLimit),
-    m_dropCount(0)
+        _In_ size_t queueLimit,
+        _In_ size_t laneLimit):
+    m_policy(NOTIFICATION_DEQUEUE_POLICY_STRICT),
+    m_weights(NOTIFICATION_CLASS_MAX, 0)
 {
     SWSS_LOG_ENTER();
 
-    // empty;
+    for (int idx = 0; idx < NOTIFICATION_CLASS_MAX; idx++)
+    {
+        /*
+         * FDB lane limit is based on typical L2 deployment, other lanes
+         * carry much less events, but they are not expected to drop.
+         */
+
+        size_t limit = (idx == NOTIFICATION_CLASS_FDB) ? queueLimit : laneLimit;
+
+        m_lanes.push_back(std::make_shared<NotificationLane>(limit));
+
+        SWSS_LOG_INFO("notification lane %s limit %zu",
+                getNotificationClassName((NotificationClass)idx),
+                limit);
+    }
 }
 
 NotificationQueue::~NotificationQueue()
@@ -24,36 +40,100 @@ NotificationQueue::~NotificationQueue()
     // empty
 }
 
+NotificationClass NotificationQueue::getNotificationClass(
+        _In_ const std::string& name)
+{
+    SWSS_LOG_ENTER();
+
+    // TODO use enum instead of strings
+
+    if (name == SAI_SWITCH_NOTIFICATION_NAME_FDB_EVENT)
+        return NOTIFICATION_CLASS_FDB;
+
+    if (name == SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE)
+        return NOTIFICATION_CLASS_PORT_STATE;
+
+    if (name == SAI_SWITCH_NOTIFICATION_NAME_SWITCH_SHUTDOWN_REQUEST ||
+            name == SAI_SWITCH_NOTIFICATION_NAME_SWITCH_STATE_CHANGE)
+        return NOTIFICATION_CLASS_SWITCH;
+
+    if (name == SAI_SWITCH_NOTIFICATION_NAME_QUEUE_PFC_DEADLOCK)
+        return NOTIFICATION_CLASS_PFC_DEADLOCK;
+
+    return NOTIFICATION_CLASS_OTHER;
+}
+
+const char* NotificationQueue::getNotificationClassName(
+        _In_ NotificationClass notificationClass)
+{
+    SWSS_LOG_ENTER();
+
+    switch (notificationClass)
+    {
+        case NOTIFICATION_CLASS_SWITCH:
+            return "switch";
+
+        case NOTIFICATION_CLASS_PORT_STATE:
+            return "port_state";
+
+        case NOTIFICATION_CLASS_PFC_DEADLOCK:
+            return "pfc_deadlock";
+
+        case NOTIFICATION_CLASS_OTHER:
+            return "other";
+
+        case NOTIFICATION_CLASS_FDB:
+            return "fdb";
+
+        default:
+            return "unknown";
+    }
+}
+
 bool NotificationQueue::enqueue(
         _In_ const swss::KeyOpFieldsValuesTuple& item)
 {
-    MUTEX;
-
     SWSS_LOG_ENTER();
 
+    auto notificationClass = getNotificationClass(kfvKey(item));
+
+    auto& lane = m_lanes.at(notificationClass);
+
     /*
-     * If the queue exceeds the limit, then drop all further FDB events This is
-     * a temporary solution to handle high memory usage by syncd and the
-     * notification queue keeps growing. The permanent solution would be to
-     * make this stateful so that only the *latest* event is published.
+     * If the lane exceeds the limit, then drop all further events of this
+     * class. This is a temporary solution to handle high memory usage by
+     * syncd and the notification queue keeps growing. The permanent solution
+     * would be to make this stateful so that only the *latest* event is
+     * published.
      */
-    auto queueSize = m_queue.size();
 
-    if (queueSize < m_queueSizeLimit || kfvOp(item) != SAI_SWITCH_NOTIFICATION_NAME_FDB_EVENT) // TODO use enum instead of strings
+    if (lane->enqueue(item))
     {
-        m_queue.push(item);
-
         return true;
     }
 
-    m_dropCount++;
+    auto dropCount = lane->getDropCount();
 
-    if (!(m_dropCount % NOTIFICATION_QUEUE_DROP_COUNT_INDICATOR))
+    // drops are logged in aggregate, per lane drop counts are also reported
+    // periodically by notification processor
+
+    if (notificationClass != NOTIFICATION_CLASS_FDB)
+    {
+        if (dropCount == 1 || !(dropCount % NOTIFICATION_QUEUE_DROP_COUNT_INDICATOR))
+        {
+            SWSS_LOG_ERROR("notification lane %s is full (%zu), dropped %" PRIu64 " notifications, last %s",
+                    getNotificationClassName(notificationClass),
+                    lane->getSize(),
+                    dropCount,
+                    kfvKey(item).c_str());
+        }
+    }
+    else if (!(dropCount % NOTIFICATION_QUEUE_DROP_COUNT_INDICATOR))
     {
         SWSS_LOG_NOTICE(
-                "Too many messages in queue (%zu), dropped %zu FDB events!",
-                queueSize,
-                m_dropCount);
+                "Too many messages in queue (%zu), dropped %" PRIu64 " FDB events!",
+                lane->getSize(),
+                dropCount);
     }
 
     return false;
@@ -62,27 +142,140 @@ bool NotificationQueue::enqueue(
 bool NotificationQueue::tryDequeue(
         _Out_ swss::KeyOpFieldsValuesTuple& item)
 {
-    MUTEX;
-
     SWSS_LOG_ENTER();
 
-    if (m_queue.empty())
+    std::vector<swss::KeyOpFieldsValuesTuple> items;
+
+    if (tryDequeueBatch(items, 1) == 0)
     {
         return false;
     }
 
-    item = m_queue.front();
-
-    m_queue.pop();
+    item = std::move(items.front());
 
     return true;
 }
 
+size_t NotificationQueue::tryDequeueBatch(
+        _Out_ std::vector<swss::KeyOpFieldsValuesTuple>& items,
+        _In_ size_t maxCount)
+{
+    SWSS_LOG_ENTER();
+
+    items.clear();
+
+    if (m_policy == NOTIFICATION_DEQUEUE_POLICY_STRICT)
+    {
+        for (auto& lane: m_lanes)
+        {
+            lane->dequeue(items, maxCount - items.size());
+        }
+
+        return items.size();
+    }
+
+    // weighted, lanes are visited in rounds until batch is full or all lanes
+    // are empty
+
+    while (items.size() < maxCount)
+    {
+        size_t round = 0;
+
+        for (size_t idx = 0; idx < m_lanes.size() && items.size() < maxCount; idx++)
+        {
+            size_t quota = m_weights[idx] ? m_weights[idx] : maxCount;
+
+            round += m_lanes[idx]->dequeue(items, std::min(quota, maxCount - items.size()));
+        }
+
+        if (round == 0)
+        {
+            break;
+        }
+    }
+
+    return items.size();
+}
+
+void NotificationQueue::setDequeuePolicy(
+        _In_ NotificationDequeuePolicy policy,
+        _In_ const std::vector<uint32_t>& weights)
+{
+    SWSS_LOG_ENTER();
+
+    if (policy == NOTIFICATION_DEQUEUE_POLICY_WEIGHTED && weights.size() != NOTIFICATION_CLASS_MAX)
+    {
+        SWSS_LOG_THROW("weighted policy requires %d weights, got %zu", NOTIFICATION_CLASS_MAX, weights.size());
+    }
+
+    m_policy = policy;
+
+    if (policy == NOTIFICATION_DEQUEUE_POLICY_WEIGHTED)
+    {
+        m_weights = weights;
+    }
+}
+
 size_t NotificationQueue::getQueueSize()
 {
-    MUTEX;
+    SWSS_LOG_ENTER();
+
+    size_t size = 0;
+
+    for (auto& lane: m_lanes)
+    {
+        size += lane->getSize();
+    }
+
+    return size;
+}
+
+uint64_t NotificationQueue::getEnqueueCount() const
+{
+    SWSS_LOG_ENTER();
 
+    uint64_t count = 0;
+
+    for (auto& lane: m_lanes)
+    {
+        count += lane->getEnqueueCount();
+    }
+
+    return count;
+}
+
+uint64_t NotificationQueue::getDequeueCount() const
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t count = 0;
+
+    for (auto& lane: m_lanes)
+    {
+        count += lane->getDequeueCount();
+    }
+
+    return count;
+}
+
+uint64_t NotificationQueue::getDropCount() const
+{
+    SWSS_LOG_ENTER();
+
+    uint64_t count = 0;
+
+    for (auto& lane: m_lanes)
+    {
+        count += lane->getDropCount();
+    }
+
+    return count;
+}
+
+std::shared_ptr<const NotificationLane> NotificationQueue::getLane(
+        _In_ NotificationClass notificationClass) const
+{
     SWSS_LOG_ENTER();
 
-    return m_queue.size();
+    return m_lanes.at(notificationClass);
 }
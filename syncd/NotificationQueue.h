@@ -4,10 +4,12 @@ extern "C" {
 #include <sai.h>
 }
 
+#include "NotificationLane.h"
+
 #include "swss/table.h"
 
-#include <queue>
-#include <mutex>
+#include <memory>
+#include <vector>
 
 /**
  * @brief Default notification queue size limit.
@@ -15,39 +17,130 @@ extern "C" {
  * Value based on typical L2 deployment with 256k MAC entries and
  * some extra buffer for other events like port-state, q-deadlock etc
  *
- * TODO: move to config, also this limit only applies to fdb notifications
+ * This limit only applies to fdb notifications, can be changed by syncd
+ * command line option.
  */
 #define DEFAULT_NOTIFICATION_QUEUE_SIZE_LIMIT (300000)
 
+/**
+ * @brief Default size limit of non FDB notification lanes, can be changed by
+ * syncd command line option.
+ */
+#define DEFAULT_NOTIFICATION_LANE_SIZE_LIMIT (65536)
+
 namespace syncd
 {
+    /**
+     * @brief Notification classes, in order of priority.
+     */
+    typedef enum _NotificationClass
+    {
+        NOTIFICATION_CLASS_SWITCH,
+
+        NOTIFICATION_CLASS_PORT_STATE,
+
+        NOTIFICATION_CLASS_PFC_DEADLOCK,
+
+        NOTIFICATION_CLASS_OTHER,
+
+        NOTIFICATION_CLASS_FDB,
+
+        NOTIFICATION_CLASS_MAX,
+
+    } NotificationClass;
+
+    typedef enum _NotificationDequeuePolicy
+    {
+        /**
+         * @brief Lower priority lane is dequeued only when all higher
+         * priority lanes are empty.
+         */
+        NOTIFICATION_DEQUEUE_POLICY_STRICT,
+
+        /**
+         * @brief Lanes are dequeued in rounds, in priority order, and each
+         * lane gives up to its weight notifications per round.
+         */
+        NOTIFICATION_DEQUEUE_POLICY_WEIGHTED,
+
+    } NotificationDequeuePolicy;
+
+    /**
+     * @brief Notification queue.
+     *
+     * Each notification class has its own lock-free lane with own size limit
+     * and drop statistics, so port state change don't wait behind FDB events
+     * backlog. Notifications are kept in order within class.
+     */
     class NotificationQueue
     {
         public:
 
             NotificationQueue(
-                    _In_ size_t limit = DEFAULT_NOTIFICATION_QUEUE_SIZE_LIMIT);
+                    _In_ size_t limit = DEFAULT_NOTIFICATION_QUEUE_SIZE_LIMIT,
+                    _In_ size_t laneLimit = DEFAULT_NOTIFICATION_LANE_SIZE_LIMIT);
 
             virtual ~NotificationQueue();
 
         public:
 
+            /**
+             * @brief Enqueue notification, can be called from multiple threads.
+             */
             bool enqueue(
                     _In_ const swss::KeyOpFieldsValuesTuple& msg);
 
+            /**
+             * @brief Dequeue single notification, only one consumer thread is
+             * allowed.
+             */
             bool tryDequeue(
                     _Out_ swss::KeyOpFieldsValuesTuple& msg);
 
+            /**
+             * @brief Dequeue up to maxCount notifications according to dequeue
+             * policy, only one consumer thread is allowed.
+             *
+             * @return Number of dequeued items, items vector is cleared first.
+             */
+            size_t tryDequeueBatch(
+                    _Out_ std::vector<swss::KeyOpFieldsValuesTuple>& items,
+                    _In_ size_t maxCount);
+
+            /**
+             * @brief Set dequeue policy, weights are used by weighted policy
+             * and must have weight for each class, zero weight means lane is
+             * drained in each round.
+             */
+            void setDequeuePolicy(
+                    _In_ NotificationDequeuePolicy policy,
+                    _In_ const std::vector<uint32_t>& weights = {});
+
             size_t getQueueSize();
 
-        private:
+            uint64_t getEnqueueCount() const;
+
+            uint64_t getDequeueCount() const;
+
+            uint64_t getDropCount() const;
+
+            std::shared_ptr<const NotificationLane> getLane(
+                    _In_ NotificationClass notificationClass) const;
 
-            std::mutex m_mutex;
+        public:
+
+            static NotificationClass getNotificationClass(
+                    _In_ const std::string& name);
+
+            static const char* getNotificationClassName(
+                    _In_ NotificationClass notificationClass);
+
+        private:
 
-            std::queue<swss::KeyOpFieldsValuesTuple> m_queue;
+            std::vector<std::shared_ptr<NotificationLane>> m_lanes;
 
-            size_t m_queueSizeLimit;
+            NotificationDequeuePolicy m_policy;
 
-            size_t m_dropCount;
+            std::vector<uint32_t> m_weights;
     };
 }
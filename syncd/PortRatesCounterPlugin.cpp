@@ -0,0 +1,221 @@
+#include "PortRatesCounterPlugin.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+
+using namespace syncd;
+
+static const char* const g_counterNames[] = {
+    "SAI_PORT_STAT_IF_IN_OCTETS",
+    "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_OUT_OCTETS",
+    "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+    "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+};
+
+PortRatesCounterPlugin::PortRatesCounterPlugin(
+        _In_ double alpha):
+    m_alpha(alpha),
+    m_cycle(0),
+    m_tableName(PORT_RATES_TABLE)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_alpha <= 0 || m_alpha > 1)
+    {
+        SWSS_LOG_THROW("port rates alpha %f must be in range (0, 1]", m_alpha);
+    }
+}
+
+const std::string& PortRatesCounterPlugin::getTableName() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_tableName;
+}
+
+bool PortRatesCounterPlugin::updateIndexes(
+        _Inout_ PortState& state,
+        _In_ const std::vector<swss::FieldValueTuple>& counters)
+{
+    SWSS_LOG_ENTER();
+
+    bool changed = false;
+
+    for (int counter = 0; counter < COUNTER_MAX; counter++)
+    {
+        int index = -1;
+
+        for (size_t idx = 0; idx < counters.size(); idx++)
+        {
+            if (fvField(counters[idx]) == g_counterNames[counter])
+            {
+                index = (int)idx;
+                break;
+            }
+        }
+
+        changed |= (state.index[counter] != index);
+
+        state.index[counter] = index;
+    }
+
+    state.counters = &counters;
+    state.counterCount = counters.size();
+
+    return changed;
+}
+
+void PortRatesCounterPlugin::process(
+        _In_ const std::vector<Object>& objects,
+        _In_ std::chrono::steady_clock::time_point now,
+        _Inout_ std::vector<swss::KeyOpFieldsValuesTuple>& results)
+{
+    SWSS_LOG_ENTER();
+
+    m_cycle++;
+
+    for (const auto& object: objects)
+    {
+        auto it = m_ports.find(object.vid);
+
+        if (it == m_ports.end())
+        {
+            PortState state = {};
+
+            std::fill(state.index, state.index + COUNTER_MAX, -1);
+
+            it = m_ports.emplace(object.vid, state).first;
+        }
+
+        auto& state = it->second;
+
+        state.cycle = m_cycle;
+
+        // counter list changes when object is registered again
+
+        if (state.counters != object.counters || state.counterCount != object.counters->size())
+        {
+            if (updateIndexes(state, *object.counters))
+            {
+                state.lastValid = false;
+                state.ratesValid = false;
+            }
+        }
+
+        if (!object.valid)
+        {
+            // stats are stale, rates will be computed over longer interval
+            // on next successful poll
+
+            continue;
+        }
+
+        uint64_t current[COUNTER_MAX];
+
+        for (int counter = 0; counter < COUNTER_MAX; counter++)
+        {
+            current[counter] = state.index[counter] < 0 ? 0 : (*object.stats)[state.index[counter]];
+        }
+
+        // the same layout as port_rates.lua, rates and last counters are in
+        // RATES:<oid>, initialization state is in RATES:<oid>:PORT
+
+        std::string stateKey = *object.key + ":" + PORT_RATES_STATE_SUFFIX;
+
+        std::vector<swss::FieldValueTuple> values;
+
+        bool initDone = false;
+
+        if (!state.lastValid)
+        {
+            std::vector<swss::FieldValueTuple> stateValues = { { "INIT_DONE", "COUNTERS_LAST" } };
+
+            results.emplace_back(stateKey, SET_COMMAND, stateValues);
+        }
+        else
+        {
+            double elapsed = std::chrono::duration<double>(now - state.lastTime).count();
+
+            if (elapsed <= 0)
+            {
+                continue;
+            }
+
+            // counter going backwards (cleared) is treated as no traffic
+
+            auto rate = [&](int counter) {
+                return current[counter] >= state.last[counter]
+                    ? (double)(current[counter] - state.last[counter]) / elapsed
+                    : 0.0;
+            };
+
+            double rxBps = rate(RX_OCTETS);
+            double rxPps = rate(RX_UCAST_PKTS) + rate(RX_NON_UCAST_PKTS);
+            double txBps = rate(TX_OCTETS);
+            double txPps = rate(TX_UCAST_PKTS) + rate(TX_NON_UCAST_PKTS);
+
+            if (state.ratesValid)
+            {
+                state.rxBps = m_alpha * rxBps + (1 - m_alpha) * state.rxBps;
+                state.rxPps = m_alpha * rxPps + (1 - m_alpha) * state.rxPps;
+                state.txBps = m_alpha * txBps + (1 - m_alpha) * state.txBps;
+                state.txPps = m_alpha * txPps + (1 - m_alpha) * state.txPps;
+            }
+            else
+            {
+                state.rxBps = rxBps;
+                state.rxPps = rxPps;
+                state.txBps = txBps;
+                state.txPps = txPps;
+
+                state.ratesValid = true;
+
+                initDone = true;
+            }
+
+            values.emplace_back("RX_BPS", std::to_string(state.rxBps));
+            values.emplace_back("RX_PPS", std::to_string(state.rxPps));
+            values.emplace_back("TX_BPS", std::to_string(state.txBps));
+            values.emplace_back("TX_PPS", std::to_string(state.txPps));
+        }
+
+        for (int counter = 0; counter < COUNTER_MAX; counter++)
+        {
+            if (state.index[counter] >= 0)
+            {
+                values.emplace_back(std::string(g_counterNames[counter]) + "_last", std::to_string(current[counter]));
+            }
+        }
+
+        results.emplace_back(*object.key, SET_COMMAND, values);
+
+        if (initDone)
+        {
+            std::vector<swss::FieldValueTuple> stateValues = { { "INIT_DONE", "DONE" } };
+
+            results.emplace_back(stateKey, SET_COMMAND, stateValues);
+        }
+
+        std::copy(current, current + COUNTER_MAX, state.last);
+
+        state.lastTime = now;
+        state.lastValid = true;
+    }
+
+    // forget ports which are no longer registered
+
+    for (auto it = m_ports.begin(); it != m_ports.end(); )
+    {
+        if (it->second.cycle != m_cycle)
+        {
+            it = m_ports.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
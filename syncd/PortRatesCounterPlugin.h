@@ -0,0 +1,106 @@
+#pragma once
+
+#include "CounterPlugin.h"
+
+#include <unordered_map>
+
+#define PORT_RATES_COUNTER_PLUGIN_NAME "port_rates"
+
+#define PORT_RATES_TABLE "RATES"
+
+#define PORT_RATES_STATE_SUFFIX "PORT"
+
+/**
+ * @brief Default smoothing factor, the same as default PORT_ALPHA used by
+ * port rates Lua plugin.
+ */
+#define PORT_RATES_DEFAULT_ALPHA (0.18)
+
+namespace syncd
+{
+    /**
+     * @brief Native version of port_rates.lua.
+     *
+     * Computes RX/TX bytes and packets per second of each port and smooths
+     * them with exponential moving average. Previous counter values are kept
+     * in memory and rates are computed from actual time between polls, but
+     * RATES table has the same layout as written by Lua plugin, including
+     * *_last fields and INIT_DONE in RATES:<oid>:PORT.
+     */
+    class PortRatesCounterPlugin:
+        public CounterPlugin
+    {
+        public:
+
+            PortRatesCounterPlugin(
+                    _In_ double alpha = PORT_RATES_DEFAULT_ALPHA);
+
+            virtual ~PortRatesCounterPlugin() = default;
+
+        public:
+
+            virtual const std::string& getTableName() const override;
+
+            virtual void process(
+                    _In_ const std::vector<Object>& objects,
+                    _In_ std::chrono::steady_clock::time_point now,
+                    _Inout_ std::vector<swss::KeyOpFieldsValuesTuple>& results) override;
+
+        private:
+
+            enum
+            {
+                RX_OCTETS,
+                RX_UCAST_PKTS,
+                RX_NON_UCAST_PKTS,
+                TX_OCTETS,
+                TX_UCAST_PKTS,
+                TX_NON_UCAST_PKTS,
+                COUNTER_MAX,
+            };
+
+            struct PortState
+            {
+                const std::vector<swss::FieldValueTuple> *counters;
+
+                size_t counterCount;
+
+                int index[COUNTER_MAX];
+
+                uint64_t last[COUNTER_MAX];
+
+                std::chrono::steady_clock::time_point lastTime;
+
+                bool lastValid;
+
+                bool ratesValid;
+
+                double rxBps;
+                double rxPps;
+                double txBps;
+                double txPps;
+
+                uint64_t cycle;
+            };
+
+            /**
+             * @brief Find stats index of used counters, -1 if counter is not
+             * registered for port.
+             *
+             * @return True if indexes changed.
+             */
+            static bool updateIndexes(
+                    _Inout_ PortState& state,
+                    _In_ const std::vector<swss::FieldValueTuple>& counters);
+
+        private:
+
+            double m_alpha;
+
+            uint64_t m_cycle;
+
+            std::string m_tableName;
+
+            std::unordered_map<sai_object_id_t, PortState> m_ports;
+    };
+}
@@ -8,6 +8,10 @@
 #include "swss/logger.h"
 #include "swss/redisapi.h"
 
+#include <unordered_set>
+#include <algorithm>
+#include <chrono>
+
 using namespace syncd;
 
 #define VIDTORID                    "VIDTORID"
@@ -16,22 +20,45 @@ using namespace syncd;
 #define HIDDEN                      "HIDDEN"
 #define COLDVIDS                    "COLDVIDS"
 
+#define VIDRID_WRITE_MAX_ATTEMPTS   5
+#define VIDRID_WRITE_RETRY_DELAY_MS 100
+
 RedisClient::RedisClient(
         _In_ std::shared_ptr<swss::DBConnector> dbAsic):
-    m_dbAsic(dbAsic)
+    m_dbAsic(dbAsic),
+    m_scanBatchSize(REDIS_CLIENT_DEFAULT_SCAN_BATCH_SIZE),
+    m_asicStateBatching(false),
+    m_vidRidWriting(false),
+    m_vidRidRun(true)
 {
     SWSS_LOG_ENTER();
 
     std::string fdbFlushLuaScript = swss::loadLuaScript("fdb_flush.lua"); // TODO script must be updated to version 2
 
     m_fdbFlushSha = swss::loadRedisScript(dbAsic.get(), fdbFlushLuaScript);
+
+    // pipeline has own connection, it's used only by write-behind thread
+
+    m_vidRidPipeline = std::make_shared<swss::RedisPipeline>(dbAsic.get());
+
+    m_vidRidThread = std::make_shared<std::thread>(&RedisClient::vidRidWriterThreadFunction, this);
 }
 
 RedisClient::~RedisClient()
 {
     SWSS_LOG_ENTER();
 
-    // empty
+    {
+        std::lock_guard<std::mutex> lock(m_vidRidMutex);
+
+        m_vidRidRun = false;
+    }
+
+    m_vidRidCv.notify_all();
+
+    // thread writes all queued changes before exit
+
+    m_vidRidThread->join();
 }
 
 std::string RedisClient::getRedisLanesKey(
@@ -132,6 +159,8 @@ std::unordered_map<sai_object_id_t, sai_object_id_t> RedisClient::getObjectMap(
 {
     SWSS_LOG_ENTER();
 
+    flushVidAndRidMap();
+
     auto hash = m_dbAsic->hgetall(key);
 
     std::unordered_map<sai_object_id_t, sai_object_id_t> map;
@@ -336,6 +365,8 @@ std::set<sai_object_id_t> RedisClient::getColdVids(
 {
     SWSS_LOG_ENTER();
 
+    flushVidAndRidMap();
+
     auto key = getRedisColdVidsKey(switchVid);
 
     auto hash = m_dbAsic->hgetall(key);
@@ -398,7 +429,7 @@ size_t RedisClient::getAsicObjectsSize(
     // go N times on every switch and it can be slow, we need to find better
     // way to do this
 
-    auto keys = m_dbAsic->keys(ASIC_STATE_TABLE ":*");
+    auto keys = scanKeys(ASIC_STATE_TABLE ":*");
 
     size_t count = 0;
 
@@ -464,7 +495,7 @@ void RedisClient::removeAsicObject(
 
     SWSS_LOG_INFO("removing ASIC DB key: %s", key.c_str());
 
-    m_dbAsic->del(key);
+    delAsicObject(key);
 }
 
 void RedisClient::removeAsicObject(
@@ -474,7 +505,7 @@ void RedisClient::removeAsicObject(
 
     std::string key = (ASIC_STATE_TABLE ":") + sai_serialize_object_meta_key(metaKey);
 
-    m_dbAsic->del(key);
+    delAsicObject(key);
 }
 
 void RedisClient::removeTempAsicObject(
@@ -484,7 +515,7 @@ void RedisClient::removeTempAsicObject(
 
     std::string key = (TEMP_PREFIX ASIC_STATE_TABLE ":") + sai_serialize_object_meta_key(metaKey);
 
-    m_dbAsic->del(key);
+    delAsicObject(key);
 }
 
 void RedisClient::removeAsicObjects(
@@ -500,6 +531,16 @@ void RedisClient::removeAsicObjects(
          prefixKeys.push_back((ASIC_STATE_TABLE ":") + key);
     }
 
+    if (m_asicStateBatching)
+    {
+        for (const auto& key: prefixKeys)
+        {
+            delAsicObject(key);
+        }
+
+        return;
+    }
+
     m_dbAsic->del(prefixKeys);
 }
 
@@ -516,6 +557,16 @@ void RedisClient::removeTempAsicObjects(
          prefixKeys.push_back((TEMP_PREFIX ASIC_STATE_TABLE ":") + key);
     }
 
+    if (m_asicStateBatching)
+    {
+        for (const auto& key: prefixKeys)
+        {
+            delAsicObject(key);
+        }
+
+        return;
+    }
+
     m_dbAsic->del(prefixKeys);
 }
 
@@ -528,7 +579,7 @@ void RedisClient::setAsicObject(
 
     std::string key = (ASIC_STATE_TABLE ":") + sai_serialize_object_meta_key(metaKey);
 
-    m_dbAsic->hset(key, attr, value);
+    hsetAsicObject(key, { { attr, value } });
 }
 
 void RedisClient::setTempAsicObject(
@@ -540,7 +591,7 @@ void RedisClient::setTempAsicObject(
 
     std::string key = (TEMP_PREFIX ASIC_STATE_TABLE ":") + sai_serialize_object_meta_key(metaKey);
 
-    m_dbAsic->hset(key, attr, value);
+    hsetAsicObject(key, { { attr, value } });
 }
 
 void RedisClient::createAsicObject(
@@ -553,14 +604,11 @@ void RedisClient::createAsicObject(
 
     if (attrs.size() == 0)
     {
-        m_dbAsic->hset(key, "NULL", "NULL");
+        hsetAsicObject(key, { { "NULL", "NULL" } });
         return;
     }
 
-    for (const auto& e: attrs)
-    {
-        m_dbAsic->hset(key, fvField(e), fvValue(e));
-    }
+    hsetAsicObject(key, attrs);
 }
 
 void RedisClient::createTempAsicObject(
@@ -573,14 +621,11 @@ void RedisClient::createTempAsicObject(
 
     if (attrs.size() == 0)
     {
-        m_dbAsic->hset(key, "NULL", "NULL");
+        hsetAsicObject(key, { { "NULL", "NULL" } });
         return;
     }
 
-    for (const auto& e: attrs)
-    {
-        m_dbAsic->hset(key, fvField(e), fvValue(e));
-    }
+    hsetAsicObject(key, attrs);
 }
 
 void RedisClient::createAsicObjects(
@@ -601,6 +646,16 @@ void RedisClient::createAsicObjects(
         }
     }
 
+    if (m_asicStateBatching)
+    {
+        for (const auto& kvp: hash)
+        {
+            hsetAsicObject(kvp.first, kvp.second);
+        }
+
+        return;
+    }
+
     m_dbAsic->hmset(hash);
 }
 
@@ -622,6 +677,16 @@ void RedisClient::createTempAsicObjects(
         }
     }
 
+    if (m_asicStateBatching)
+    {
+        for (const auto& kvp: hash)
+        {
+            hsetAsicObject(kvp.first, kvp.second);
+        }
+
+        return;
+    }
+
     m_dbAsic->hmset(hash);
 }
 
@@ -630,6 +695,8 @@ void RedisClient::setVidAndRidMap(
 {
     SWSS_LOG_ENTER();
 
+    flushVidAndRidMap();
+
     m_dbAsic->del(VIDTORID);
     m_dbAsic->del(RIDTOVID);
 
@@ -647,14 +714,14 @@ std::vector<std::string> RedisClient::getAsicStateKeys() const
 {
     SWSS_LOG_ENTER();
 
-    return m_dbAsic->keys(ASIC_STATE_TABLE ":*");
+    return scanKeys(ASIC_STATE_TABLE ":*");
 }
 
 std::vector<std::string> RedisClient::getAsicStateSwitchesKeys() const
 {
     SWSS_LOG_ENTER();
 
-    return m_dbAsic->keys(ASIC_STATE_TABLE ":SAI_OBJECT_TYPE_SWITCH:*");
+    return scanKeys(ASIC_STATE_TABLE ":SAI_OBJECT_TYPE_SWITCH:*");
 }
 
 void RedisClient::removeColdVid(
@@ -692,11 +759,13 @@ void RedisClient::removeVidAndRid(
 {
     SWSS_LOG_ENTER();
 
-    auto strVid = sai_serialize_object_id(vid);
-    auto strRid = sai_serialize_object_id(rid);
+    {
+        std::lock_guard<std::mutex> lock(m_vidRidMutex);
 
-    m_dbAsic->hdel(VIDTORID, strVid);
-    m_dbAsic->hdel(RIDTOVID, strRid);
+        m_vidRidQueue.push_back({ false, vid, rid });
+    }
+
+    m_vidRidCv.notify_one();
 }
 
 void RedisClient::insertVidAndRid(
@@ -705,11 +774,13 @@ void RedisClient::insertVidAndRid(
 {
     SWSS_LOG_ENTER();
 
-    auto strVid = sai_serialize_object_id(vid);
-    auto strRid = sai_serialize_object_id(rid);
+    {
+        std::lock_guard<std::mutex> lock(m_vidRidMutex);
+
+        m_vidRidQueue.push_back({ true, vid, rid });
+    }
 
-    m_dbAsic->hset(VIDTORID, strVid, strRid);
-    m_dbAsic->hset(RIDTOVID, strRid, strVid);
+    m_vidRidCv.notify_one();
 }
 
 sai_object_id_t RedisClient::getVidForRid(
@@ -717,6 +788,8 @@ sai_object_id_t RedisClient::getVidForRid(
 {
     SWSS_LOG_ENTER();
 
+    flushVidAndRidMap();
+
     auto strRid = sai_serialize_object_id(rid);
 
     auto pvid = m_dbAsic->hget(RIDTOVID, strRid);
@@ -741,6 +814,8 @@ sai_object_id_t RedisClient::getRidForVid(
 {
     SWSS_LOG_ENTER();
 
+    flushVidAndRidMap();
+
     auto strVid = sai_serialize_object_id(vid);
 
     auto prid = m_dbAsic->hget(VIDTORID, strVid);
@@ -764,7 +839,7 @@ void RedisClient::removeAsicStateTable()
 {
     SWSS_LOG_ENTER();
 
-    const auto &asicStateKeys = m_dbAsic->keys(ASIC_STATE_TABLE ":*");
+    const auto &asicStateKeys = scanKeys(ASIC_STATE_TABLE ":*");
 
     for (const auto &key: asicStateKeys)
     {
@@ -776,7 +851,7 @@ void RedisClient::removeTempAsicStateTable()
 {
     SWSS_LOG_ENTER();
 
-    const auto &tempAsicStateKeys = m_dbAsic->keys(TEMP_PREFIX ASIC_STATE_TABLE ":*");
+    const auto &tempAsicStateKeys = scanKeys(TEMP_PREFIX ASIC_STATE_TABLE ":*");
 
     for (const auto &key: tempAsicStateKeys)
     {
@@ -805,23 +880,26 @@ std::map<sai_object_id_t, swss::TableDump> RedisClient::getAsicView(
 
     SWSS_LOG_TIMER("get asic view from %s", tableName.c_str());
 
-    swss::Table table(m_dbAsic.get(), tableName);
+    std::map<sai_object_id_t, swss::TableDump> map;
 
-    swss::TableDump dump;
+    size_t prefixLength = tableName.length() + 1;
 
-    table.dump(dump);
+    scanAsicState(tableName, [&](const std::string& key, const std::vector<swss::FieldValueTuple>& values) {
 
-    std::map<sai_object_id_t, swss::TableDump> map;
+        auto strMetaKey = key.substr(prefixLength);
 
-    for (auto& key: dump)
-    {
         sai_object_meta_key_t mk;
-        sai_deserialize_object_meta_key(key.first, mk);
+        sai_deserialize_object_meta_key(strMetaKey, mk);
 
         auto switchVID = VidManager::switchIdQuery(mk.objectkey.key.object_id);
 
-        map[switchVID][key.first] = key.second;
-    }
+        auto& hash = map[switchVID][strMetaKey];
+
+        for (auto& fv: values)
+        {
+            hash[fvField(fv)] = fvValue(fv);
+        }
+    });
 
     SWSS_LOG_NOTICE("%s switch count: %zu:", tableName.c_str(), map.size());
 
@@ -902,3 +980,351 @@ void RedisClient::processFlushEvent(
         swss::RedisReply r(m_dbAsic.get(), command);
     }
 }
+
+void RedisClient::setAsicStateBatching(
+        _In_ bool enable)
+{
+    SWSS_LOG_ENTER();
+
+    if (enable && !m_pipeline)
+    {
+        m_pipeline = std::make_shared<swss::RedisPipeline>(m_dbAsic.get());
+    }
+
+    if (!enable)
+    {
+        flushAsicStateUpdates();
+    }
+
+    m_asicStateBatching = enable;
+}
+
+void RedisClient::flushAsicStateUpdates()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pipeline)
+    {
+        m_pipeline->flush();
+    }
+}
+
+void RedisClient::hsetAsicObject(
+        _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& attrs) const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_asicStateBatching)
+    {
+        swss::RedisCommand hset;
+
+        hset.formatHSET(key, attrs.begin(), attrs.end());
+
+        m_pipeline->push(hset, REDIS_REPLY_INTEGER);
+
+        return;
+    }
+
+    for (const auto& e: attrs)
+    {
+        m_dbAsic->hset(key, fvField(e), fvValue(e));
+    }
+}
+
+void RedisClient::delAsicObject(
+        _In_ const std::string& key) const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_asicStateBatching)
+    {
+        swss::RedisCommand del;
+
+        del.formatDEL(key);
+
+        m_pipeline->push(del, REDIS_REPLY_INTEGER);
+
+        return;
+    }
+
+    m_dbAsic->del(key);
+}
+
+void RedisClient::flushVidAndRidMap() const
+{
+    SWSS_LOG_ENTER();
+
+    std::unique_lock<std::mutex> lock(m_vidRidMutex);
+
+    m_vidRidFlushedCv.wait(lock, [this] { return m_vidRidQueue.empty() && !m_vidRidWriting; });
+}
+
+void RedisClient::writeVidRidChanges(
+        _In_ const std::vector<VidRidChange>& changes)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& change: changes)
+    {
+        auto strVid = sai_serialize_object_id(change.vid);
+        auto strRid = sai_serialize_object_id(change.rid);
+
+        swss::RedisCommand vid2rid;
+        swss::RedisCommand rid2vid;
+
+        if (change.insert)
+        {
+            vid2rid.formatHSET(VIDTORID, strVid, strRid);
+            rid2vid.formatHSET(RIDTOVID, strRid, strVid);
+        }
+        else
+        {
+            vid2rid.formatHDEL(VIDTORID, strVid);
+            rid2vid.formatHDEL(RIDTOVID, strRid);
+        }
+
+        m_vidRidPipeline->push(vid2rid, REDIS_REPLY_INTEGER);
+        m_vidRidPipeline->push(rid2vid, REDIS_REPLY_INTEGER);
+    }
+
+    m_vidRidPipeline->flush();
+}
+
+void RedisClient::vidRidWriterThreadFunction()
+{
+    SWSS_LOG_ENTER();
+
+    while (true)
+    {
+        std::vector<VidRidChange> changes;
+
+        {
+            std::unique_lock<std::mutex> lock(m_vidRidMutex);
+
+            m_vidRidCv.wait(lock, [this] { return !m_vidRidRun || !m_vidRidQueue.empty(); });
+
+            if (m_vidRidQueue.empty())
+            {
+                break; // stopped and all changes were written
+            }
+
+            changes.swap(m_vidRidQueue);
+
+            m_vidRidWriting = true;
+        }
+
+        // HSET and HDEL are idempotent, so failed batch can be written again
+
+        for (int attempt = 1; ; attempt++)
+        {
+            try
+            {
+                writeVidRidChanges(changes);
+                break;
+            }
+            catch (const std::exception& e)
+            {
+                SWSS_LOG_ERROR("failed to write %zu VID and RID map changes (attempt %d): %s",
+                        changes.size(),
+                        attempt,
+                        e.what());
+            }
+
+            if (attempt >= VIDRID_WRITE_MAX_ATTEMPTS)
+            {
+                SWSS_LOG_ERROR("FATAL: VID and RID maps in redis are out of sync with syncd");
+
+                abort();
+            }
+
+            // replies of failed flush could be left on connection, so pipeline
+            // is recreated on new connection to keep replies in step with commands
+
+            m_vidRidPipeline = std::make_shared<swss::RedisPipeline>(m_dbAsic.get());
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(VIDRID_WRITE_RETRY_DELAY_MS));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_vidRidMutex);
+
+            m_vidRidWriting = false;
+        }
+
+        m_vidRidFlushedCv.notify_all();
+    }
+}
+
+void RedisClient::setScanBatchSize(
+        _In_ size_t batchSize)
+{
+    SWSS_LOG_ENTER();
+
+    if (batchSize == 0)
+    {
+        SWSS_LOG_THROW("scan batch size must be greater than zero");
+    }
+
+    m_scanBatchSize = batchSize;
+}
+
+void RedisClient::scanKeys(
+        _In_ const std::string& pattern,
+        _In_ const std::function<void(const std::vector<std::string>&)>& callback) const
+{
+    SWSS_LOG_ENTER();
+
+    // SCAN can return the same key more than once when table is rehashed
+
+    std::unordered_set<std::string> scanned;
+
+    std::string cursor = "0";
+
+    do
+    {
+        swss::RedisCommand scan;
+
+        scan.format("SCAN %s MATCH %s COUNT %s", cursor.c_str(), pattern.c_str(), std::to_string(m_scanBatchSize).c_str());
+
+        swss::RedisReply r(m_dbAsic.get(), scan, REDIS_REPLY_ARRAY);
+
+        auto reply = r.getContext();
+
+        if (reply->elements != 2)
+        {
+            SWSS_LOG_THROW("unexpected SCAN reply elements count: %zu", reply->elements);
+        }
+
+        cursor = std::string(reply->element[0]->str, reply->element[0]->len);
+
+        auto elements = reply->element[1];
+
+        std::vector<std::string> keys;
+
+        for (size_t idx = 0; idx < elements->elements; idx++)
+        {
+            std::string key(elements->element[idx]->str, elements->element[idx]->len);
+
+            if (scanned.insert(key).second)
+            {
+                keys.push_back(key);
+            }
+        }
+
+        if (keys.size())
+        {
+            callback(keys);
+        }
+    }
+    while (cursor != "0");
+}
+
+std::vector<std::string> RedisClient::scanKeys(
+        _In_ const std::string& pattern) const
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> keys;
+
+    scanKeys(pattern, [&](const std::vector<std::string>& batch) {
+            keys.insert(keys.end(), batch.begin(), batch.end());
+    });
+
+    return keys;
+}
+
+void RedisClient::scanAsicState(
+        _In_ const std::string& tableName,
+        _In_ const AsicObjectCallback& callback) const
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_TIMER("scan asic state %s", tableName.c_str());
+
+    auto context = m_dbAsic->getContext();
+
+    size_t count = 0;
+
+    scanKeys(tableName + ":*", [&](const std::vector<std::string>& keys) {
+
+        for (size_t idx = 0; idx < keys.size(); idx += m_scanBatchSize)
+        {
+            size_t end = std::min(keys.size(), idx + m_scanBatchSize);
+
+            for (size_t i = idx; i < end; i++)
+            {
+                swss::RedisCommand hgetall;
+
+                hgetall.format("HGETALL %s", keys[i].c_str());
+
+                if (redisAppendFormattedCommand(context, hgetall.c_str(), hgetall.length()) != REDIS_OK)
+                {
+                    std::string error = context->errstr;
+
+                    // connection is shared, read replies of already appended
+                    // commands, so next command don't get one of them
+
+                    for (size_t j = idx; j < i; j++)
+                    {
+                        redisReply *reply = nullptr;
+
+                        if (redisGetReply(context, (void**)&reply) != REDIS_OK)
+                        {
+                            break;
+                        }
+
+                        freeReplyObject(reply);
+                    }
+
+                    SWSS_LOG_THROW("failed to append HGETALL %s: %s", keys[i].c_str(), error.c_str());
+                }
+            }
+
+            // read all replies first, so connection is in sync even if callback throws
+
+            std::vector<std::shared_ptr<swss::RedisReply>> replies;
+
+            for (size_t i = idx; i < end; i++)
+            {
+                redisReply *reply = nullptr;
+
+                if (redisGetReply(context, (void**)&reply) != REDIS_OK)
+                {
+                    SWSS_LOG_THROW("failed to get HGETALL %s reply: %s", keys[i].c_str(), context->errstr);
+                }
+
+                replies.push_back(std::make_shared<swss::RedisReply>(reply));
+            }
+
+            for (size_t i = idx; i < end; i++)
+            {
+                auto& r = replies[i - idx];
+
+                r->checkReplyType(REDIS_REPLY_ARRAY);
+
+                auto reply = r->getContext();
+
+                if (reply->elements == 0)
+                {
+                    continue; // object was removed after SCAN
+                }
+
+                std::vector<swss::FieldValueTuple> values;
+
+                for (size_t e = 0; e + 1 < reply->elements; e += 2)
+                {
+                    values.emplace_back(
+                            std::string(reply->element[e]->str, reply->element[e]->len),
+                            std::string(reply->element[e + 1]->str, reply->element[e + 1]->len));
+                }
+
+                callback(keys[i], values);
+
+                count++;
+            }
+        }
+    });
+
+    SWSS_LOG_NOTICE("loaded %zu objects from %s", count, tableName.c_str());
+}
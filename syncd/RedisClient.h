@@ -5,17 +5,32 @@ extern "C" {
 }
 
 #include "swss/table.h"
+#include "swss/redispipeline.h"
 
 #include <string>
 #include <unordered_map>
 #include <set>
 #include <memory>
 #include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * @brief Default number of keys requested by single SCAN call and read by
+ * pipelined HGETALL when ASIC state is loaded.
+ */
+#define REDIS_CLIENT_DEFAULT_SCAN_BATCH_SIZE (1000)
 
 namespace syncd
 {
     class RedisClient
     {
+        public:
+
+            typedef std::function<void(const std::string&, const std::vector<swss::FieldValueTuple>&)> AsicObjectCallback;
+
         public:
 
             RedisClient(
@@ -120,14 +135,31 @@ namespace syncd
 
             bool hasNoHiddenKeysDefined() const;
 
+            /**
+             * @brief Queue removal of VID and RID from VIDTORID and RIDTOVID
+             * maps, it's written to redis by write-behind thread.
+             */
             void removeVidAndRid(
                     _In_ sai_object_id_t vid,
                     _In_ sai_object_id_t rid);
 
+            /**
+             * @brief Queue insert of VID and RID to VIDTORID and RIDTOVID
+             * maps, it's written to redis by write-behind thread.
+             */
             void insertVidAndRid(
                     _In_ sai_object_id_t vid,
                     _In_ sai_object_id_t rid);
 
+            /**
+             * @brief Wait until all queued VID and RID map changes are
+             * written to redis.
+             *
+             * All methods reading or replacing VIDTORID and RIDTOVID maps
+             * call this first.
+             */
+            void flushVidAndRidMap() const;
+
             sai_object_id_t getVidForRid(
                     _In_ sai_object_id_t rid);
 
@@ -158,8 +190,56 @@ namespace syncd
                     _In_ sai_object_id_t bvId,
                     _In_ sai_fdb_flush_entry_type_t type);
 
+        public:
+
+            /**
+             * @brief Enable or disable batching of ASIC state updates.
+             *
+             * When enabled, ASIC state objects create, set and remove are
+             * queued in redis pipeline and written by flushAsicStateUpdates.
+             * Caller must flush before reading ASIC state. Disabling flushes
+             * queued updates.
+             */
+            void setAsicStateBatching(
+                    _In_ bool enable);
+
+            void flushAsicStateUpdates();
+
+        public:
+
+            void setScanBatchSize(
+                    _In_ size_t batchSize);
+
+            /**
+             * @brief Load ASIC state objects from given table.
+             *
+             * Keys are iterated by SCAN cursor instead of KEYS, so redis is
+             * not blocked, and attributes of each batch of keys are read by
+             * pipelined HGETALL. Callback is called with full object key
+             * and attributes. Objects removed while scanning are skipped.
+             */
+            void scanAsicState(
+                    _In_ const std::string& tableName,
+                    _In_ const AsicObjectCallback& callback) const;
+
         private:
 
+            void scanKeys(
+                    _In_ const std::string& pattern,
+                    _In_ const std::function<void(const std::vector<std::string>&)>& callback) const;
+
+            std::vector<std::string> scanKeys(
+                    _In_ const std::string& pattern) const;
+
+            void hsetAsicObject(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& attrs) const;
+
+            void delAsicObject(
+                    _In_ const std::string& key) const;
+
+            void vidRidWriterThreadFunction();
+
             std::map<sai_object_id_t, swss::TableDump> getAsicView(
                     _In_ const std::string &tableName);
 
@@ -181,5 +261,39 @@ namespace syncd
 
             std::string m_fdbFlushSha;
 
+            size_t m_scanBatchSize;
+
+            bool m_asicStateBatching;
+
+            std::shared_ptr<swss::RedisPipeline> m_pipeline;
+
+            struct VidRidChange
+            {
+                bool insert;
+
+                sai_object_id_t vid;
+
+                sai_object_id_t rid;
+            };
+
+            void writeVidRidChanges(
+                    _In_ const std::vector<VidRidChange>& changes);
+
+            mutable std::mutex m_vidRidMutex;
+
+            mutable std::condition_variable m_vidRidCv;
+
+            mutable std::condition_variable m_vidRidFlushedCv;
+
+            std::vector<VidRidChange> m_vidRidQueue;
+
+            bool m_vidRidWriting;
+
+            bool m_vidRidRun;
+
+            std::shared_ptr<swss::RedisPipeline> m_vidRidPipeline;
+
+            std::shared_ptr<std::thread> m_vidRidThread;
+
     };
 }
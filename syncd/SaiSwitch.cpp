@@ -1129,9 +1129,9 @@ void SaiSwitch::postPortRemove(
 
         // remove from RID2VID and VID2RID map in redis
 
-        auto vid = m_client->getVidForRid(rid);
+        sai_object_id_t vid;
 
-        if (vid == SAI_NULL_OBJECT_ID)
+        if (!m_translator->tryTranslateRidToVid(rid, vid))
         {
             SWSS_LOG_THROW("expected rid %s to be present in RIDTOVID",
                     sai_serialize_object_id(rid).c_str());
@@ -0,0 +1,122 @@
+#include "ShardedOidMap.h"
+
+#include "swss/logger.h"
+
+using namespace syncd;
+
+size_t ShardedOidMap::getShardIndex(
+        _In_ sai_object_id_t key)
+{
+    SWSS_LOG_ENTER();
+
+    // object type and index are in different bits of oid, mix them all
+
+    return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) % SHARDED_OID_MAP_SHARDS;
+}
+
+bool ShardedOidMap::get(
+        _In_ sai_object_id_t key,
+        _Out_ sai_object_id_t& value) const
+{
+    SWSS_LOG_ENTER();
+
+    auto& shard = m_shards[getShardIndex(key)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(key);
+
+    if (it == shard.map.end())
+    {
+        return false;
+    }
+
+    value = it->second;
+
+    return true;
+}
+
+bool ShardedOidMap::contains(
+        _In_ sai_object_id_t key) const
+{
+    SWSS_LOG_ENTER();
+
+    auto& shard = m_shards[getShardIndex(key)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.map.find(key) != shard.map.end();
+}
+
+void ShardedOidMap::set(
+        _In_ sai_object_id_t key,
+        _In_ sai_object_id_t value)
+{
+    SWSS_LOG_ENTER();
+
+    auto& shard = m_shards[getShardIndex(key)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    shard.map[key] = value;
+}
+
+void ShardedOidMap::erase(
+        _In_ sai_object_id_t key)
+{
+    SWSS_LOG_ENTER();
+
+    auto& shard = m_shards[getShardIndex(key)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    shard.map.erase(key);
+}
+
+void ShardedOidMap::assign(
+        _In_ const std::unordered_map<sai_object_id_t, sai_object_id_t>& map)
+{
+    SWSS_LOG_ENTER();
+
+    std::unordered_map<sai_object_id_t, sai_object_id_t> maps[SHARDED_OID_MAP_SHARDS];
+
+    for (auto& kvp: map)
+    {
+        maps[getShardIndex(kvp.first)].insert(kvp);
+    }
+
+    for (size_t idx = 0; idx < SHARDED_OID_MAP_SHARDS; idx++)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[idx].mutex);
+
+        m_shards[idx].map.swap(maps[idx]);
+    }
+}
+
+void ShardedOidMap::clear()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto& shard: m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        shard.map.clear();
+    }
+}
+
+size_t ShardedOidMap::size() const
+{
+    SWSS_LOG_ENTER();
+
+    size_t size = 0;
+
+    for (auto& shard: m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        size += shard.map.size();
+    }
+
+    return size;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+extern "C" {
+#include "saimetadata.h"
+}
+
+#include <mutex>
+#include <unordered_map>
+
+#define SHARDED_OID_MAP_SHARDS (16)
+
+namespace syncd
+{
+    /**
+     * @brief Object id to object id map split into shards with separate
+     * locks.
+     *
+     * Lookups from different threads only contend when they hit the same
+     * shard, and each lock is held only for single hash operation.
+     */
+    class ShardedOidMap
+    {
+        private:
+
+            ShardedOidMap(const ShardedOidMap&) = delete;
+            ShardedOidMap& operator=(const ShardedOidMap&) = delete;
+
+        public:
+
+            ShardedOidMap() = default;
+
+            virtual ~ShardedOidMap() = default;
+
+        public:
+
+            /**
+             * @brief Get value for key.
+             *
+             * @return True if key exists.
+             */
+            bool get(
+                    _In_ sai_object_id_t key,
+                    _Out_ sai_object_id_t& value) const;
+
+            bool contains(
+                    _In_ sai_object_id_t key) const;
+
+            void set(
+                    _In_ sai_object_id_t key,
+                    _In_ sai_object_id_t value);
+
+            void erase(
+                    _In_ sai_object_id_t key);
+
+            /**
+             * @brief Replace content with given map.
+             */
+            void assign(
+                    _In_ const std::unordered_map<sai_object_id_t, sai_object_id_t>& map);
+
+            void clear();
+
+            size_t size() const;
+
+        private:
+
+            static size_t getShardIndex(
+                    _In_ sai_object_id_t key);
+
+        private:
+
+            struct Shard
+            {
+                mutable std::mutex mutex;
+
+                std::unordered_map<sai_object_id_t, sai_object_id_t> map;
+            };
+
+            Shard m_shards[SHARDED_OID_MAP_SHARDS];
+    };
+}
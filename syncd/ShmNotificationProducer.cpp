@@ -0,0 +1,66 @@
+#include "ShmNotificationProducer.h"
+
+#include "ZeroMQMessageCodec.h"
+
+#include "swss/logger.h"
+
+#include <chrono>
+
+#include <unistd.h>
+
+#define SHM_NOTIFICATION_PUSH_TIMEOUT (1000)
+#define SHM_NOTIFICATION_RETRY_SLEEP_US (100)
+
+using namespace syncd;
+using namespace sairedis;
+
+ShmNotificationProducer::ShmNotificationProducer(
+        _In_ std::shared_ptr<ShmTransport> transport):
+    m_transport(transport)
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+void ShmNotificationProducer::send(
+        _In_ const std::string& op,
+        _In_ const std::string& data,
+        _In_ const std::vector<swss::FieldValueTuple>& values)
+{
+    SWSS_LOG_ENTER();
+
+    std::string buffer;
+
+    ZeroMQMessageCodec::encode(ZeroMQMessageCodec::CODEC_BINARY, op, data, values, buffer);
+
+    SWSS_LOG_DEBUG("sending: %s, %zu bytes", op.c_str(), buffer.size());
+
+    auto& ring = m_transport->getRing(ShmTransport::RING_NOTIFICATION);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(SHM_NOTIFICATION_PUSH_TIMEOUT);
+
+    // mutex is held only for single push attempt, so sender waiting for
+    // space in full ring does not block other threads
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (ring.push(buffer.data(), buffer.size(), 0))
+            {
+                return;
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+
+        usleep(SHM_NOTIFICATION_RETRY_SLEEP_US);
+    }
+
+    SWSS_LOG_ERROR("notification ring is full, client is not reading notifications, notification DROPPED: %s", op.c_str());
+}
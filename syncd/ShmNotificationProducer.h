@@ -0,0 +1,38 @@
+#pragma once
+
+#include "NotificationProducerBase.h"
+#include "ShmTransport.h"
+
+#include <mutex>
+#include <memory>
+
+namespace syncd
+{
+    class ShmNotificationProducer:
+        public NotificationProducerBase
+    {
+        public:
+
+            ShmNotificationProducer(
+                    _In_ std::shared_ptr<sairedis::ShmTransport> transport);
+
+            virtual ~ShmNotificationProducer() = default;
+
+        public:
+
+            virtual void send(
+                    _In_ const std::string& op,
+                    _In_ const std::string& data,
+                    _In_ const std::vector<swss::FieldValueTuple>& values) override;
+
+        private:
+
+            std::shared_ptr<sairedis::ShmTransport> m_transport;
+
+            /**
+             * @brief Notifications are sent from multiple threads, but ring
+             * supports single producer.
+             */
+            std::mutex m_mutex;
+    };
+}
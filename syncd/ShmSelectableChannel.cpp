@@ -0,0 +1,146 @@
+#include "ShmSelectableChannel.h"
+
+#include "ZeroMQMessageCodec.h"
+
+#include "swss/logger.h"
+
+#define SHM_RESPONSE_PUSH_TIMEOUT (1000)
+
+using namespace syncd;
+using namespace sairedis;
+
+ShmSelectableChannel::ShmSelectableChannel(
+        _In_ std::shared_ptr<ShmTransport> transport):
+    m_transport(transport),
+    m_requestRing(transport->getRing(ShmTransport::RING_REQUEST)),
+    m_responseRing(transport->getRing(ShmTransport::RING_RESPONSE))
+{
+    SWSS_LOG_ENTER();
+
+    receive();
+}
+
+void ShmSelectableChannel::receive()
+{
+    SWSS_LOG_ENTER();
+
+    do
+    {
+        size_t size;
+
+        const uint8_t* data;
+
+        // decode directly from shared memory
+
+        while ((data = m_requestRing.front(size)) != nullptr)
+        {
+            swss::KeyOpFieldsValuesTuple kco;
+
+            ZeroMQMessageCodec::decode(data, size, kco);
+
+            m_requestRing.pop();
+
+            m_queue.push(std::move(kco));
+        }
+    }
+    while (m_queue.empty() && !m_requestRing.arm());
+}
+
+// SelectableChannel overrides
+
+bool ShmSelectableChannel::empty()
+{
+    SWSS_LOG_ENTER();
+
+    return m_queue.size() == 0;
+}
+
+void ShmSelectableChannel::pop(
+        _Out_ swss::KeyOpFieldsValuesTuple& kco,
+        _In_ bool initViewMode)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_queue.empty())
+    {
+        SWSS_LOG_THROW("queue is empty, can't pop");
+    }
+
+    kco = std::move(m_queue.front());
+
+    m_queue.pop();
+
+    if (m_queue.empty())
+    {
+        // client could already produce next requests, pick them up without
+        // going through select, otherwise arm doorbell
+
+        receive();
+    }
+}
+
+void ShmSelectableChannel::set(
+        _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& values,
+        _In_ const std::string& op)
+{
+    SWSS_LOG_ENTER();
+
+    ZeroMQMessageCodec::encode(ZeroMQMessageCodec::CODEC_BINARY, key, op, values, m_sendBuffer);
+
+    SWSS_LOG_DEBUG("sending: %s %s, %zu bytes", op.c_str(), key.c_str(), m_sendBuffer.size());
+
+    // client matches responses with requests by order, so dropping single
+    // response would shift all following ones, wait while client is alive
+
+    while (!m_responseRing.push(m_sendBuffer.data(), m_sendBuffer.size(), SHM_RESPONSE_PUSH_TIMEOUT))
+    {
+        if (!m_transport->isClientConnected())
+        {
+            SWSS_LOG_THROW("response ring is full and shm client disconnected, can't send response: %s %s",
+                    op.c_str(),
+                    key.c_str());
+        }
+
+        SWSS_LOG_WARN("response ring is full, waiting for client to read responses: %s %s",
+                op.c_str(),
+                key.c_str());
+    }
+}
+
+// Selectable overrides
+
+int ShmSelectableChannel::getFd()
+{
+    SWSS_LOG_ENTER();
+
+    return m_requestRing.getEventFd();
+}
+
+uint64_t ShmSelectableChannel::readData()
+{
+    SWSS_LOG_ENTER();
+
+    // clear doorbell so it could be triggered in next select()
+    m_requestRing.clearDoorbell();
+
+    m_requestRing.disarm();
+
+    receive();
+
+    return 0;
+}
+
+bool ShmSelectableChannel::hasData()
+{
+    SWSS_LOG_ENTER();
+
+    return m_queue.size() > 0;
+}
+
+bool ShmSelectableChannel::hasCachedData()
+{
+    SWSS_LOG_ENTER();
+
+    return m_queue.size() > 1;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "SelectableChannel.h"
+#include "ShmTransport.h"
+
+#include <queue>
+#include <memory>
+
+namespace syncd
+{
+    class ShmSelectableChannel:
+        public SelectableChannel
+    {
+        public:
+
+            ShmSelectableChannel(
+                    _In_ std::shared_ptr<sairedis::ShmTransport> transport);
+
+            virtual ~ShmSelectableChannel() = default;
+
+        public: // SelectableChannel overrides
+
+            virtual bool empty() override;
+
+            virtual void pop(
+                    _Out_ swss::KeyOpFieldsValuesTuple& kco,
+                    _In_ bool initViewMode) override;
+
+            virtual void set(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& values,
+                    _In_ const std::string& op) override;
+
+        public: // Selectable overrides
+
+            virtual int getFd() override;
+
+            virtual uint64_t readData() override;
+
+            virtual bool hasData() override;
+
+            virtual bool hasCachedData() override;
+
+        private:
+
+            /**
+             * @brief Move all requests from ring to local queue.
+             *
+             * If ring is empty and local queue is empty, doorbell is armed,
+             * so next request will wake up select.
+             */
+            void receive();
+
+        private:
+
+            std::shared_ptr<sairedis::ShmTransport> m_transport;
+
+            sairedis::ShmRing& m_requestRing;
+
+            sairedis::ShmRing& m_responseRing;
+
+            std::queue<swss::KeyOpFieldsValuesTuple> m_queue;
+
+            std::string m_sendBuffer;
+    };
+}
@@ -22,11 +22,11 @@ SingleReiniter::SingleReiniter(
         _In_ std::shared_ptr<NotificationHandler> handler,
         _In_ const ObjectIdMap& vidToRidMap,
         _In_ const ObjectIdMap& ridToVidMap,
-        _In_ const std::vector<std::string>& asicKeys):
+        _In_ AsicState asicState):
     m_vendorSai(sai),
     m_vidToRidMap(vidToRidMap),
     m_ridToVidMap(ridToVidMap),
-    m_asicKeys(asicKeys),
+    m_asicState(std::move(asicState)),
     m_translator(translator),
     m_client(client),
     m_handler(handler)
@@ -100,8 +100,10 @@ void SingleReiniter::prepareAsicState()
 
     SWSS_LOG_TIMER("read asic state");
 
-    for (auto& key: m_asicKeys)
+    for (auto& kvp: m_asicState)
     {
+        const std::string& key = kvp.first;
+
         sai_object_type_t objectType = getObjectTypeFromAsicKey(key);
 
         const std::string &strObjectId = getObjectIdFromAsicKey(key);
@@ -142,8 +144,12 @@ void SingleReiniter::prepareAsicState()
                 break;
         }
 
-        m_attributesLists[key] = redisGetAttributesFromAsicKey(key);
+        m_attributesLists[key] = std::make_shared<SaiAttributeList>(objectType, kvp.second, false);
     }
+
+    // attributes are deserialized, strings are no longer needed
+
+    m_asicState.clear();
 }
 
 sai_object_type_t SingleReiniter::getObjectTypeFromAsicKey(
@@ -1132,30 +1138,6 @@ void SingleReiniter::postRemoveActions()
     }
 }
 
-std::shared_ptr<SaiAttributeList> SingleReiniter::redisGetAttributesFromAsicKey(
-        _In_ const std::string &key)
-{
-    SWSS_LOG_ENTER();
-
-    sai_object_type_t objectType = getObjectTypeFromAsicKey(key);
-
-    std::vector<swss::FieldValueTuple> values;
-
-    auto hash = m_client->getAttributesFromAsicKey(key);
-
-    for (auto &kv: hash)
-    {
-        const std::string &skey = kv.first;
-        const std::string &svalue = kv.second;
-
-        swss::FieldValueTuple fvt(skey, svalue);
-
-        values.push_back(fvt);
-    }
-
-    return std::make_shared<SaiAttributeList>(objectType, values, false);
-}
-
 std::shared_ptr<SaiSwitch> SingleReiniter::getSwitch() const
 {
     SWSS_LOG_ENTER();
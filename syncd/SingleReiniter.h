@@ -24,6 +24,12 @@ namespace syncd
             typedef std::unordered_map<std::string, std::string> StringHash;
             typedef std::unordered_map<sai_object_id_t, sai_object_id_t> ObjectIdMap;
 
+            /**
+             * @brief ASIC state objects, key to attributes, loaded at once
+             * by RedisClient::scanAsicState.
+             */
+            typedef std::unordered_map<std::string, std::vector<swss::FieldValueTuple>> AsicState;
+
         public:
 
             SingleReiniter(
@@ -33,7 +39,7 @@ namespace syncd
                     _In_ std::shared_ptr<NotificationHandler> handler,
                     _In_ const ObjectIdMap& vidToRidMap,
                     _In_ const ObjectIdMap& ridToVidMap,
-                    _In_ const std::vector<std::string>& asicKeys);
+                    _In_ AsicState asicState);
 
             virtual ~SingleReiniter();
 
@@ -71,9 +77,6 @@ namespace syncd
             sai_object_id_t processSingleVid(
                     _In_ sai_object_id_t vid);
 
-            std::shared_ptr<saimeta::SaiAttributeList> redisGetAttributesFromAsicKey(
-                    _In_ const std::string &key);
-
             void processAttributesForOids(
                     _In_ sai_object_type_t objectType,
                     _In_ uint32_t attr_count,
@@ -120,7 +123,7 @@ namespace syncd
             StringHash m_nats;
             StringHash m_insegs;
 
-            std::vector<std::string> m_asicKeys;
+            AsicState m_asicState;
 
             std::unordered_map<std::string, std::shared_ptr<saimeta::SaiAttributeList>> m_attributesLists;
 
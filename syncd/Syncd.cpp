@@ -11,8 +11,10 @@
 #include "BreakConfigParser.h"
 #include "RedisNotificationProducer.h"
 #include "ZeroMQNotificationProducer.h"
+#include "ShmNotificationProducer.h"
 #include "RedisSelectableChannel.h"
 #include "ZeroMQSelectableChannel.h"
+#include "ShmSelectableChannel.h"
 #include "PerformanceIntervalTimer.h"
 #include "TimerWatchdog.h"
 
@@ -35,6 +37,8 @@
 
 #define DEF_SAI_WARM_BOOT_DATA_FILE "/var/warmboot/sai-warmboot.bin"
 
+#define MAX_COALESCED_EVENTS (512)
+
 using namespace syncd;
 using namespace saimeta;
 using namespace sairediscommon;
@@ -50,7 +54,9 @@ Syncd::Syncd(
     m_asicInitViewMode(false), // by default we are in APPLY view mode
     m_vendorSai(vendorSai),
     m_veryFirstRun(false),
-    m_enableSyncMode(false)
+    m_enableSyncMode(false),
+    m_eventWindowSize(0),
+    m_eventBatch(false)
 {
     SWSS_LOG_ENTER();
 
@@ -76,6 +82,15 @@ Syncd::Syncd(
         m_commandLineOptions->m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_ZMQ_SYNC;
     }
 
+    if (m_contextConfig->m_shmEnable && m_commandLineOptions->m_enableSyncMode)
+    {
+        SWSS_LOG_NOTICE("disabling command line sync mode, since context shm enabled");
+
+        m_commandLineOptions->m_enableSyncMode = false;
+
+        m_commandLineOptions->m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC;
+    }
+
     if (m_commandLineOptions->m_enableSyncMode)
     {
         SWSS_LOG_WARN("enable sync mode is deprecated, please use communication mode, FORCING redis sync mode");
@@ -84,6 +99,8 @@ Syncd::Syncd(
 
         m_contextConfig->m_zmqEnable = false;
 
+        m_contextConfig->m_shmEnable = false;
+
         m_commandLineOptions->m_redisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_REDIS_SYNC;
     }
 
@@ -93,10 +110,41 @@ Syncd::Syncd(
 
         m_contextConfig->m_zmqEnable = true;
 
+        m_contextConfig->m_shmEnable = false;
+
+        m_enableSyncMode = true;
+    }
+
+    if (m_commandLineOptions->m_redisCommunicationMode == SAI_REDIS_COMMUNICATION_MODE_SHM_SYNC)
+    {
+        SWSS_LOG_NOTICE("shm sync mode enabled via cmd line");
+
+        m_contextConfig->m_shmEnable = true;
+
+        m_contextConfig->m_zmqEnable = false;
+
         m_enableSyncMode = true;
     }
 
-    m_manager = std::make_shared<FlexCounterManager>(m_vendorSai, m_contextConfig->m_dbCounters);
+    m_manager = std::make_shared<FlexCounterManager>(
+            m_vendorSai,
+            m_contextConfig->m_dbCounters,
+            m_commandLineOptions->m_flexCounterWorkers,
+            m_commandLineOptions->m_flexCounterThreads);
+
+    if (m_commandLineOptions->m_eventPipelineDepth)
+    {
+        SWSS_LOG_NOTICE("event pipeline enabled, depth %u", m_commandLineOptions->m_eventPipelineDepth);
+
+        m_eventDecoder = std::make_shared<EventDecoder>();
+
+        m_eventWindowSize = m_commandLineOptions->m_eventPipelineDepth;
+    }
+
+    if (m_commandLineOptions->m_enableSaiBulkSupport)
+    {
+        m_eventWindowSize = std::max(m_eventWindowSize, (size_t)MAX_COALESCED_EVENTS);
+    }
 
     loadProfileMap();
 
@@ -114,7 +162,25 @@ Syncd::Syncd(
 
         m_enableSyncMode = true;
 
-        m_selectableChannel = std::make_shared<ZeroMQSelectableChannel>(m_contextConfig->m_zmqEndpoint);
+        m_selectableChannel = std::make_shared<ZeroMQSelectableChannel>(
+                m_contextConfig->m_zmqEndpoint,
+                m_contextConfig->m_zmqCodec,
+                m_contextConfig->m_zmqPipeline);
+    }
+    else if (m_contextConfig->m_shmEnable)
+    {
+        auto transport = std::make_shared<sairedis::ShmTransport>(
+                m_contextConfig->m_shmEndpoint,
+                sairedis::ShmTransport::ROLE_SERVER,
+                m_contextConfig->m_shmRingSize);
+
+        m_notifications = std::make_shared<ShmNotificationProducer>(transport);
+
+        SWSS_LOG_NOTICE("shm enabled, forcing sync mode");
+
+        m_enableSyncMode = true;
+
+        m_selectableChannel = std::make_shared<ShmSelectableChannel>(transport);
     }
     else
     {
@@ -134,7 +200,18 @@ Syncd::Syncd(
 
     m_client = std::make_shared<RedisClient>(m_dbAsic);
 
-    m_processor = std::make_shared<NotificationProcessor>(m_notifications, m_client, std::bind(&Syncd::syncProcessNotification, this, _1));
+    m_client->setScanBatchSize(m_commandLineOptions->m_redisScanBatchSize);
+
+    auto notificationQueue = std::make_shared<NotificationQueue>(
+            m_commandLineOptions->m_notificationQueueLimit,
+            m_commandLineOptions->m_notificationLaneLimit);
+
+    if (m_commandLineOptions->m_notificationLaneWeights.size())
+    {
+        notificationQueue->setDequeuePolicy(NOTIFICATION_DEQUEUE_POLICY_WEIGHTED, m_commandLineOptions->m_notificationLaneWeights);
+    }
+
+    m_processor = std::make_shared<NotificationProcessor>(m_notifications, m_client, std::bind(&Syncd::syncProcessNotifications, this, _1), notificationQueue);
     m_handler = std::make_shared<NotificationHandler>(m_processor);
 
     m_sn.onFdbEvent = std::bind(&NotificationHandler::onFdbEvent, m_handler.get(), _1, _2);
@@ -153,7 +230,7 @@ Syncd::Syncd(
     m_flexCounterGroup = std::make_shared<swss::ConsumerTable>(m_dbFlexCounter.get(), FLEX_COUNTER_GROUP_TABLE);
 
     m_switchConfigContainer = std::make_shared<sairedis::SwitchConfigContainer>();
-    m_redisVidIndexGenerator = std::make_shared<sairedis::RedisVidIndexGenerator>(m_dbAsic, REDIS_KEY_VIDCOUNTER);
+    m_redisVidIndexGenerator = std::make_shared<sairedis::RedisVidIndexGenerator>(m_dbAsic, REDIS_KEY_VIDCOUNTER, m_contextConfig->m_vidBlockSize);
 
     m_virtualObjectIdManager =
         std::make_shared<sairedis::VirtualObjectIdManager>(
@@ -166,6 +243,8 @@ Syncd::Syncd(
 
     m_processor->m_translator = m_translator; // TODO as param
 
+    m_processor->setFdbCoalesceWindow(m_commandLineOptions->m_fdbCoalesceWindowMs);
+
     m_veryFirstRun = isVeryFirstRun();
 
     performStartupLogic();
@@ -283,21 +362,474 @@ void Syncd::processEvent(
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    do
+    beginEventBatch();
+
+    try
+    {
+        if (m_eventWindowSize)
+        {
+            processEventLookahead(consumer);
+        }
+        else
+        {
+            do
+            {
+                swss::KeyOpFieldsValuesTuple kco;
+
+                /*
+                 * In init mode we put all data to TEMP view and we snoop.  We need
+                 * to specify temporary view prefix in consumer since consumer puts
+                 * data to redis db.
+                 */
+
+                consumer.pop(kco, isInitViewMode());
+
+                processSingleEvent(kco);
+            }
+            while (!consumer.empty());
+        }
+    }
+    catch (...)
     {
-        swss::KeyOpFieldsValuesTuple kco;
+        // results of already executed events must still be written
+
+        endEventBatch();
 
+        throw;
+    }
+
+    endEventBatch();
+}
+
+void Syncd::beginEventBatch()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_enableSyncMode)
+    {
+        return;
+    }
+
+    m_client->setAsicStateBatching(true);
+
+    m_eventBatch = true;
+}
+
+void Syncd::flushEventBatch()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_eventBatch)
+    {
+        return;
+    }
+
+    // ASIC state must be updated before client receives response
+
+    m_client->flushAsicStateUpdates();
+
+    for (auto& response: m_pendingResponses)
+    {
+        m_selectableChannel->set(kfvKey(response), kfvFieldsValues(response), kfvOp(response));
+    }
+
+    m_pendingResponses.clear();
+}
+
+void Syncd::endEventBatch()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_eventBatch)
+    {
+        return;
+    }
+
+    flushEventBatch();
+
+    m_client->setAsicStateBatching(false);
+
+    m_eventBatch = false;
+}
+
+void Syncd::sendResponse(
+        _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& values,
+        _In_ const std::string& op)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_eventBatch)
+    {
+        m_pendingResponses.emplace_back(key, op, values);
+        return;
+    }
+
+    m_selectableChannel->set(key, values, op);
+}
+
+void Syncd::processEventLookahead(
+        _In_ SelectableChannel& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    std::deque<std::shared_ptr<DecodedEvent>> window;
+
+    bool first = true;
+
+    bool barrier = false;
+
+    while (true)
+    {
         /*
-         * In init mode we put all data to TEMP view and we snoop.  We need
-         * to specify temporary view prefix in consumer since consumer puts
-         * data to redis db.
+         * Notify event can change init view mode, which affects how next
+         * events are popped, so nothing is popped after notify until it's
+         * executed.
          */
 
-        consumer.pop(kco, isInitViewMode());
+        while (!barrier &&
+                window.size() < m_eventWindowSize &&
+                (first || !consumer.empty()))
+        {
+            first = false;
+
+            auto event = std::make_shared<DecodedEvent>();
+
+            consumer.pop(event->kco, isInitViewMode());
+
+            barrier = (kfvOp(event->kco) == REDIS_ASIC_STATE_COMMAND_NOTIFY);
+
+            if (m_eventDecoder)
+            {
+                m_eventDecoder->submit(event);
+            }
+            else
+            {
+                EventDecoder::complete(*event);
+            }
+
+            window.push_back(event);
+        }
+
+        if (window.empty())
+        {
+            break;
+        }
+
+        auto event = window.front();
+
+        window.pop_front();
+
+        if (isCoalescableQuadEvent(*event))
+        {
+            std::vector<std::shared_ptr<DecodedEvent>> events = { event };
+
+            while (!window.empty() &&
+                    events.size() < MAX_COALESCED_EVENTS &&
+                    canCoalesceQuadEvent(*event, *window.front()))
+            {
+                events.push_back(window.front());
+
+                window.pop_front();
+            }
+
+            if (events.size() > 1)
+            {
+                processCoalescedQuadEvents(events);
+                continue;
+            }
+        }
+
+        processDecodedEvent(*event);
+
+        if (kfvOp(event->kco) == REDIS_ASIC_STATE_COMMAND_NOTIFY)
+        {
+            barrier = false;
+        }
+    }
+}
+
+sai_status_t Syncd::processDecodedEvent(
+        _Inout_ DecodedEvent& event)
+{
+    SWSS_LOG_ENTER();
+
+    event.wait();
+
+    auto& op = kfvOp(event.kco);
+
+    if (event.isQuad)
+    {
+        SWSS_LOG_INFO("key: %s op: %s", kfvKey(event.kco).c_str(), op.c_str());
+
+        if (op == REDIS_ASIC_STATE_COMMAND_CREATE)
+            return processQuadEvent(SAI_COMMON_API_CREATE, event.kco, event.quad);
+
+        if (op == REDIS_ASIC_STATE_COMMAND_REMOVE)
+            return processQuadEvent(SAI_COMMON_API_REMOVE, event.kco, event.quad);
+
+        if (op == REDIS_ASIC_STATE_COMMAND_SET)
+            return processQuadEvent(SAI_COMMON_API_SET, event.kco, event.quad);
+
+        return processQuadEvent(SAI_COMMON_API_GET, event.kco, event.quad);
+    }
+
+    if (event.isBulk)
+    {
+        SWSS_LOG_INFO("key: %s op: %s", kfvKey(event.kco).c_str(), op.c_str());
+
+        if (op == REDIS_ASIC_STATE_COMMAND_BULK_CREATE)
+            return processBulkQuadEvent(SAI_COMMON_API_BULK_CREATE, event.bulk);
 
-        processSingleEvent(kco);
+        if (op == REDIS_ASIC_STATE_COMMAND_BULK_REMOVE)
+            return processBulkQuadEvent(SAI_COMMON_API_BULK_REMOVE, event.bulk);
+
+        return processBulkQuadEvent(SAI_COMMON_API_BULK_SET, event.bulk);
+    }
+
+    // events which are not decoded ahead
+
+    return processSingleEvent(event.kco);
+}
+
+bool Syncd::isCoalescableQuadEvent(
+        _In_ DecodedEvent& event)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_commandLineOptions->m_enableSaiBulkSupport || isInitViewMode())
+    {
+        return false;
+    }
+
+    // decode error is not consumed here, it's thrown when event is executed
+
+    event.future.wait();
+
+    if (!event.isQuad)
+    {
+        return false;
+    }
+
+    auto& op = kfvOp(event.kco);
+
+    sai_common_api_t api;
+
+    if (op == REDIS_ASIC_STATE_COMMAND_CREATE)
+    {
+        api = SAI_COMMON_API_CREATE;
+    }
+    else if (op == REDIS_ASIC_STATE_COMMAND_REMOVE)
+    {
+        api = SAI_COMMON_API_REMOVE;
+    }
+    else
+    {
+        return false;
+    }
+
+    sai_object_type_t objectType = event.quad.metaKey.objecttype;
+
+    if (m_bulkNotSupported.find(std::make_pair(objectType, api)) != m_bulkNotSupported.end())
+    {
+        return false;
+    }
+
+    switch (objectType)
+    {
+        // entry types supported by processBulkCreateEntry/processBulkRemoveEntry
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+        case SAI_OBJECT_TYPE_NAT_ENTRY:
+        case SAI_OBJECT_TYPE_INSEG_ENTRY:
+            break;
+
+        // switch and port require extra actions after create/remove
+
+        case SAI_OBJECT_TYPE_SWITCH:
+        case SAI_OBJECT_TYPE_PORT:
+            return false;
+
+        default:
+
+            if (sai_metadata_get_object_type_info(objectType)->isnonobjectid)
+            {
+                return false;
+            }
+
+            break;
+    }
+
+    return !isSelfReferencingObjectType(objectType);
+}
+
+bool Syncd::canCoalesceQuadEvent(
+        _In_ DecodedEvent& first,
+        _In_ DecodedEvent& event)
+{
+    SWSS_LOG_ENTER();
+
+    if (!isCoalescableQuadEvent(event))
+    {
+        return false;
+    }
+
+    if (kfvOp(event.kco) != kfvOp(first.kco) ||
+            event.quad.metaKey.objecttype != first.quad.metaKey.objecttype)
+    {
+        return false;
+    }
+
+    auto info = sai_metadata_get_object_type_info(event.quad.metaKey.objecttype);
+
+    if (info->isobjectid)
+    {
+        // bulk oid create is executed on single switch
+
+        return VidManager::switchIdQuery(event.quad.metaKey.objectkey.key.object_id) ==
+            VidManager::switchIdQuery(first.quad.metaKey.objectkey.key.object_id);
+    }
+
+    return true;
+}
+
+bool Syncd::isSelfReferencingObjectType(
+        _In_ sai_object_type_t objectType)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_selfReferencingObjectTypes.find(objectType);
+
+    if (it != m_selfReferencingObjectTypes.end())
+    {
+        return it->second;
+    }
+
+    auto info = sai_metadata_get_object_type_info(objectType);
+
+    bool selfReferencing = false;
+
+    for (int idx = 0; info->attrmetadata[idx] != NULL; ++idx)
+    {
+        if (sai_metadata_is_allowed_object_type(info->attrmetadata[idx], objectType))
+        {
+            selfReferencing = true;
+            break;
+        }
+    }
+
+    m_selfReferencingObjectTypes[objectType] = selfReferencing;
+
+    return selfReferencing;
+}
+
+void Syncd::processCoalescedQuadEvents(
+        _In_ const std::vector<std::shared_ptr<DecodedEvent>>& events)
+{
+    SWSS_LOG_ENTER();
+
+    auto& op = kfvOp(events.front()->kco);
+
+    sai_common_api_t api = (op == REDIS_ASIC_STATE_COMMAND_CREATE)
+        ? SAI_COMMON_API_CREATE
+        : SAI_COMMON_API_REMOVE;
+
+    sai_object_type_t objectType = events.front()->quad.metaKey.objecttype;
+
+    std::vector<std::string> objectIds;
+
+    std::vector<std::shared_ptr<SaiAttributeList>> attributes;
+
+    for (auto& event: events)
+    {
+        objectIds.push_back(event->quad.strObjectId);
+
+        attributes.push_back(event->quad.list);
+    }
+
+    SWSS_LOG_INFO("executing %zu %s %s events in bulk",
+            events.size(),
+            op.c_str(),
+            sai_serialize_object_type(objectType).c_str());
+
+    if (api == SAI_COMMON_API_CREATE)
+    {
+        for (auto& list: attributes)
+        {
+            m_translator->translateVidToRid(objectType, list->get_attr_count(), list->get_attr_list());
+        }
+    }
+
+    auto info = sai_metadata_get_object_type_info(objectType);
+
+    sai_bulk_op_error_mode_t mode = SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR;
+
+    std::vector<sai_status_t> statuses(objectIds.size(), SAI_STATUS_FAILURE);
+
+    sai_status_t all;
+
+    if (info->isobjectid)
+    {
+        all = (api == SAI_COMMON_API_CREATE)
+            ? processBulkOidCreate(objectType, mode, objectIds, attributes, statuses)
+            : processBulkOidRemove(objectType, mode, objectIds, statuses);
+    }
+    else
+    {
+        all = (api == SAI_COMMON_API_CREATE)
+            ? processBulkCreateEntry(objectType, objectIds, attributes, statuses)
+            : processBulkRemoveEntry(objectType, objectIds, statuses);
+    }
+
+    if (all == SAI_STATUS_NOT_SUPPORTED || all == SAI_STATUS_NOT_IMPLEMENTED)
+    {
+        SWSS_LOG_NOTICE("bulk %s is not supported for %s, executing events one by one",
+                op.c_str(),
+                sai_serialize_object_type(objectType).c_str());
+
+        m_bulkNotSupported.insert(std::make_pair(objectType, api));
+
+        for (auto& event: events)
+        {
+            // attributes were translated to RIDs in place, decode them again
+
+            EventDecoder::decodeQuadEvent(event->kco, event->quad);
+
+            processQuadEvent(api, event->kco, event->quad);
+        }
+
+        return;
+    }
+
+    for (size_t idx = 0; idx < events.size(); idx++)
+    {
+        auto& kco = events[idx]->kco;
+
+        sai_status_t status = statuses[idx];
+
+        sendApiResponse(api, status);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            for (const auto &v: kfvFieldsValues(kco))
+            {
+                SWSS_LOG_ERROR("attr: %s: %s", fvField(v).c_str(), fvValue(v).c_str());
+            }
+
+            if (!m_enableSyncMode)
+            {
+                // throw only when sync mode is not enabled
+
+                SWSS_LOG_THROW("failed to execute api: %s, key: %s, status: %s",
+                        op.c_str(),
+                        kfvKey(kco).c_str(),
+                        sai_serialize_status(status).c_str());
+            }
+        }
+
+        syncUpdateRedisQuadEvent(status, api, kco);
     }
-    while (!consumer.empty());
 }
 
 sai_status_t Syncd::processSingleEvent(
@@ -338,12 +870,22 @@ sai_status_t Syncd::processSingleEvent(
     if (op == REDIS_ASIC_STATE_COMMAND_BULK_SET)
         return processBulkQuadEvent(SAI_COMMON_API_BULK_SET, kco);
 
+    /*
+     * Events below can read ASIC state, so batched updates and responses of
+     * previous events are flushed first.
+     */
+
+    flushEventBatch();
+
     if (op == REDIS_ASIC_STATE_COMMAND_NOTIFY)
         return processNotifySyncd(kco);
 
     if (op == REDIS_ASIC_STATE_COMMAND_GET_STATS)
         return processGetStatsEvent(kco);
 
+    if (op == REDIS_ASIC_STATE_COMMAND_BULK_GET_STATS)
+        return processBulkGetStatsEvent(kco);
+
     if (op == REDIS_ASIC_STATE_COMMAND_CLEAR_STATS)
         return processClearStatsEvent(kco);
 
@@ -380,7 +922,7 @@ sai_status_t Syncd::processAttrCapabilityQuery(
     {
         SWSS_LOG_ERROR("Invalid input: expected 2 arguments, received %zu", values.size());
 
-        m_selectableChannel->set(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_ATTR_CAPABILITY_RESPONSE);
+        sendResponse(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_ATTR_CAPABILITY_RESPONSE);
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -410,7 +952,7 @@ sai_status_t Syncd::processAttrCapabilityQuery(
             capability.create_implemented, capability.set_implemented, capability.get_implemented);
     }
 
-    m_selectableChannel->set(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_ATTR_CAPABILITY_RESPONSE);
+    sendResponse(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_ATTR_CAPABILITY_RESPONSE);
 
     return status;
 }
@@ -433,7 +975,7 @@ sai_status_t Syncd::processAttrEnumValuesCapabilityQuery(
     {
         SWSS_LOG_ERROR("Invalid input: expected 3 arguments, received %zu", values.size());
 
-        m_selectableChannel->set(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_ATTR_ENUM_VALUES_CAPABILITY_RESPONSE);
+        sendResponse(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_ATTR_ENUM_VALUES_CAPABILITY_RESPONSE);
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -477,7 +1019,7 @@ sai_status_t Syncd::processAttrEnumValuesCapabilityQuery(
         SWSS_LOG_DEBUG("Sending response: capabilities = '%s', count = %d", strCap.c_str(), enumCapList.count);
     }
 
-    m_selectableChannel->set(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_ATTR_ENUM_VALUES_CAPABILITY_RESPONSE);
+    sendResponse(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_ATTR_ENUM_VALUES_CAPABILITY_RESPONSE);
 
     return status;
 }
@@ -530,7 +1072,7 @@ sai_status_t Syncd::processObjectTypeGetAvailabilityQuery(
         SWSS_LOG_DEBUG("Sending response: count = %lu", count);
     }
 
-    m_selectableChannel->set(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_OBJECT_TYPE_GET_AVAILABILITY_RESPONSE);
+    sendResponse(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_OBJECT_TYPE_GET_AVAILABILITY_RESPONSE);
 
     return status;
 }
@@ -570,7 +1112,7 @@ sai_status_t Syncd::processFdbFlush(
 
     sai_status_t status = m_vendorSai->flushFdbEntries(switchRid, attr_count, attr_list);
 
-    m_selectableChannel->set(sai_serialize_status(status), {} , REDIS_ASIC_STATE_COMMAND_FLUSHRESPONSE);
+    sendResponse(sai_serialize_status(status), {} , REDIS_ASIC_STATE_COMMAND_FLUSHRESPONSE);
 
     if (status == SAI_STATUS_SUCCESS)
     {
@@ -629,7 +1171,7 @@ sai_status_t Syncd::processClearStatsEvent(
     {
         SWSS_LOG_WARN("VID to RID translation failure: %s", key.c_str());
         sai_status_t status = SAI_STATUS_INVALID_OBJECT_ID;
-        m_selectableChannel->set(sai_serialize_status(status), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+        sendResponse(sai_serialize_status(status), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
         return status;
     }
 
@@ -656,7 +1198,7 @@ sai_status_t Syncd::processClearStatsEvent(
             (uint32_t)counter_ids.size(),
             counter_ids.data());
 
-    m_selectableChannel->set(sai_serialize_status(status), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+    sendResponse(sai_serialize_status(status), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
     return status;
 }
@@ -717,69 +1259,226 @@ sai_status_t Syncd::processGetStatsEvent(
         }
     }
 
-    m_selectableChannel->set(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+    sendResponse(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
     return status;
 }
 
-sai_status_t Syncd::processBulkQuadEvent(
-        _In_ sai_common_api_t api,
+sai_status_t Syncd::processBulkGetStatsEvent(
         _In_ const swss::KeyOpFieldsValuesTuple &kco)
 {
     SWSS_LOG_ENTER();
 
-    const std::string& key = kfvKey(kco); // objectType:count
+    const std::string &key = kfvKey(kco); // objectType:switchVid
 
-    std::string strObjectType = key.substr(0, key.find(":"));
+    const auto& values = kfvFieldsValues(kco);
 
-    sai_object_type_t objectType;
-    sai_deserialize_object_type(strObjectType, objectType);
+    // first value is (mode, object count), followed by object ids and
+    // counter ids shared by all objects
 
-    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
+    auto pos = key.find(":");
 
-    std::vector<std::vector<swss::FieldValueTuple>> strAttributes;
+    uint32_t objectCount = 0;
 
-    // field = objectId
-    // value = attrid=attrvalue|...
+    if (pos != std::string::npos && values.size())
+    {
+        try
+        {
+            sai_deserialize_number(fvValue(values[0]), objectCount);
+        }
+        catch (const std::exception&)
+        {
+            objectCount = 0; // reported as invalid request below
+        }
+    }
 
-    std::vector<std::string> objectIds;
+    if (pos == std::string::npos || objectCount == 0 || values.size() <= 1 + (size_t)objectCount)
+    {
+        SWSS_LOG_ERROR("invalid bulk get stats request: %s, values: %zu", key.c_str(), values.size());
 
-    std::vector<std::shared_ptr<SaiAttributeList>> attributes;
+        sendResponse(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
-    for (const auto &fvt: values)
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    // request comes from client, so it must not throw on invalid input
+
+    sai_object_type_t objectType = SAI_OBJECT_TYPE_NULL;
+
+    sai_object_id_t switchRid = SAI_NULL_OBJECT_ID;
+
+    const sai_object_type_info_t* info = nullptr;
+
+    int32_t mode = 0;
+
+    std::vector<sai_stat_id_t> counterIds;
+
+    // objects which can't be translated (for example removed in the
+    // meantime) are not passed to vendor
+
+    std::vector<sai_status_t> statuses(objectCount, SAI_STATUS_INVALID_OBJECT_ID);
+
+    std::vector<sai_object_key_t> objectKeys;
+
+    std::vector<uint32_t> objectIndexes;
+
+    try
     {
-        std::string strObjectId = fvField(fvt);
-        std::string joined = fvValue(fvt);
+        sai_deserialize_object_type(key.substr(0, pos), objectType);
 
-        // decode values
+        info = sai_metadata_get_object_type_info(objectType);
 
-        auto v = swss::tokenize(joined, '|');
+        if (info == nullptr || info->isnonobjectid || info->statenum == nullptr)
+        {
+            SWSS_LOG_ERROR("bulk get stats not supported on %s", key.substr(0, pos).c_str());
 
-        objectIds.push_back(strObjectId);
+            sendResponse(sai_serialize_status(SAI_STATUS_NOT_SUPPORTED), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
-        std::vector<swss::FieldValueTuple> entries; // attributes per object id
+            return SAI_STATUS_NOT_SUPPORTED;
+        }
+
+        sai_object_id_t switchVid;
+        sai_deserialize_object_id(key.substr(pos + 1), switchVid);
+
+        switchRid = m_translator->translateVidToRid(switchVid);
+
+        sai_deserialize_enum(fvField(values[0]), &sai_metadata_enum_sai_stats_mode_t, mode);
+
+        for (size_t idx = 1 + objectCount; idx < values.size(); idx++)
+        {
+            int32_t val;
+            sai_deserialize_enum(fvField(values[idx]), info->statenum, val);
 
-        for (size_t i = 0; i < v.size(); ++i)
+            counterIds.push_back(val);
+        }
+
+        for (uint32_t idx = 0; idx < objectCount; idx++)
         {
-            const std::string item = v.at(i);
+            sai_object_id_t vid;
+            sai_deserialize_object_id(fvField(values[1 + idx]), vid);
+
+            sai_object_key_t objectKey;
+
+            if (!m_translator->tryTranslateVidToRid(vid, objectKey.key.object_id))
+            {
+                SWSS_LOG_ERROR("failed to translate vid %s", fvField(values[1 + idx]).c_str());
 
-            auto start = item.find_first_of("=");
+                continue;
+            }
 
-            auto field = item.substr(0, start);
-            auto value = item.substr(start + 1);
+            objectKeys.push_back(objectKey);
 
-            entries.emplace_back(field, value);
+            objectIndexes.push_back(idx);
         }
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("invalid bulk get stats request: %s: %s", key.c_str(), e.what());
+
+        sendResponse(sai_serialize_status(SAI_STATUS_INVALID_PARAMETER), {}, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
-        strAttributes.push_back(entries);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
 
-        // since now we converted this to proper list, we can extract attributes
+    std::vector<uint64_t> result(objectKeys.size() * counterIds.size());
 
-        auto list = std::make_shared<SaiAttributeList>(objectType, entries, false);
+    std::vector<sai_status_t> vendorStatuses(objectKeys.size(), SAI_STATUS_NOT_EXECUTED);
 
-        attributes.push_back(list);
+    if (objectKeys.size())
+    {
+        m_vendorSai->bulkGetStats(
+                switchRid,
+                objectType,
+                (uint32_t)objectKeys.size(),
+                objectKeys.data(),
+                (uint32_t)counterIds.size(),
+                counterIds.data(),
+                (sai_stats_mode_t)mode,
+                vendorStatuses.data(),
+                result.data());
     }
 
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    std::vector<swss::FieldValueTuple> entry;
+
+    entry.reserve(objectCount);
+
+    size_t vendorIdx = 0;
+
+    for (uint32_t idx = 0; idx < objectCount; idx++)
+    {
+        std::string counters;
+
+        if (vendorIdx < objectIndexes.size() && objectIndexes[vendorIdx] == idx)
+        {
+            statuses[idx] = vendorStatuses[vendorIdx];
+
+            if (statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                const uint64_t *objectCounters = &result[vendorIdx * counterIds.size()];
+
+                for (size_t c = 0; c < counterIds.size(); c++)
+                {
+                    if (c)
+                    {
+                        counters += ",";
+                    }
+
+                    counters += std::to_string(objectCounters[c]);
+                }
+            }
+
+            vendorIdx++;
+        }
+
+        if (statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+
+        entry.emplace_back(sai_serialize_status(statuses[idx]), counters);
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to get stats on some of %u %s objects", objectCount, info->objecttypename);
+    }
+
+    sendResponse(sai_serialize_status(status), entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+
+    return status;
+}
+
+sai_status_t Syncd::processBulkQuadEvent(
+        _In_ sai_common_api_t api,
+        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    DecodedBulkQuadEvent decoded;
+
+    EventDecoder::decodeBulkQuadEvent(kco, decoded);
+
+    return processBulkQuadEvent(api, decoded);
+}
+
+sai_status_t Syncd::processBulkQuadEvent(
+        _In_ sai_common_api_t api,
+        _Inout_ DecodedBulkQuadEvent& decoded)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string& strObjectType = decoded.strObjectType;
+
+    sai_object_type_t objectType = decoded.objectType;
+
+    const auto& objectIds = decoded.objectIds;
+
+    const auto& strAttributes = decoded.strAttributes;
+
+    auto& attributes = decoded.attributes;
+
     SWSS_LOG_INFO("bulk %s executing with %zu items",
             strObjectType.c_str(),
             objectIds.size());
@@ -1294,6 +1993,10 @@ sai_status_t Syncd::processBulkEntry(
                 sai_deserialize_fdb_entry(objectIds[idx], metaKey.objectkey.key.fdb_entry);
                 break;
 
+            case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+                sai_deserialize_neighbor_entry(objectIds[idx], metaKey.objectkey.key.neighbor_entry);
+                break;
+
             case SAI_OBJECT_TYPE_INSEG_ENTRY:
                 sai_deserialize_inseg_entry(objectIds[idx], metaKey.objectkey.key.inseg_entry);
                 break;
@@ -1495,7 +2198,7 @@ sai_status_t Syncd::processBulkOidRemove(
     status = m_vendorSai->bulkRemove(
                                 objectType,
                                 (uint32_t)object_count,
-                                objectVids.data(),
+                                objectRids.data(),
                                 mode,
                                 statuses.data());
 
@@ -1920,7 +2623,7 @@ void Syncd::sendApiResponse(
             sai_serialize_common_api(api).c_str(),
             strStatus.c_str());
 
-    m_selectableChannel->set(strStatus, entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+    sendResponse(strStatus, entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
     SWSS_LOG_INFO("response for %s api was send",
             sai_serialize_common_api(api).c_str());
@@ -2213,35 +2916,36 @@ sai_status_t Syncd::processQuadEvent(
 {
     SWSS_LOG_ENTER();
 
-    const std::string& key = kfvKey(kco);
-    const std::string& op = kfvOp(kco);
+    DecodedQuadEvent decoded;
 
-    const std::string& strObjectId = key.substr(key.find(":") + 1);
+    EventDecoder::decodeQuadEvent(kco, decoded);
 
-    sai_object_meta_key_t metaKey;
-    sai_deserialize_object_meta_key(key, metaKey);
+    return processQuadEvent(api, kco, decoded);
+}
 
-    if (!sai_metadata_is_object_type_valid(metaKey.objecttype))
-    {
-        SWSS_LOG_THROW("invalid object type %s", key.c_str());
-    }
+sai_status_t Syncd::processQuadEvent(
+        _In_ sai_common_api_t api,
+        _In_ const swss::KeyOpFieldsValuesTuple &kco,
+        _Inout_ DecodedQuadEvent& decoded)
+{
+    SWSS_LOG_ENTER();
 
-    auto& values = kfvFieldsValues(kco);
+    const std::string& key = kfvKey(kco);
+    const std::string& op = kfvOp(kco);
 
-    for (auto& v: values)
-    {
-        SWSS_LOG_DEBUG("attr: %s: %s", fvField(v).c_str(), fvValue(v).c_str());
-    }
+    const std::string& strObjectId = decoded.strObjectId;
 
-    SaiAttributeList list(metaKey.objecttype, values, false);
+    const sai_object_meta_key_t& metaKey = decoded.metaKey;
+
+    auto& values = kfvFieldsValues(kco);
 
     /*
      * Attribute list can't be const since we will use it to translate VID to
      * RID in place.
      */
 
-    sai_attribute_t *attr_list = list.get_attr_list();
-    uint32_t attr_count = list.get_attr_count();
+    sai_attribute_t *attr_list = decoded.list->get_attr_list();
+    uint32_t attr_count = decoded.list->get_attr_count();
 
     /*
      * NOTE: This check pointers must be executed before init view mode, since
@@ -2800,7 +3504,7 @@ void Syncd::sendGetResponse(
      * response will not put any data to table, only queue is used.
      */
 
-    m_selectableChannel->set(strStatus, entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
+    sendResponse(strStatus, entry, REDIS_ASIC_STATE_COMMAND_GETRESPONSE);
 
     SWSS_LOG_INFO("response for GET api was send");
 }
@@ -2995,104 +3699,104 @@ void Syncd::inspectAsic()
 {
     SWSS_LOG_ENTER();
 
-    // Fetch all the keys from ASIC DB
-    // Loop through all the keys in ASIC DB
-
-    for (const auto &key: m_client->getAsicStateKeys())
-    {
-        // ASIC_STATE:objecttype:objectid (object id may contain ':')
+    // Loop through all the objects in ASIC DB
 
-        auto start = key.find_first_of(":");
+    m_client->scanAsicState(ASIC_STATE_TABLE, [this](const std::string& key, const std::vector<swss::FieldValueTuple>& values) {
+            inspectAsicObject(key, values);
+    });
+}
 
-        if (start == std::string::npos)
-        {
-            SWSS_LOG_ERROR("invalid ASIC_STATE_TABLE %s: no start :", key.c_str());
-            break;
-        }
+void Syncd::inspectAsicObject(
+        _In_ const std::string& key,
+        _In_ const std::vector<swss::FieldValueTuple>& values)
+{
+    SWSS_LOG_ENTER();
 
-        auto mk = key.substr(start + 1);
+    // ASIC_STATE:objecttype:objectid (object id may contain ':')
 
-        sai_object_meta_key_t metaKey;
-        sai_deserialize_object_meta_key(mk, metaKey);
+    auto start = key.find_first_of(":");
 
-        // Find all the attrid from ASIC DB, and use them to query ASIC
+    if (start == std::string::npos)
+    {
+        SWSS_LOG_ERROR("invalid ASIC_STATE_TABLE %s: no start :", key.c_str());
+        return;
+    }
 
-        auto hash = m_client->getAttributesFromAsicKey(key);
+    auto mk = key.substr(start + 1);
 
-        std::vector<swss::FieldValueTuple> values;
+    sai_object_meta_key_t metaKey;
+    sai_deserialize_object_meta_key(mk, metaKey);
 
-        for (auto &kv: hash)
-        {
-            const std::string &skey = kv.first;
-            const std::string &svalue = kv.second;
+    // Find all the attrid from ASIC DB, and use them to query ASIC
 
-            swss::FieldValueTuple fvt(skey, svalue);
+    std::unordered_map<std::string, std::string> hash;
 
-            values.push_back(fvt);
-        }
+    for (auto &fv: values)
+    {
+        hash[fvField(fv)] = fvValue(fv);
+    }
 
-        SaiAttributeList list(metaKey.objecttype, values, false);
+    SaiAttributeList list(metaKey.objecttype, values, false);
 
-        sai_attribute_t *attr_list = list.get_attr_list();
+    sai_attribute_t *attr_list = list.get_attr_list();
 
-        uint32_t attr_count = list.get_attr_count();
+    uint32_t attr_count = list.get_attr_count();
 
-        SWSS_LOG_DEBUG("attr count: %u", list.get_attr_count());
+    SWSS_LOG_DEBUG("attr count: %u", list.get_attr_count());
 
-        if (attr_count == 0)
-        {
-            // TODO: how to check ASIC on ASIC DB key with NULL:NULL hash
-            // just ignore for now
-            continue;
-        }
+    if (attr_count == 0)
+    {
+        // TODO: how to check ASIC on ASIC DB key with NULL:NULL hash
+        // just ignore for now
+        return;
+    }
 
-        m_translator->translateVidToRid(metaKey);
+    m_translator->translateVidToRid(metaKey);
 
-        sai_status_t status = m_vendorSai->get(metaKey, attr_count, attr_list);
+    sai_status_t status = m_vendorSai->get(metaKey, attr_count, attr_list);
 
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("failed to execute get api on %s: %s",
-                    sai_serialize_object_meta_key(metaKey).c_str(),
-                    sai_serialize_status(status).c_str());
-            continue;
-        }
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("failed to execute get api on %s: %s",
+                sai_serialize_object_meta_key(metaKey).c_str(),
+                sai_serialize_status(status).c_str());
+        return;
+    }
 
-        // compare fields and values from ASIC_DB and SAI response and log the difference
+    // compare fields and values from ASIC_DB and SAI response and log the difference
 
-        for (uint32_t index = 0; index < attr_count; ++index)
-        {
-            const sai_attribute_t& attr = attr_list[index];
+    for (uint32_t index = 0; index < attr_count; ++index)
+    {
+        const sai_attribute_t& attr = attr_list[index];
 
-            auto meta = sai_metadata_get_attr_metadata(metaKey.objecttype, attr.id);
+        auto meta = sai_metadata_get_attr_metadata(metaKey.objecttype, attr.id);
 
-            if (meta == NULL)
-            {
-                SWSS_LOG_ERROR("FATAL: failed to find metadata for object type %s and attr id %d",
-                        sai_serialize_object_type(metaKey.objecttype).c_str(),
-                        attr.id);
-                break;
-            }
+        if (meta == NULL)
+        {
+            SWSS_LOG_ERROR("FATAL: failed to find metadata for object type %s and attr id %d",
+                    sai_serialize_object_type(metaKey.objecttype).c_str(),
+                    attr.id);
+            break;
+        }
 
-            std::string strSaiAttrValue = sai_serialize_attr_value(*meta, attr, false);
+        std::string strSaiAttrValue = sai_serialize_attr_value(*meta, attr, false);
 
-            std::string strRedisAttrValue = hash[meta->attridname];
+        std::string strRedisAttrValue = hash[meta->attridname];
 
-            if (strRedisAttrValue == strSaiAttrValue)
-            {
-                SWSS_LOG_INFO("matched %s REDIS and ASIC attr value '%s' with on %s",
-                        meta->attridname,
-                        strRedisAttrValue.c_str(),
-                        sai_serialize_object_meta_key(metaKey).c_str());
-            }
-            else
-            {
-                SWSS_LOG_ERROR("failed to match %s REDIS attr '%s' with ASIC attr '%s' for %s",
-                        meta->attridname,
-                        strRedisAttrValue.c_str(),
-                        strSaiAttrValue.c_str(),
-                        sai_serialize_object_meta_key(metaKey).c_str());
-            }
+        if (strRedisAttrValue == strSaiAttrValue)
+        {
+            SWSS_LOG_INFO("matched %s REDIS and ASIC attr value '%s' with on %s",
+                    meta->attridname,
+                    strRedisAttrValue.c_str(),
+                    sai_serialize_object_meta_key(metaKey).c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("failed to match %s REDIS attr '%s' with ASIC attr '%s' for %s",
+                    meta->attridname,
+                    strRedisAttrValue.c_str(),
+                    strSaiAttrValue.c_str(),
+                    sai_serialize_object_meta_key(metaKey).c_str());
         }
     }
 }
@@ -3228,8 +3932,7 @@ sai_status_t Syncd::processNotifySyncd(
         {
             /*
              * We successfully applied new view, VID mapping could change, so
-             * we need to clear local db, and all new VIDs will be queried
-             * using redis.
+             * we need to reload local VID and RID maps from redis.
              *
              * TODO possible race condition - get notification when new view is
              * applied and cache have old values, and notification start's
@@ -3283,7 +3986,7 @@ void Syncd::sendNotifyResponse(
 
     SWSS_LOG_INFO("sending response: %s", strStatus.c_str());
 
-    m_selectableChannel->set(strStatus, entry, REDIS_ASIC_STATE_COMMAND_NOTIFY);
+    sendResponse(strStatus, entry, REDIS_ASIC_STATE_COMMAND_NOTIFY);
 }
 
 void Syncd::clearTempView()
@@ -3591,7 +4294,7 @@ void Syncd::updateRedisDatabase(
         }
     }
 
-    m_client->setVidAndRidMap(allVid2Rid);
+    m_translator->setVidAndRidMap(allVid2Rid);
 
     SWSS_LOG_NOTICE("updated redis database");
 }
@@ -4267,14 +4970,14 @@ sai_status_t Syncd::setUninitDataPlaneOnRemovalOnAllSwitches()
     return result;
 }
 
-void Syncd::syncProcessNotification(
-        _In_ const swss::KeyOpFieldsValuesTuple& item)
+void Syncd::syncProcessNotifications(
+        _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     SWSS_LOG_ENTER();
 
-    m_processor->syncProcessNotification(item);
+    m_processor->syncProcessNotifications(items);
 }
 
 bool Syncd::isVeryFirstRun()
@@ -4529,6 +5232,10 @@ void Syncd::run()
     // Stop notification thread after removing switch
     m_processor->stopNotificationsProcessingThread();
 
+    // VID and RID maps are written behind, warm boot needs all of them in redis
+
+    m_client->flushVidAndRidMap();
+
     if (shutdownType == SYNCD_RESTART_TYPE_WARM)
     {
         warmRestartTable.setWarmShutdown(status == SAI_STATUS_SUCCESS);
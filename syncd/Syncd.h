@@ -17,6 +17,7 @@
 #include "BreakConfig.h"
 #include "NotificationProducerBase.h"
 #include "SelectableChannel.h"
+#include "EventDecoder.h"
 
 #include "meta/SaiAttributeList.h"
 
@@ -25,6 +26,7 @@
 #include "swss/notificationconsumer.h"
 
 #include <memory>
+#include <set>
 
 namespace syncd
 {
@@ -123,6 +125,66 @@ namespace syncd
             sai_status_t processSingleEvent(
                     _In_ const swss::KeyOpFieldsValuesTuple &kco);
 
+            /**
+             * @brief Pop events ahead and decode them on decoder thread while
+             * previous events are executed. Events are executed in the order
+             * they were popped.
+             *
+             * When SAI bulk support is enabled, consecutive create or remove
+             * events of the same object type found in the window are executed
+             * by single bulk call.
+             */
+            void processEventLookahead(
+                    _In_ SelectableChannel& consumer);
+
+            sai_status_t processDecodedEvent(
+                    _Inout_ DecodedEvent& event);
+
+            /**
+             * @brief Start batching ASIC state updates and responses of
+             * events processed in single select wakeup, in sync mode.
+             */
+            void beginEventBatch();
+
+            /**
+             * @brief Write batched ASIC state updates and then send queued
+             * responses.
+             */
+            void flushEventBatch();
+
+            void endEventBatch();
+
+            void sendResponse(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& values,
+                    _In_ const std::string& op);
+
+            /**
+             * @brief Check whether single create/remove event can be executed
+             * as part of bulk call.
+             */
+            bool isCoalescableQuadEvent(
+                    _In_ DecodedEvent& event);
+
+            bool canCoalesceQuadEvent(
+                    _In_ DecodedEvent& first,
+                    _In_ DecodedEvent& event);
+
+            /**
+             * @brief Object type has attributes which can reference objects
+             * of the same type, so objects of such type created or removed
+             * in one bulk call could depend on each other.
+             */
+            bool isSelfReferencingObjectType(
+                    _In_ sai_object_type_t objectType);
+
+            /**
+             * @brief Execute same type create or remove events by single
+             * bulk call and send response for each event.
+             */
+            void processCoalescedQuadEvents(
+                    _In_ const std::vector<std::shared_ptr<DecodedEvent>>& events);
+
             sai_status_t processAttrCapabilityQuery(
                     _In_ const swss::KeyOpFieldsValuesTuple &kco);
 
@@ -141,14 +203,26 @@ namespace syncd
             sai_status_t processGetStatsEvent(
                     _In_ const swss::KeyOpFieldsValuesTuple &kco);
 
+            sai_status_t processBulkGetStatsEvent(
+                    _In_ const swss::KeyOpFieldsValuesTuple &kco);
+
             sai_status_t processQuadEvent(
                     _In_ sai_common_api_t api,
                     _In_ const swss::KeyOpFieldsValuesTuple &kco);
 
+            sai_status_t processQuadEvent(
+                    _In_ sai_common_api_t api,
+                    _In_ const swss::KeyOpFieldsValuesTuple &kco,
+                    _Inout_ DecodedQuadEvent& decoded);
+
             sai_status_t processBulkQuadEvent(
                     _In_ sai_common_api_t api,
                     _In_ const swss::KeyOpFieldsValuesTuple &kco);
 
+            sai_status_t processBulkQuadEvent(
+                    _In_ sai_common_api_t api,
+                    _Inout_ DecodedBulkQuadEvent& decoded);
+
             sai_status_t processBulkOid(
                     _In_ sai_object_type_t objectType,
                     _In_ const std::vector<std::string> &object_ids,
@@ -277,13 +351,17 @@ namespace syncd
                     _In_ uint32_t attr_count,
                     _In_ sai_attribute_t *attr_list);
 
-            void syncProcessNotification(
-                    _In_ const swss::KeyOpFieldsValuesTuple& item);
+            void syncProcessNotifications(
+                    _In_ const std::vector<swss::KeyOpFieldsValuesTuple>& items);
 
         private:
 
             void inspectAsic();
 
+            void inspectAsicObject(
+                    _In_ const std::string& key,
+                    _In_ const std::vector<swss::FieldValueTuple>& values);
+
             void clearTempView();
 
             sai_status_t onApplyViewInFastFastBoot();
@@ -444,6 +522,22 @@ namespace syncd
 
             bool m_enableSyncMode;
 
+            std::shared_ptr<EventDecoder> m_eventDecoder;
+
+            size_t m_eventWindowSize;
+
+            std::map<sai_object_type_t, bool> m_selfReferencingObjectTypes;
+
+            /**
+             * @brief Object type and api pairs for which vendor returned
+             * not supported on bulk call, those are not coalesced anymore.
+             */
+            std::set<std::pair<sai_object_type_t, sai_common_api_t>> m_bulkNotSupported;
+
+            bool m_eventBatch;
+
+            std::vector<swss::KeyOpFieldsValuesTuple> m_pendingResponses;
+
         private:
 
             /**
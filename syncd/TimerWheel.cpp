@@ -0,0 +1,236 @@
+#include "TimerWheel.h"
+
+#include "swss/logger.h"
+
+#include <algorithm>
+
+using namespace syncd;
+
+#define TIMER_WHEEL_SLOT_BITS   (6)
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS      (4)
+
+// timers which don't fit into top level are kept in extra slot
+
+#define TIMER_WHEEL_OVERFLOW_SLOT (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+
+TimerWheel::TimerWheel(
+        _In_ uint64_t currentTick):
+    m_currentTick(currentTick),
+    m_slots(TIMER_WHEEL_OVERFLOW_SLOT + 1)
+{
+    SWSS_LOG_ENTER();
+
+    // empty
+}
+
+void TimerWheel::insert(
+        _In_ uint64_t id,
+        _In_ uint64_t expireTick)
+{
+    SWSS_LOG_ENTER();
+
+    size_t slot = TIMER_WHEEL_OVERFLOW_SLOT;
+
+    for (size_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        size_t shift = TIMER_WHEEL_SLOT_BITS * (level + 1);
+
+        // timer belongs to level where it shares upper bits with current
+        // tick, so it will be cascaded before it expires
+
+        if ((expireTick >> shift) == (m_currentTick >> shift))
+        {
+            slot = level * TIMER_WHEEL_SLOTS + ((expireTick >> (shift - TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK);
+            break;
+        }
+    }
+
+    m_timers[id] = Timer{expireTick, slot};
+
+    m_slots[slot].insert(id);
+}
+
+void TimerWheel::remove(
+        _In_ uint64_t id)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_timers.find(id);
+
+    if (it == m_timers.end())
+    {
+        return;
+    }
+
+    m_slots[it->second.slot].erase(id);
+
+    m_timers.erase(it);
+}
+
+void TimerWheel::schedule(
+        _In_ uint64_t id,
+        _In_ uint64_t expireTick)
+{
+    SWSS_LOG_ENTER();
+
+    remove(id);
+
+    if (expireTick <= m_currentTick)
+    {
+        // current tick slot was already processed, so timer in the past
+        // expires on next tick
+
+        expireTick = m_currentTick + 1;
+    }
+
+    insert(id, expireTick);
+}
+
+void TimerWheel::cancel(
+        _In_ uint64_t id)
+{
+    SWSS_LOG_ENTER();
+
+    remove(id);
+}
+
+bool TimerWheel::isScheduled(
+        _In_ uint64_t id) const
+{
+    SWSS_LOG_ENTER();
+
+    return m_timers.find(id) != m_timers.end();
+}
+
+void TimerWheel::cascade(
+        _In_ size_t level)
+{
+    SWSS_LOG_ENTER();
+
+    size_t slot = (level == TIMER_WHEEL_LEVELS)
+        ? TIMER_WHEEL_OVERFLOW_SLOT
+        : level * TIMER_WHEEL_SLOTS + ((m_currentTick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+
+    std::unordered_set<uint64_t> ids;
+
+    ids.swap(m_slots[slot]);
+
+    for (auto id: ids)
+    {
+        uint64_t expireTick = m_timers.at(id).expireTick;
+
+        m_timers.erase(id);
+
+        insert(id, expireTick);
+    }
+}
+
+void TimerWheel::advance(
+        _In_ uint64_t tick,
+        _Inout_ std::vector<uint64_t>& expired)
+{
+    SWSS_LOG_ENTER();
+
+    while (m_currentTick < tick)
+    {
+        if (m_timers.empty())
+        {
+            m_currentTick = tick;
+            break;
+        }
+
+        // skip ticks which can't expire or cascade anything, when lower
+        // levels are empty jump to the last tick before higher level slot
+        // boundary
+
+        for (size_t level = 0; level < TIMER_WHEEL_LEVELS && isLevelEmpty(level); level++)
+        {
+            uint64_t boundary = m_currentTick | ((1ULL << (TIMER_WHEEL_SLOT_BITS * (level + 1))) - 1);
+
+            if (boundary >= tick)
+            {
+                break;
+            }
+
+            m_currentTick = boundary;
+        }
+
+        m_currentTick++;
+
+        // cascade from top level, so timers can fall through multiple levels
+        // at once
+
+        for (size_t level = TIMER_WHEEL_LEVELS; level > 0; level--)
+        {
+            uint64_t mask = (1ULL << (TIMER_WHEEL_SLOT_BITS * level)) - 1;
+
+            if ((m_currentTick & mask) == 0)
+            {
+                cascade(level);
+            }
+        }
+
+        auto& slot = m_slots[m_currentTick & TIMER_WHEEL_SLOT_MASK];
+
+        for (auto id: slot)
+        {
+            expired.push_back(id);
+
+            m_timers.erase(id);
+        }
+
+        slot.clear();
+    }
+}
+
+bool TimerWheel::isLevelEmpty(
+        _In_ size_t level) const
+{
+    SWSS_LOG_ENTER();
+
+    for (size_t idx = 0; idx < TIMER_WHEEL_SLOTS; idx++)
+    {
+        if (m_slots[level * TIMER_WHEEL_SLOTS + idx].size())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TimerWheel::getNextExpireTick(
+        _Out_ uint64_t& tick) const
+{
+    SWSS_LOG_ENTER();
+
+    if (m_timers.empty())
+    {
+        return false;
+    }
+
+    tick = UINT64_MAX;
+
+    for (auto& kvp: m_timers)
+    {
+        tick = std::min(tick, kvp.second.expireTick);
+    }
+
+    return true;
+}
+
+uint64_t TimerWheel::getCurrentTick() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_currentTick;
+}
+
+size_t TimerWheel::size() const
+{
+    SWSS_LOG_ENTER();
+
+    return m_timers.size();
+}
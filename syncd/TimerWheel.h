@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace syncd
+{
+    /**
+     * @brief Hierarchical timer wheel.
+     *
+     * Time is expressed in ticks. Each level has 64 slots and slot of level
+     * N covers 64^N ticks. Timers are cascaded to lower level when wheel
+     * reaches their slot, so schedule, cancel and advance by one tick are
+     * O(1). Timers beyond top level range are kept aside and rescheduled
+     * when top level wraps.
+     */
+    class TimerWheel
+    {
+        public:
+
+            TimerWheel(
+                    _In_ uint64_t currentTick = 0);
+
+            virtual ~TimerWheel() = default;
+
+        public:
+
+            /**
+             * @brief Schedule timer to expire at given tick, existing timer
+             * with the same id is rescheduled. Timer in the past expires on
+             * next advance.
+             */
+            void schedule(
+                    _In_ uint64_t id,
+                    _In_ uint64_t expireTick);
+
+            void cancel(
+                    _In_ uint64_t id);
+
+            bool isScheduled(
+                    _In_ uint64_t id) const;
+
+            /**
+             * @brief Advance wheel to given tick and append expired timers ids
+             * to expired vector.
+             */
+            void advance(
+                    _In_ uint64_t tick,
+                    _Inout_ std::vector<uint64_t>& expired);
+
+            /**
+             * @brief Get tick of earliest timer.
+             *
+             * @return False if there are no timers.
+             */
+            bool getNextExpireTick(
+                    _Out_ uint64_t& tick) const;
+
+            uint64_t getCurrentTick() const;
+
+            size_t size() const;
+
+        private:
+
+            void insert(
+                    _In_ uint64_t id,
+                    _In_ uint64_t expireTick);
+
+            void remove(
+                    _In_ uint64_t id);
+
+            void cascade(
+                    _In_ size_t level);
+
+            bool isLevelEmpty(
+                    _In_ size_t level) const;
+
+        private:
+
+            struct Timer
+            {
+                uint64_t expireTick;
+
+                size_t slot;
+            };
+
+            uint64_t m_currentTick;
+
+            std::unordered_map<uint64_t, Timer> m_timers;
+
+            std::vector<std::unordered_set<uint64_t>> m_slots;
+    };
+}
@@ -614,6 +614,52 @@ sai_status_t VendorSai::clearStats(
     return ptr(object_id, number_of_counters, counter_ids);
 }
 
+sai_status_t VendorSai::bulkGetStats(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    if (!object_key || !object_statuses || !counters)
+    {
+        SWSS_LOG_ERROR("NULL pointer function argument");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    // SAI headers don't define bulk stats function yet, so we fall back to
+    // query objects one by one, api mutex is acquired by each call
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        uint64_t *objectCounters = &counters[(size_t)idx * number_of_counters];
+
+        if (mode == SAI_STATS_MODE_READ)
+        {
+            object_statuses[idx] = getStats(object_type, object_key[idx].key.object_id, number_of_counters, counter_ids, objectCounters);
+        }
+        else
+        {
+            object_statuses[idx] = getStatsExt(object_type, object_key[idx].key.object_id, number_of_counters, counter_ids, mode, objectCounters);
+        }
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
+
 // BULK QUAD OID
 
 sai_status_t VendorSai::bulkCreate(
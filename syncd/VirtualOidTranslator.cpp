@@ -19,7 +19,22 @@ VirtualOidTranslator::VirtualOidTranslator(
 {
     SWSS_LOG_ENTER();
 
-    // empty
+    loadMaps();
+}
+
+void VirtualOidTranslator::loadMaps()
+{
+    SWSS_LOG_ENTER();
+
+    auto vid2rid = m_client->getVidToRidMap();
+    auto rid2vid = m_client->getRidToVidMap();
+
+    m_vid2rid.assign(vid2rid);
+    m_rid2vid.assign(rid2vid);
+
+    SWSS_LOG_NOTICE("loaded %zu VID to RID and %zu RID to VID entries",
+            vid2rid.size(),
+            rid2vid.size());
 }
 
 bool VirtualOidTranslator::tryTranslateRidToVid(
@@ -28,8 +43,6 @@ bool VirtualOidTranslator::tryTranslateRidToVid(
 {
     SWSS_LOG_ENTER();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     if (rid == SAI_NULL_OBJECT_ID)
     {
         SWSS_LOG_DEBUG("translated RID null to VID null");
@@ -38,23 +51,15 @@ bool VirtualOidTranslator::tryTranslateRidToVid(
         return true;
     }
 
-    auto it = m_rid2vid.find(vid);
-
-    if (it != m_rid2vid.end())
+    if (m_rid2vid.get(rid, vid))
     {
-        vid = it->second;
         return true;
     }
 
-    vid = m_client->getVidForRid(rid);
-
-    if (vid == SAI_NULL_OBJECT_ID)
-    {
-        SWSS_LOG_DEBUG("translated RID %s to VID null", sai_serialize_object_id(rid).c_str());
-        return false;
-    }
+    SWSS_LOG_DEBUG("translated RID %s to VID null", sai_serialize_object_id(rid).c_str());
 
-    return true;
+    vid = SAI_NULL_OBJECT_ID;
+    return false;
 }
 
 sai_object_id_t VirtualOidTranslator::translateRidToVid(
@@ -64,8 +69,6 @@ sai_object_id_t VirtualOidTranslator::translateRidToVid(
 {
     SWSS_LOG_ENTER();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     /*
      * NOTE: switch_vid here is Virtual ID of switch for which we need
      * create VID for given RID.
@@ -78,25 +81,19 @@ sai_object_id_t VirtualOidTranslator::translateRidToVid(
         return SAI_NULL_OBJECT_ID;
     }
 
-    auto it = m_rid2vid.find(rid);
+    sai_object_id_t vid;
 
-    if (it != m_rid2vid.end())
+    if (m_rid2vid.get(rid, vid))
     {
-        return it->second;
+        return vid;
     }
 
-    std::string strRid = sai_serialize_object_id(rid);
+    std::lock_guard<std::mutex> lock(m_mutex);
 
-    auto vid = m_client->getVidForRid(rid);
+    // other thread could create VID for this RID before we took the lock
 
-    if (vid != SAI_NULL_OBJECT_ID)
+    if (m_rid2vid.get(rid, vid))
     {
-        // object exists
-
-        SWSS_LOG_DEBUG("translated RID %s to VID %s",
-                sai_serialize_object_id(rid).c_str(),
-                sai_serialize_object_id(vid).c_str());
-
         return vid;
     }
 
@@ -141,8 +138,8 @@ sai_object_id_t VirtualOidTranslator::translateRidToVid(
 
     m_client->insertVidAndRid(vid, rid);
 
-    m_rid2vid[rid] = vid;
-    m_vid2rid[vid] = rid;
+    m_vid2rid.set(vid, rid);
+    m_rid2vid.set(rid, vid);
 
     return vid;
 }
@@ -153,18 +150,13 @@ bool VirtualOidTranslator::checkRidExists(
 {
     SWSS_LOG_ENTER();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     if (rid == SAI_NULL_OBJECT_ID)
         return true;
 
-    if (m_rid2vid.find(rid) != m_rid2vid.end())
+    if (m_rid2vid.contains(rid))
         return true;
 
-    auto vid = m_client->getVidForRid(rid);
-
-    if (vid != SAI_NULL_OBJECT_ID)
-        return true;
+    std::lock_guard<std::mutex> lock(m_mutex);
 
     if (checkRemoved && (m_removedRid2vid.find(rid) != m_removedRid2vid.end()))
     {
@@ -273,8 +265,6 @@ sai_object_id_t VirtualOidTranslator::translateVidToRid(
 {
     SWSS_LOG_ENTER();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     if (vid == SAI_NULL_OBJECT_ID)
     {
         SWSS_LOG_DEBUG("translated VID null to RID null");
@@ -282,16 +272,9 @@ sai_object_id_t VirtualOidTranslator::translateVidToRid(
         return SAI_NULL_OBJECT_ID;
     }
 
-    auto it = m_vid2rid.find(vid);
+    sai_object_id_t rid;
 
-    if (it != m_vid2rid.end())
-    {
-        return it->second;
-    }
-
-    auto rid = m_client->getRidForVid(vid);
-
-    if (rid == SAI_NULL_OBJECT_ID)
+    if (!m_vid2rid.get(vid, rid))
     {
             /*
              * If user created object that is object id, then it should not
@@ -312,13 +295,6 @@ sai_object_id_t VirtualOidTranslator::translateVidToRid(
                 sai_serialize_object_id(vid).c_str());
     }
 
-    /*
-     * We got this RID from redis db, so put it also to local db so it will be
-     * faster to retrieve it late on.
-     */
-
-    m_vid2rid[vid] = rid;
-
     SWSS_LOG_DEBUG("translated VID %s to RID %s",
             sai_serialize_object_id(vid).c_str(),
             sai_serialize_object_id(rid).c_str());
@@ -488,8 +464,8 @@ void VirtualOidTranslator::insertRidAndVid(
 
     // to support multiple switches vid/rid map must be per switch
 
-    m_rid2vid[rid] = vid;
-    m_vid2rid[vid] = rid;
+    m_vid2rid.set(vid, rid);
+    m_rid2vid.set(rid, vid);
 
     m_client->insertVidAndRid(vid, rid);
 }
@@ -518,8 +494,27 @@ void VirtualOidTranslator::clearLocalCache()
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    m_rid2vid.clear();
-    m_vid2rid.clear();
+    loadMaps();
 
     m_removedRid2vid.clear();
 }
+
+void VirtualOidTranslator::setVidAndRidMap(
+        _In_ const std::unordered_map<sai_object_id_t, sai_object_id_t>& map)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_client->setVidAndRidMap(map);
+
+    std::unordered_map<sai_object_id_t, sai_object_id_t> rid2vid;
+
+    for (auto& kvp: map)
+    {
+        rid2vid[kvp.second] = kvp.first;
+    }
+
+    m_vid2rid.assign(map);
+    m_rid2vid.assign(rid2vid);
+}
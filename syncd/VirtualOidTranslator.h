@@ -6,6 +6,7 @@ extern "C"{
 
 #include "VirtualObjectIdManager.h"
 #include "RedisClient.h"
+#include "ShardedOidMap.h"
 
 #include "SaiInterface.h"
 
@@ -17,6 +18,16 @@ extern "C"{
 
 namespace syncd
 {
+    /**
+     * @brief Translates VIDs to RIDs and back.
+     *
+     * VID and RID maps are kept entirely in memory and are loaded from redis
+     * on start, so translation never queries redis. Changes are persisted to
+     * redis by RedisClient write-behind thread.
+     *
+     * Lookups don't take translator mutex, so notification thread translating
+     * object ids doesn't wait for main thread creating or removing objects.
+     */
     class VirtualOidTranslator
     {
         public:
@@ -111,8 +122,22 @@ namespace syncd
                     _In_ sai_object_id_t rid,
                     _In_ sai_object_id_t vid);
 
+            /**
+             * @brief Replace VID and RID maps in redis and in memory.
+             */
+            void setVidAndRidMap(
+                    _In_ const std::unordered_map<sai_object_id_t, sai_object_id_t>& map);
+
+            /**
+             * @brief Reload VID and RID maps from redis and forget removed
+             * objects.
+             */
             void clearLocalCache();
 
+        private:
+
+            void loadMaps();
+
         private:
 
             std::shared_ptr<sairedis::VirtualObjectIdManager> m_virtualObjectIdManager;
@@ -121,10 +146,11 @@ namespace syncd
 
             std::mutex m_mutex;
 
-            // those hashes keep mapping from all switches
+            // those maps keep mapping from all switches
+
+            ShardedOidMap m_rid2vid;
+            ShardedOidMap m_vid2rid;
 
-            std::unordered_map<sai_object_id_t, sai_object_id_t> m_rid2vid;
-            std::unordered_map<sai_object_id_t, sai_object_id_t> m_vid2rid;
             std::unordered_map<sai_object_id_t, sai_object_id_t> m_removedRid2vid;
 
             std::shared_ptr<RedisClient> m_client;
@@ -1,7 +1,6 @@
 #include "ZeroMQSelectableChannel.h"
 
 #include "swss/logger.h"
-#include "swss/json.h"
 
 #include <zmq.h>
 #include <unistd.h>
@@ -11,15 +10,20 @@
 #define ZMQ_POLL_TIMEOUT (2*60*1000)
 
 using namespace syncd;
+using namespace sairedis;
 
 ZeroMQSelectableChannel::ZeroMQSelectableChannel(
-        _In_ const std::string& endpoint):
+        _In_ const std::string& endpoint,
+        _In_ ZeroMQMessageCodec::Codec codec,
+        _In_ bool pipeline):
     m_endpoint(endpoint),
     m_context(nullptr),
     m_socket(nullptr),
     m_fd(0),
     m_allowZmqPoll(false),
-    m_runThread(true)
+    m_runThread(true),
+    m_codec(codec),
+    m_pipeline(pipeline)
 {
     SWSS_LOG_ENTER();
 
@@ -27,7 +31,9 @@ ZeroMQSelectableChannel::ZeroMQSelectableChannel(
 
     m_context = zmq_ctx_new();;
 
-    m_socket = zmq_socket(m_context, ZMQ_REP);
+    m_socket = zmq_socket(m_context, pipeline ? ZMQ_ROUTER : ZMQ_REP);
+
+    SWSS_LOG_NOTICE("binding zmq endpoint: %s (%s)", endpoint.c_str(), pipeline ? "ROUTER" : "REP");
 
     int rc = zmq_bind(m_socket, endpoint.c_str());
 
@@ -159,21 +165,9 @@ void ZeroMQSelectableChannel::pop(
         SWSS_LOG_THROW("queue is empty, can't pop");
     }
 
-    std::string msg = m_queue.front();
-    m_queue.pop();
-
-    auto& values = kfvFieldsValues(kco);
-
-    values.clear();
+    kco = std::move(m_queue.front());
 
-    swss::JSon::readJson(msg, values);
-
-    swss::FieldValueTuple fvt = values.at(0);
-
-    kfvKey(kco) = fvField(fvt);
-    kfvOp(kco) = fvValue(fvt);
-
-    values.erase(values.begin());
+    m_queue.pop();
 }
 
 void ZeroMQSelectableChannel::set(
@@ -183,21 +177,44 @@ void ZeroMQSelectableChannel::set(
 {
     SWSS_LOG_ENTER();
 
-    std::vector<swss::FieldValueTuple> copy = values;
+    if (!m_pipeline)
+    {
+        ZeroMQMessageCodec::encode(m_codec, key, op, values, m_sendBuffer);
+    }
+    else
+    {
+        if (m_pendingRequests.empty())
+        {
+            SWSS_LOG_THROW("no pending request on %s, can't route response", m_endpoint.c_str());
+        }
 
-    swss::FieldValueTuple opdata(key, op);
+        // responses are sent in the same order as requests were received
 
-    copy.insert(copy.begin(), opdata);
+        auto& request = m_pendingRequests.front();
 
-    std::string msg = swss::JSon::buildJson(copy);
+        ZeroMQMessageCodec::encode(request.m_codec, key, op, values, m_sendBuffer);
 
-    SWSS_LOG_DEBUG("sending: %s", msg.c_str());
+        for (auto& frame: request.m_envelope)
+        {
+            if (zmq_send(m_socket, frame.data(), frame.size(), ZMQ_SNDMORE) < 0)
+            {
+                SWSS_LOG_THROW("zmq_send envelope failed, on endpoint %s, zmqerrno: %d",
+                        m_endpoint.c_str(),
+                        zmq_errno());
+            }
+        }
+
+        m_pendingRequests.pop_front();
+    }
+
+    SWSS_LOG_DEBUG("sending: %s %s, %zu bytes", op.c_str(), key.c_str(), m_sendBuffer.size());
 
-    int rc = zmq_send(m_socket, msg.c_str(), msg.length(), 0);
+    int rc = zmq_send(m_socket, m_sendBuffer.data(), m_sendBuffer.size(), 0);
 
     // at this point we already did send/receive pattern, so we can notify
-    // thread that we can poll again
-    m_allowZmqPoll = true;
+    // thread that we can poll again, in pipeline mode only when all received
+    // requests were responded, since socket is used by this thread until then
+    m_allowZmqPoll = !m_pipeline || m_pendingRequests.empty();
 
     if (rc <= 0)
     {
@@ -223,6 +240,16 @@ uint64_t ZeroMQSelectableChannel::readData()
     // clear selectable event so it could be triggered in next select()
     m_selectableEvent.readData();
 
+    if (m_pipeline)
+    {
+        // receive all requests that already arrived, client could send
+        // multiple requests before waiting for responses
+
+        while (receiveRouterMessage());
+
+        return 0;
+    }
+
     int rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, 0);
 
     if (rc < 0)
@@ -237,13 +264,80 @@ uint64_t ZeroMQSelectableChannel::readData()
                 rc);
     }
 
-    m_buffer.at(rc) = 0; // make sure that we end string with zero before parse
+    // decode directly from receive buffer, and respond with the same codec
+
+    swss::KeyOpFieldsValuesTuple kco;
+
+    m_codec = ZeroMQMessageCodec::decode(m_buffer.data(), rc, kco);
 
-    m_queue.push((char*)m_buffer.data());
+    m_queue.push(std::move(kco));
 
     return 0;
 }
 
+bool ZeroMQSelectableChannel::receiveRouterMessage()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> envelope;
+
+    int flags = ZMQ_DONTWAIT;
+
+    while (true)
+    {
+        int rc = zmq_recv(m_socket, m_buffer.data(), ZMQ_RESPONSE_BUFFER_SIZE, flags);
+
+        if (rc < 0)
+        {
+            if (zmq_errno() == EAGAIN && envelope.empty())
+            {
+                return false;
+            }
+
+            SWSS_LOG_THROW("zmq_recv failed, zmqerrno: %d", zmq_errno());
+        }
+
+        if (rc >= ZMQ_RESPONSE_BUFFER_SIZE)
+        {
+            SWSS_LOG_THROW("zmq_recv message was truncated (over %d bytes, received %d), increase buffer size, message DROPPED",
+                    ZMQ_RESPONSE_BUFFER_SIZE,
+                    rc);
+        }
+
+        int more = 0;
+        size_t moreLen = sizeof(more);
+
+        if (zmq_getsockopt(m_socket, ZMQ_RCVMORE, &more, &moreLen) != 0)
+        {
+            SWSS_LOG_THROW("zmq_getsockopt failed on endpoint: %s, zmqerrno: %d",
+                    m_endpoint.c_str(),
+                    zmq_errno());
+        }
+
+        if (!more)
+        {
+            // last frame is the actual request payload
+
+            swss::KeyOpFieldsValuesTuple kco;
+
+            auto codec = ZeroMQMessageCodec::decode(m_buffer.data(), rc, kco);
+
+            m_queue.push(std::move(kco));
+
+            m_pendingRequests.push_back({ std::move(envelope), codec });
+
+            return true;
+        }
+
+        // identity, request id and empty delimiter, rest of multipart
+        // message is already available, so no need for DONTWAIT
+
+        envelope.emplace_back((const char*)m_buffer.data(), rc);
+
+        flags = 0;
+    }
+}
+
 bool ZeroMQSelectableChannel::hasData()
 {
     SWSS_LOG_ENTER();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SelectableChannel.h"
+#include "ZeroMQMessageCodec.h"
 
 #include "swss/table.h"
 #include "swss/selectableevent.h"
@@ -17,7 +18,9 @@ namespace syncd
         public:
 
             ZeroMQSelectableChannel(
-                    _In_ const std::string& endpoint);
+                    _In_ const std::string& endpoint,
+                    _In_ sairedis::ZeroMQMessageCodec::Codec codec = sairedis::ZeroMQMessageCodec::CODEC_JSON,
+                    _In_ bool pipeline = false);
 
             virtual ~ZeroMQSelectableChannel();
 
@@ -54,6 +57,16 @@ namespace syncd
 
             void zmqPollThread();
 
+            /**
+             * @brief Receive single request from ROUTER socket.
+             *
+             * Envelope (client identity, request id and empty delimiter) is
+             * saved, so response can be routed back to the client.
+             *
+             * @return False if there are no more requests to receive.
+             */
+            bool receiveRouterMessage();
+
         private:
 
             std::string m_endpoint;
@@ -64,7 +77,7 @@ namespace syncd
 
             int m_fd;
 
-            std::queue<std::string> m_queue;
+            std::queue<swss::KeyOpFieldsValuesTuple> m_queue;
 
             std::vector<uint8_t> m_buffer;
 
@@ -75,5 +88,41 @@ namespace syncd
             std::shared_ptr<std::thread> m_zmlPollThread;
 
             swss::SelectableEvent m_selectableEvent;
+
+            /**
+             * @brief Codec used for responses when pipeline is disabled.
+             *
+             * Initially set from context config, and then updated to the
+             * codec of each received request, so response is always encoded
+             * the same way as request that it answers. In pipeline mode codec
+             * is kept with each pending request instead.
+             */
+            sairedis::ZeroMQMessageCodec::Codec m_codec;
+
+            std::string m_sendBuffer;
+
+            /**
+             * @brief Use ROUTER socket instead of REP.
+             *
+             * Multiple requests can be received at once, and they are
+             * processed and responded in order.
+             */
+            bool m_pipeline;
+
+            typedef struct _PendingRequest
+            {
+                std::vector<std::string> m_envelope;
+
+                sairedis::ZeroMQMessageCodec::Codec m_codec;
+
+            } PendingRequest;
+
+            /**
+             * @brief Envelopes and codecs of requests waiting for response.
+             *
+             * Requests from different clients can be encoded with different
+             * codecs, so each response uses codec of request it answers.
+             */
+            std::deque<PendingRequest> m_pendingRequests;
     };
 }
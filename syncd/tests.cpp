@@ -4,6 +4,8 @@
 #include <sys/time.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 
 extern "C" {
 #include <sai.h>
@@ -15,6 +17,11 @@ extern "C" {
 #include "sairedis.h"
 #include "sairediscommon.h"
 #include "TimerWatchdog.h"
+#include "NotificationQueue.h"
+#include "FdbEventCoalescer.h"
+#include "TimerWheel.h"
+#include "PortRatesCounterPlugin.h"
+#include "ShardedOidMap.h"
 
 #include "meta/sai_serialize.h"
 #include "meta/OidRefCounter.h"
@@ -32,7 +39,9 @@ extern "C" {
 #include <unordered_map>
 #include <vector>
 #include <thread>
+#include <atomic>
 #include <tuple>
+#include <algorithm>
 
 using namespace syncd;
 
@@ -795,6 +804,522 @@ void test_watchdog_timer_clock_rollback()
     twd.setEndTime();
 }
 
+void test_notification_queue()
+{
+    SWSS_LOG_ENTER();
+
+    const int producers = 4;
+    const int count = 100000;
+
+    NotificationQueue queue(1000);
+
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue, p] () {
+
+            for (int i = 0; i < count; i++)
+            {
+                swss::KeyOpFieldsValuesTuple item(
+                        SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE,
+                        std::to_string(p) + ":" + std::to_string(i),
+                        {});
+
+                while (!queue.enqueue(item))
+                {
+                    std::this_thread::yield(); // ring is full
+                }
+            }
+        });
+    }
+
+    // items from each producer must arrive in order
+
+    std::vector<int> last(producers, -1);
+
+    std::vector<swss::KeyOpFieldsValuesTuple> items;
+
+    size_t received = 0;
+
+    while (received < (size_t)(producers * count))
+    {
+        queue.tryDequeueBatch(items, 128);
+
+        for (auto& item: items)
+        {
+            auto& data = kfvOp(item);
+
+            int p = std::stoi(data);
+            int i = std::stoi(data.substr(data.find(':') + 1));
+
+            if (i != last[p] + 1)
+            {
+                SWSS_LOG_THROW("producer %d: expected %d, got %d", p, last[p] + 1, i);
+            }
+
+            last[p] = i;
+        }
+
+        received += items.size();
+    }
+
+    for (auto& t: threads)
+    {
+        t.join();
+    }
+
+    if (queue.getQueueSize() != 0 || queue.getDequeueCount() != (uint64_t)(producers * count))
+    {
+        SWSS_LOG_THROW("queue should be empty");
+    }
+
+    // fdb events are dropped after limit, other notifications are not
+
+    NotificationQueue fdbQueue(10);
+
+    swss::KeyOpFieldsValuesTuple fdb(SAI_SWITCH_NOTIFICATION_NAME_FDB_EVENT, "", {});
+
+    for (int i = 0; i < 20; i++)
+    {
+        fdbQueue.enqueue(fdb);
+    }
+
+    if (fdbQueue.getQueueSize() != 10 || fdbQueue.getDropCount() != 10)
+    {
+        SWSS_LOG_THROW("expected 10 fdb events to be dropped");
+    }
+
+    swss::KeyOpFieldsValuesTuple port(SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE, "", {});
+
+    if (!fdbQueue.enqueue(port))
+    {
+        SWSS_LOG_THROW("port state change should not be dropped");
+    }
+
+    if (fdbQueue.getLane(NOTIFICATION_CLASS_FDB)->getDropCount() != 10 ||
+            fdbQueue.getLane(NOTIFICATION_CLASS_PORT_STATE)->getDropCount() != 0)
+    {
+        SWSS_LOG_THROW("drops should be counted per lane");
+    }
+
+    // port state change bypasses fdb backlog
+
+    fdbQueue.tryDequeueBatch(items, 2);
+
+    if (items.size() != 2 ||
+            kfvKey(items[0]) != SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE ||
+            kfvKey(items[1]) != SAI_SWITCH_NOTIFICATION_NAME_FDB_EVENT)
+    {
+        SWSS_LOG_THROW("port state change should be dequeued before fdb events");
+    }
+
+    // weighted policy takes 1 fdb event per each port state change
+
+    fdbQueue.enqueue(port);
+    fdbQueue.enqueue(port);
+
+    fdbQueue.setDequeuePolicy(NOTIFICATION_DEQUEUE_POLICY_WEIGHTED, { 1, 1, 1, 1, 1 });
+
+    fdbQueue.tryDequeueBatch(items, 3);
+
+    if (items.size() != 3 ||
+            kfvKey(items[0]) != SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE ||
+            kfvKey(items[1]) != SAI_SWITCH_NOTIFICATION_NAME_FDB_EVENT ||
+            kfvKey(items[2]) != SAI_SWITCH_NOTIFICATION_NAME_PORT_STATE_CHANGE)
+    {
+        SWSS_LOG_THROW("unexpected weighted dequeue order");
+    }
+}
+
+void test_fdb_event_coalescer()
+{
+    SWSS_LOG_ENTER();
+
+    FdbEventCoalescer coalescer;
+
+    coalescer.setWindow(100);
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+    attr.value.oid = 0x3a000000000001;
+
+    sai_fdb_event_notification_data_t data;
+
+    memset(&data, 0, sizeof(data));
+
+    data.event_type = SAI_FDB_EVENT_LEARNED;
+    data.fdb_entry.switch_id = 0x21000000000000;
+    data.fdb_entry.bv_id = 0x26000000000001;
+    data.fdb_entry.mac_address[5] = 1;
+    data.attr_count = 1;
+    data.attr = &attr;
+
+    // learn and 2 moves of the same entry
+
+    coalescer.add(data);
+
+    data.event_type = SAI_FDB_EVENT_MOVE;
+    attr.value.oid = 0x3a000000000002;
+
+    coalescer.add(data);
+
+    attr.value.oid = 0x3a000000000003;
+
+    coalescer.add(data);
+
+    // age of other entry
+
+    data.event_type = SAI_FDB_EVENT_AGED;
+    data.fdb_entry.mac_address[5] = 2;
+
+    coalescer.add(data);
+
+    if (coalescer.getSuppressedCount() != 2)
+    {
+        SWSS_LOG_THROW("expected 2 suppressed events, got %" PRIu64, coalescer.getSuppressedCount());
+    }
+
+    auto events = coalescer.take();
+
+    if (events.size() != 2 || !coalescer.empty())
+    {
+        SWSS_LOG_THROW("expected 2 coalesced events, got %zu", events.size());
+    }
+
+    if (events[0].data.event_type != SAI_FDB_EVENT_LEARNED ||
+            events[0].data.attr_count != 1 ||
+            events[0].data.attr[0].value.oid != 0x3a000000000003)
+    {
+        SWSS_LOG_THROW("learned and moved entry should be learned on final port");
+    }
+
+    if (events[1].data.event_type != SAI_FDB_EVENT_AGED)
+    {
+        SWSS_LOG_THROW("expected aged event");
+    }
+
+    // learn and age in the same window cancel each other
+
+    data.event_type = SAI_FDB_EVENT_LEARNED;
+
+    coalescer.add(data);
+
+    data.event_type = SAI_FDB_EVENT_AGED;
+
+    coalescer.add(data);
+
+    events = coalescer.take();
+
+    if (events.size() != 0 || !coalescer.empty())
+    {
+        SWSS_LOG_THROW("learned and aged entry should not be reported, got %zu events", events.size());
+    }
+}
+
+void test_timer_wheel()
+{
+    SWSS_LOG_ENTER();
+
+    TimerWheel wheel;
+
+    // timers on each level boundary and in overflow
+
+    std::map<uint64_t, uint64_t> timers = {
+        { 1, 1 }, { 2, 5 }, { 3, 63 }, { 4, 64 }, { 5, 65 }, { 6, 4095 },
+        { 7, 4096 }, { 8, 5000 }, { 9, 262143 }, { 10, 262144 },
+        { 11, 16777215 }, { 12, 16777216 }, { 13, 20000000 } };
+
+    for (auto& kvp: timers)
+    {
+        wheel.schedule(kvp.first, kvp.second);
+    }
+
+    wheel.schedule(100, 10);
+    wheel.cancel(100);
+
+    wheel.schedule(2, 70); // reschedule
+    timers[2] = 70;
+
+    std::vector<std::pair<uint64_t, uint64_t>> expected;
+
+    for (auto& kvp: timers)
+    {
+        expected.emplace_back(kvp.second, kvp.first);
+    }
+
+    std::sort(expected.begin(), expected.end());
+
+    for (auto& e: expected)
+    {
+        std::vector<uint64_t> expired;
+
+        uint64_t next = 0;
+
+        if (!wheel.getNextExpireTick(next) || next != e.first)
+        {
+            SWSS_LOG_THROW("expected next expire tick %" PRIu64 ", got %" PRIu64, e.first, next);
+        }
+
+        wheel.advance(e.first - 1, expired);
+
+        if (expired.size())
+        {
+            SWSS_LOG_THROW("timer %" PRIu64 " expired before tick %" PRIu64, expired[0], e.first);
+        }
+
+        wheel.advance(e.first, expired);
+
+        if (expired.size() != 1 || expired[0] != e.second)
+        {
+            SWSS_LOG_THROW("timer %" PRIu64 " didn't expire at tick %" PRIu64, e.second, e.first);
+        }
+    }
+
+    if (wheel.size() != 0)
+    {
+        SWSS_LOG_THROW("expected empty wheel");
+    }
+
+    // timer in the past expires on next advance
+
+    wheel.schedule(1, 5);
+
+    std::vector<uint64_t> expired;
+
+    wheel.advance(wheel.getCurrentTick() + 1, expired);
+
+    if (expired.size() != 1)
+    {
+        SWSS_LOG_THROW("expected past timer to expire");
+    }
+}
+
+void test_port_rates_counter_plugin()
+{
+    SWSS_LOG_ENTER();
+
+    PortRatesCounterPlugin plugin(0.5);
+
+    std::string key = "oid:0x1000000000001";
+
+    std::string stateKey = key + ":PORT";
+
+    std::vector<swss::FieldValueTuple> counters = {
+        { "SAI_PORT_STAT_IF_IN_OCTETS", "" },
+        { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "" },
+        { "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS", "" },
+        { "SAI_PORT_STAT_IF_OUT_OCTETS", "" },
+        { "SAI_PORT_STAT_IF_OUT_UCAST_PKTS", "" } };
+
+    std::vector<uint64_t> stats = { 1000, 10, 0, 2000, 20 };
+
+    std::vector<CounterPlugin::Object> objects = { { 0x1000000000001, &key, &counters, &stats, true } };
+
+    std::vector<swss::KeyOpFieldsValuesTuple> results;
+
+    auto now = std::chrono::steady_clock::now();
+
+    // last value of field in entries written to given key
+
+    auto getField = [&](const std::string& entryKey, const std::string& field) {
+        std::string value;
+        for (auto& entry: results)
+        {
+            if (kfvKey(entry) != entryKey)
+                continue;
+
+            for (auto& fv: kfvFieldsValues(entry))
+            {
+                if (fvField(fv) == field)
+                    value = fvValue(fv);
+            }
+        }
+        if (value.empty())
+            SWSS_LOG_THROW("field %s not found in %s", field.c_str(), entryKey.c_str());
+        return value;
+    };
+
+    // first poll only remembers counters
+
+    plugin.process(objects, now, results);
+
+    if (results.size() != 2 ||
+            getField(stateKey, "INIT_DONE") != "COUNTERS_LAST" ||
+            getField(key, "SAI_PORT_STAT_IF_IN_OCTETS_last") != "1000" ||
+            getField(key, "SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last") != "20")
+    {
+        SWSS_LOG_THROW("expected COUNTERS_LAST and last counters on first poll");
+    }
+
+    // second poll gives unsmoothed rates
+
+    stats = { 3000, 30, 10, 2000, 40 };
+
+    results.clear();
+
+    plugin.process(objects, now + std::chrono::seconds(2), results);
+
+    if (results.size() != 2 ||
+            getField(stateKey, "INIT_DONE") != "DONE" ||
+            getField(key, "SAI_PORT_STAT_IF_IN_OCTETS_last") != "3000" ||
+            std::stod(getField(key, "RX_BPS")) != 1000 ||
+            std::stod(getField(key, "RX_PPS")) != 15 ||
+            std::stod(getField(key, "TX_BPS")) != 0 ||
+            std::stod(getField(key, "TX_PPS")) != 10)
+    {
+        SWSS_LOG_THROW("wrong initial rates");
+    }
+
+    // poll failed, stale stats are skipped
+
+    objects[0].valid = false;
+
+    results.clear();
+
+    plugin.process(objects, now + std::chrono::seconds(3), results);
+
+    if (results.size() != 0)
+    {
+        SWSS_LOG_THROW("port with failed poll should be skipped");
+    }
+
+    // next rates are smoothed over time since last successful poll, cleared
+    // counter counts as no traffic, INIT_DONE is not written again
+
+    objects[0].valid = true;
+
+    stats = { 7000, 70, 10, 0, 40 };
+
+    plugin.process(objects, now + std::chrono::seconds(4), results);
+
+    if (results.size() != 1 ||
+            std::stod(getField(key, "RX_BPS")) != 1500 ||
+            std::stod(getField(key, "RX_PPS")) != 17.5 ||
+            std::stod(getField(key, "TX_BPS")) != 0 ||
+            std::stod(getField(key, "TX_PPS")) != 5)
+    {
+        SWSS_LOG_THROW("wrong smoothed rates");
+    }
+
+    // port which is not registered anymore is forgotten
+
+    objects.clear();
+
+    plugin.process(objects, now + std::chrono::seconds(5), results);
+
+    objects = { { 0x1000000000001, &key, &counters, &stats, true } };
+
+    results.clear();
+
+    plugin.process(objects, now + std::chrono::seconds(6), results);
+
+    if (results.size() != 2 || getField(stateKey, "INIT_DONE") != "COUNTERS_LAST")
+    {
+        SWSS_LOG_THROW("expected COUNTERS_LAST after port was removed");
+    }
+
+    if (CounterPlugin::create("port_rates") == nullptr || CounterPlugin::create("unknown") != nullptr)
+    {
+        SWSS_LOG_THROW("native counter plugin factory failed");
+    }
+}
+
+void test_sharded_oid_map()
+{
+    SWSS_LOG_ENTER();
+
+    ShardedOidMap map;
+
+    sai_object_id_t value;
+
+    if (map.get(0x1000000000001, value) || map.size() != 0)
+    {
+        SWSS_LOG_THROW("map should be empty");
+    }
+
+    map.set(0x1000000000001, 0x2000000000001);
+
+    if (!map.get(0x1000000000001, value) || value != 0x2000000000001 || !map.contains(0x1000000000001))
+    {
+        SWSS_LOG_THROW("inserted key not found");
+    }
+
+    map.erase(0x1000000000001);
+
+    if (map.contains(0x1000000000001))
+    {
+        SWSS_LOG_THROW("erased key found");
+    }
+
+    std::unordered_map<sai_object_id_t, sai_object_id_t> content;
+
+    for (sai_object_id_t idx = 1; idx <= 1000; idx++)
+    {
+        content[0x1000000000000 + idx] = 0x2000000000000 + idx;
+    }
+
+    map.assign(content);
+
+    if (map.size() != content.size())
+    {
+        SWSS_LOG_THROW("wrong size after assign: %zu", map.size());
+    }
+
+    // readers and writer touching different keys at the same time
+
+    std::vector<std::thread> threads;
+
+    std::atomic<int> errors(0);
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&map, &content, &errors]() {
+
+            for (int i = 0; i < 100; i++)
+            {
+                for (auto& kvp: content)
+                {
+                    sai_object_id_t v;
+
+                    if (!map.get(kvp.first, v) || v != kvp.second)
+                    {
+                        errors++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (sai_object_id_t idx = 1; idx <= 10000; idx++)
+    {
+        map.set(0x3000000000000 + idx, idx);
+    }
+
+    for (auto& t: threads)
+    {
+        t.join();
+    }
+
+    if (errors)
+    {
+        SWSS_LOG_THROW("%d wrong values read during concurrent inserts", errors.load());
+    }
+
+    if (map.size() != content.size() + 10000)
+    {
+        SWSS_LOG_THROW("wrong size after concurrent inserts: %zu", map.size());
+    }
+
+    map.clear();
+
+    if (map.size() != 0)
+    {
+        SWSS_LOG_THROW("map should be empty after clear");
+    }
+}
+
 int main()
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -817,6 +1342,16 @@ int main()
 
         test_bulk_route_set();
 
+        test_notification_queue();
+
+        test_fdb_event_coalescer();
+
+        test_timer_wheel();
+
+        test_port_rates_counter_plugin();
+
+        test_sharded_oid_map();
+
         sai_api_uninitialize();
 
         printf("\n[ %s ]\n\n", sai_serialize_status(SAI_STATUS_SUCCESS).c_str());
@@ -150,3 +150,33 @@ typedef enum _sai_vs_switch_attr_t
     SAI_VS_SWITCH_ATTR_META_ALLOW_READ_ONLY_ONCE,
 
 } sau_vs_switch_attr_t;
+
+/**
+ * @brief Bulk objects get statistics.
+ *
+ * Counters of object at index i start at counters[i * number_of_counters].
+ *
+ * @param[in] switch_id SAI Switch object id
+ * @param[in] object_type Object type
+ * @param[in] object_count Number of objects to get the stats
+ * @param[in] object_key List of object keys
+ * @param[in] number_of_counters Number of counters in the array
+ * @param[in] counter_ids Specifies the array of counter ids
+ * @param[in] mode Statistics mode
+ * @param[inout] object_statuses Array of status for each object
+ * @param[out] counters Array of resulting counter values
+ *
+ * @return #SAI_STATUS_SUCCESS on success when all objects succeeded,
+ * #SAI_STATUS_FAILURE when any of the objects fails, or failure status code
+ * when request could not be executed.
+ */
+extern "C" sai_status_t sai_vs_bulk_object_get_stats(
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters);
@@ -975,6 +975,54 @@ sai_status_t VirtualSwitchSaiInterface::clearStats(
             counters);
 }
 
+sai_status_t VirtualSwitchSaiInterface::bulkGetStats(
+        _In_ sai_object_id_t switchId,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_switchStateMap.find(switchId);
+
+    if (it == m_switchStateMap.end())
+    {
+        SWSS_LOG_ERROR("failed to find switch %s in switch state map", sai_serialize_object_id(switchId).c_str());
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    auto ss = it->second;
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t idx = 0; idx < object_count; idx++)
+    {
+        object_statuses[idx] = ss->getStatsExt(
+                object_type,
+                object_key[idx].key.object_id,
+                number_of_counters,
+                counter_ids,
+                mode,
+                &counters[(size_t)idx * number_of_counters]);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed to get stats for %s",
+                    sai_serialize_object_id(object_key[idx].key.object_id).c_str());
+
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
+
 sai_status_t VirtualSwitchSaiInterface::bulkRemove(
         _In_ sai_object_id_t switchId,
         _In_ sai_object_type_t object_type,
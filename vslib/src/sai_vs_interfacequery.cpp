@@ -1,4 +1,5 @@
 #include "sai_vs.h"
+#include "saivs.h"
 
 using namespace saivs;
 
@@ -166,3 +167,28 @@ sai_object_id_t sai_switch_id_query(
 
     return vs_sai->switchIdQuery(objectId);
 }
+
+sai_status_t sai_vs_bulk_object_get_stats(
+        _In_ sai_object_id_t switch_id,
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_key_t *object_key,
+        _In_ uint32_t number_of_counters,
+        _In_ const sai_stat_id_t *counter_ids,
+        _In_ sai_stats_mode_t mode,
+        _Inout_ sai_status_t *object_statuses,
+        _Out_ uint64_t *counters)
+{
+    SWSS_LOG_ENTER();
+
+    return vs_sai->bulkGetStats(
+            switch_id,
+            object_type,
+            object_count,
+            object_key,
+            number_of_counters,
+            counter_ids,
+            mode,
+            object_statuses,
+            counters);
+}
@@ -777,6 +777,35 @@ void test_get_stats()
 
     ASSERT_TRUE(values[0] == 127);
     ASSERT_TRUE(values[1] == 77);
+
+    // bulk get stats returns counters object after object
+
+    sai_object_key_t keys[2];
+
+    keys[0].key.object_id = ports[0];
+    keys[1].key.object_id = ports[1];
+
+    sai_status_t statuses[2];
+
+    uint64_t bulkValues[4] = { 42, 42, 42, 42 };
+
+    SUCCESS(sai_vs_bulk_object_get_stats(switch_id, SAI_OBJECT_TYPE_PORT, 2, keys, 2, (const sai_stat_id_t *)ids, SAI_STATS_MODE_READ, statuses, bulkValues));
+
+    ASSERT_TRUE(statuses[0] == SAI_STATUS_SUCCESS);
+    ASSERT_TRUE(statuses[1] == SAI_STATUS_SUCCESS);
+
+    ASSERT_TRUE(bulkValues[0] == 127);
+    ASSERT_TRUE(bulkValues[1] == 77);
+    ASSERT_TRUE(bulkValues[2] == 0);
+    ASSERT_TRUE(bulkValues[3] == 0);
+
+    // object of different type fails whole request
+
+    keys[1].key.object_id = switch_id;
+
+    ASSERT_TRUE(sai_vs_bulk_object_get_stats(switch_id, SAI_OBJECT_TYPE_PORT, 2, keys, 2, (const sai_stat_id_t *)ids, SAI_STATS_MODE_READ, statuses, bulkValues) == SAI_STATUS_INVALID_PARAMETER);
+
+    ASSERT_TRUE(statuses[0] == SAI_STATUS_NOT_EXECUTED);
 }
 
 void test_supported_obj_types()